@@ -0,0 +1,141 @@
+// Continuous ADC14 acquisition using a timer trigger and DMA ping-pong buffers
+//
+// TIMER_A0 (SMCLK) CCR1 output  -> ADC14 SHS_1 trigger, repeat single channel
+// ADC14 MEM[0] conversion done  -> DMA channel 7 (source 7 = ADC14)
+// DMA primary / alternate       -> adc_buffer[0] / adc_buffer[1]
+// DMA channel 7 done            -> DMA_INT1 ISR re-arms the finished buffer
+
+#include "msp.h"
+#include "adc_dma.h"
+#include "dma.h"
+
+#define ADC_TIMER_CLK   3000000         // SMCLK = DCO 48 MHz / 16 (BOOT_clock)
+#define ADC_DMA_CH      7               // DMA channel used for ADC14
+#define ADC_DMA_SRC     7               // channel 7 source 7 = ADC14 (datasheet DMA sources)
+
+#define ADC_DMA_CONTROL (DMA_DST_INC_16 | DMA_DST_SIZE_16 | DMA_SRC_INC_0 | \
+                         DMA_SRC_SIZE_16 | DMA_N_MINUS_1(ADC_DMA_BUFFER_SIZE) | \
+                         DMA_PINGPONG)
+
+#define ADC_PRIMARY     DMA_primary(ADC_DMA_CH)
+#define ADC_ALTERNATE   DMA_alternate(ADC_DMA_CH)
+
+#pragma DATA_ALIGN(adc_buffer, 4)           // word access by adc_stats.c
+#pragma NOINIT(adc_buffer)                  // DMA fills it, no zero fill at boot
+static uint16_t adc_buffer[2][ADC_DMA_BUFFER_SIZE];
+static ADC_DMA_callback buffer_callback = 0;
+static volatile uint8_t active_buffer = 0;      // buffer the DMA is filling
+static volatile uint32_t buffer_count = 0;      // full buffers delivered
+static volatile uint32_t dropped_count = 0;     // full buffers lost
+
+static void buffer_done(void);
+
+// Function to set a descriptor up to fill one of the ping-pong buffers
+static void buffer_arm(DMA_descriptor* descriptor, uint16_t* buffer)
+{
+    DMA_set(descriptor, &ADC14->MEM[0], &buffer[ADC_DMA_BUFFER_SIZE - 1], ADC_DMA_CONTROL);
+}
+
+// Function to configure the timer, ADC14 and DMA. sample_rate is in Hz.
+// callback is called from the DMA ISR with every full buffer.
+void ADC_DMA_init(uint32_t sample_rate, ADC_DMA_callback callback)
+{
+    uint32_t period = ADC_TIMER_CLK / sample_rate;
+
+    buffer_callback = callback;
+
+    P5->SEL1 |= BIT4;                   // Configure P5.4 for ADC
+    P5->SEL0 |= BIT4;
+
+    // TIMER_A0 up mode, TA0.1 output rises once every period to trigger ADC
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_CLR;  // stopped
+    TIMER_A0->CCR[0] = period - 1;
+    TIMER_A0->CCR[1] = period / 2;
+    TIMER_A0->CCTL[1] = TIMER_A_CCTLN_OUTMOD_3;         // set/reset
+
+    // Sampling time, S&H=4, trigger from TA0.1, repeat single channel
+    ADC14->CTL0 &= ~ADC14_CTL0_ENC;
+    ADC14->CTL0 = ADC14_CTL0_SHT0__4
+                | ADC14_CTL0_SHP
+                | ADC14_CTL0_SHS_1
+                | ADC14_CTL0_SSEL__SMCLK
+                | ADC14_CTL0_CONSEQ_2
+                | ADC14_CTL0_ON;
+    ADC14->CTL1 = ADC14_CTL1_RES_3;         // 14-bit conversion results
+    ADC14->MCTL[0] = ADC14_MCTLN_INCH_1;    // A1 ADC input select; Vref=AVCC
+    ADC14->IER0 = 0;                        // results are moved by DMA
+
+    // DMA channel 7 from ADC14, ping-pong between the two buffers
+    DMA_init();
+    DMA_channel(ADC_DMA_CH, ADC_DMA_SRC);
+
+    // DMA_INT1 is dedicated to channel 7 completion
+    DMA_int1(ADC_DMA_CH, buffer_done);
+}
+
+// Function to start continuous acquisition into buffer 0
+void ADC_DMA_start(void)
+{
+    buffer_arm(ADC_PRIMARY, adc_buffer[0]);
+    buffer_arm(ADC_ALTERNATE, adc_buffer[1]);
+    active_buffer = 0;
+
+    DMA_Control->ALTCLR = 1 << ADC_DMA_CH;      // start with primary
+    DMA_Control->ENASET = 1 << ADC_DMA_CH;
+
+    ADC14->CTL0 |= ADC14_CTL0_ENC;              // wait for timer triggers
+    TIMER_A0->CTL |= TIMER_A_CTL_MC__UP;        // start sample clock
+}
+
+// Function to stop acquisition, a partly filled buffer is discarded
+void ADC_DMA_stop(void)
+{
+    TIMER_A0->CTL &= ~TIMER_A_CTL_MC_MASK;      // stop sample clock
+    ADC14->CTL0 &= ~ADC14_CTL0_ENC;
+    DMA_Control->ENACLR = 1 << ADC_DMA_CH;
+}
+
+// Number of full buffers passed to the callback
+uint32_t ADC_DMA_buffer_count(void)
+{
+    return buffer_count;
+}
+
+// Number of full buffers lost because the ISR did not re-arm in time
+uint32_t ADC_DMA_dropped(void)
+{
+    return dropped_count;
+}
+
+// DMA channel 7 done, from the DMA_INT1 ISR in dma.c. One buffer has been
+// filled and the DMA has moved on to the other one. Re-arm the finished
+// buffer so it is ready for the next swap.
+static void buffer_done(void)
+{
+    uint8_t done = active_buffer;
+
+    DMA_Channel->INT0_CLRFLG = 1 << ADC_DMA_CH;     // clear channel flag
+
+    if (!(DMA_Control->ENASET & (1 << ADC_DMA_CH))) {
+        // both buffers filled before this ISR ran and the DMA stopped on the
+        // spent descriptor. Drop the older buffer, refill it and hand over
+        // the newer one.
+        dropped_count++;
+        buffer_arm(ADC_PRIMARY, adc_buffer[0]);
+        buffer_arm(ADC_ALTERNATE, adc_buffer[1]);
+        if (done)
+            DMA_Control->ALTSET = 1 << ADC_DMA_CH;
+        else
+            DMA_Control->ALTCLR = 1 << ADC_DMA_CH;
+        DMA_Control->ENASET = 1 << ADC_DMA_CH;
+        done ^= 1;
+    }
+    else {
+        active_buffer = done ^ 1;
+        buffer_arm(done ? ADC_ALTERNATE : ADC_PRIMARY, adc_buffer[done]);
+    }
+
+    buffer_count++;
+    if (buffer_callback)
+        buffer_callback(adc_buffer[done], ADC_DMA_BUFFER_SIZE);
+}
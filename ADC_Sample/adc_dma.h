@@ -0,0 +1,30 @@
+/*
+ * adc_dma.h
+ *
+ *  Continuous ADC14 acquisition on A1 (P5.4) using DMA ping-pong buffers
+ *
+ *  TIMER_A0 CCR1 output triggers each conversion at a fixed sample rate,
+ *  ADC14 runs in repeat single channel mode and DMA channel 7 moves every
+ *  result into one of two buffers. When a buffer is full the DMA switches
+ *  to the other buffer and the callback is called (from the DMA ISR) with
+ *  the full buffer. The CPU is not involved in taking the samples.
+ *
+ *  The callback has until the other buffer fills to finish with the data.
+ */
+
+#ifndef ADC_DMA_H_
+#define ADC_DMA_H_
+
+#include <stdint.h>
+
+#define ADC_DMA_BUFFER_SIZE 1024        // samples per buffer, 1024 max
+
+typedef void (*ADC_DMA_callback)(const uint16_t* buffer, uint16_t length);
+
+void ADC_DMA_init(uint32_t sample_rate, ADC_DMA_callback callback);
+void ADC_DMA_start(void);
+void ADC_DMA_stop(void);
+uint32_t ADC_DMA_buffer_count(void);
+uint32_t ADC_DMA_dropped(void);
+
+#endif /* ADC_DMA_H_ */
@@ -0,0 +1,108 @@
+// PC test of adc_dma.c against the Timer_A, ADC14 and uDMA models in Host/
+//
+//     gcc -O2 -I. -I../BSP -I../Host adc_dma_host.c adc_dma.c ../BSP/dma.c ../Host/msp_host.c
+//         -lm -o adc_dma
+//
+// The ADC input is a counter that goes up by one each conversion, so a
+// sample lost anywhere shows up as a gap in the buffers. For each sample
+// rate, 1 s of acquisition reports the sustained samples per second, the
+// buffers delivered and dropped, gaps, and the CPU cycles per sample (DMA
+// ISR entry, exit and register accesses). Then one callback slower than a
+// buffer checks that the late buffers are counted as dropped. Exits with
+// 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include "msp.h"
+#include "adc_dma.h"
+
+static uint16_t next_input;
+static uint16_t expect;
+static uint32_t gaps, samples;
+static uint32_t slow_cycles;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+// RES_3 converts all 14 bits, the input counts through them
+static uint16_t adc_counter(uint8_t channel)
+{
+    return next_input++ & 0x3FFF;
+}
+
+static void buffer_full(const uint16_t* buffer, uint16_t length)
+{
+    uint16_t index;
+
+    for (index = 0; index < length; index++) {
+        if (buffer[index] != expect)
+            gaps++;
+        expect = (buffer[index] + 1) & 0x3FFF;
+    }
+    samples += length;
+
+    if (slow_cycles) {
+        __delay_cycles(slow_cycles);    // one callback that takes too long,
+        slow_cycles = 0;                // every one would starve main
+    }
+}
+
+// 1 s at rate, returns the samples per second delivered
+static uint32_t run(uint32_t rate)
+{
+    uint64_t start_busy = HOST_stats.busy + HOST_stats.isr, start_time;
+    uint32_t buffers = ADC_DMA_buffer_count(), dropped = ADC_DMA_dropped();
+    double cycles;
+
+    samples = gaps = 0;
+    next_input = expect = 0;
+    ADC_DMA_init(rate, buffer_full);
+    ADC_DMA_start();
+    start_time = HOST_time();
+    HOST_run(HOST_PS);
+    ADC_DMA_stop();
+
+    buffers = ADC_DMA_buffer_count() - buffers;
+    dropped = ADC_DMA_dropped() - dropped;
+    cycles = (double)(HOST_stats.busy + HOST_stats.isr - start_busy) * HOST_mclk() / HOST_PS;
+    printf("%8u %10.0f %8u %8u %6u %10.2f\n", rate,
+           (double)samples * HOST_PS / (HOST_time() - start_time),
+           buffers, dropped, gaps, samples ? cycles / samples : 0);
+    return samples;
+}
+
+int main(void)
+{
+    static const uint32_t rates[] = { 10000, 50000, 100000, 150000 };
+    uint32_t index, got, dropped;
+
+    HOST_adc_input = adc_counter;
+    __enable_irq();
+
+    printf("    rate  samples/s  buffers  dropped   gaps  cycles/sample\n");
+    for (index = 0; index < sizeof(rates) / sizeof(rates[0]); index++) {
+        got = run(rates[index]);
+        check(got >= rates[index] - ADC_DMA_BUFFER_SIZE, "sustained rate");
+        check(gaps <= 1, "no samples lost");   // 1: the partial buffer at stop
+        check(ADC_DMA_dropped() == 0, "no dropped buffers");
+    }
+
+    // first callback busy for 3 buffer times at 50 ksps, 3 MHz MCLK
+    dropped = ADC_DMA_dropped();
+    slow_cycles = 3 * ADC_DMA_BUFFER_SIZE * (HOST_mclk() / 50000);
+    run(50000);
+    check(ADC_DMA_dropped() > dropped, "late buffers counted as dropped");
+    check(gaps > 0, "drops show up as gaps");
+
+    check(HOST_stats.flash_errors == 0, "no clock errors");
+    return failed;
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Block statistics (min, max, sum, mean, variance, peak-to-peak) for
+// ADC sample buffers
+
+#include "adc_stats.h"
+
+// ADC_STATS_SIMD selects the DSP instruction version. It is on for the
+// Cortex-M4 and can be given to the host build, where Host/msp.h does the
+// instructions lane by lane in C.
+#if !defined(ADC_STATS_SIMD) && (defined(__TI_ARM__) || defined(__ARM_FEATURE_DSP))
+#define ADC_STATS_SIMD
+#endif
+
+#ifdef ADC_STATS_SIMD
+#include "msp.h"                // CMSIS SIMD intrinsics
+#endif
+
+// Function to fill in the results once the block has been summed
+static void stats_finish(ADC_stats* stats, uint16_t length, uint16_t min,
+                         uint16_t max, uint32_t sum, uint64_t sum_squares)
+{
+    stats->sum = sum;
+
+    if (length == 0) {
+        stats->min = 0;             // no samples, not the 0xFFFF / 0 seeds
+        stats->max = 0;
+        stats->peak_to_peak = 0;
+        stats->mean = 0;
+        stats->variance = 0;
+        return;
+    }
+
+    stats->min = min;
+    stats->max = max;
+    stats->peak_to_peak = max - min;
+
+    stats->mean = sum / length;
+
+    // var = (sum(x^2) - sum(x)^2 / n) / n
+    stats->variance = (sum_squares - ((uint64_t)sum * sum) / length) / length;
+}
+
+// Portable reference version, one sample at a time without branches
+void ADC_stats_calc_ref(const uint16_t* samples, uint16_t length, ADC_stats* stats)
+{
+    uint16_t index, sample;
+    uint16_t min = 0xFFFF;
+    uint16_t max = 0;
+    uint32_t sum = 0;
+    uint64_t sum_squares = 0;
+
+    for (index = 0; index < length; index++) {
+        sample = samples[index];
+        sum += sample;
+        sum_squares += (uint32_t)sample * sample;
+        min = (sample < min) ? sample : min;    // compiles to conditional moves
+        max = (sample > max) ? sample : max;
+    }
+
+    stats_finish(stats, length, min, max, sum, sum_squares);
+}
+
+#ifdef ADC_STATS_SIMD
+
+// SIMD version, 4 samples (2 words) per loop. Each word holds 2 samples and
+// the min, max values are tracked per halfword lane then combined at the end.
+void ADC_stats_calc(const uint16_t* samples, uint16_t length, ADC_stats* stats)
+{
+    const uint32_t* pairs = (const uint32_t*)samples;
+    uint32_t count = length >> 2;           // number of 4 sample blocks
+    uint32_t x0, x1;
+    uint32_t min2 = 0xFFFFFFFF;             // 2 lanes of min
+    uint32_t max2 = 0;                      // 2 lanes of max
+    uint32_t sum = 0;
+    uint64_t sum_squares = 0;
+    uint16_t min, max, index, sample;
+
+    while (count--) {
+        x0 = *pairs++;
+        x1 = *pairs++;
+
+        // per lane min and max from saturating differences, no flags:
+        // min - sat(min - x) = min(min, x), x + sat(max - x) = max(max, x)
+        min2 = __USUB16(min2, __UQSUB16(min2, x0));
+        max2 = __UADD16(x0, __UQSUB16(max2, x0));
+        min2 = __USUB16(min2, __UQSUB16(min2, x1));
+        max2 = __UADD16(x1, __UQSUB16(max2, x1));
+
+        sum = __SMLAD(x0, 0x00010001, sum); // sum += lo + hi
+        sum = __SMLAD(x1, 0x00010001, sum);
+        sum_squares = __SMLALD(x0, x0, sum_squares);  // += lo*lo + hi*hi
+        sum_squares = __SMLALD(x1, x1, sum_squares);
+    }
+
+    // combine the two lanes
+    min = (uint16_t)min2;
+    if ((min2 >> 16) < min) min = min2 >> 16;
+    max = (uint16_t)max2;
+    if ((max2 >> 16) > max) max = max2 >> 16;
+
+    // last 0-3 samples
+    for (index = length & ~3; index < length; index++) {
+        sample = samples[index];
+        sum += sample;
+        sum_squares += (uint32_t)sample * sample;
+        min = (sample < min) ? sample : min;
+        max = (sample > max) ? sample : max;
+    }
+
+    stats_finish(stats, length, min, max, sum, sum_squares);
+}
+
+#else
+
+// Function to calculate the statistics of a block of samples
+void ADC_stats_calc(const uint16_t* samples, uint16_t length, ADC_stats* stats)
+{
+    ADC_stats_calc_ref(samples, length, stats);
+}
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * adc_stats.h
+ *
+ *  Block statistics for buffers of 14-bit ADC samples
+ *
+ *  On the Cortex-M4 the samples are processed two at a time with the DSP
+ *  SIMD instructions (UQSUB16 with USUB16 / UADD16 for min and max,
+ *  SMLAD/SMLALD for the sum and sum of squares). ADC_stats_calc_ref() is
+ *  the portable version that gives the same results and is used when SIMD
+ *  is not available. An empty block gives all zero results.
+ *
+ *  The SIMD path needs the buffer to be 4-byte aligned and samples must be
+ *  less than 0x8000 (true for all ADC14 results up to 14-bit).
+ */
+
+#ifndef ADC_STATS_H_
+#define ADC_STATS_H_
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint16_t peak_to_peak;      // max - min
+    uint16_t mean;              // sum / length, truncated
+    uint32_t sum;
+    uint32_t variance;          // population variance, truncated
+} ADC_stats;
+
+void ADC_stats_calc(const uint16_t* samples, uint16_t length, ADC_stats* stats);
+void ADC_stats_calc_ref(const uint16_t* samples, uint16_t length, ADC_stats* stats);
+
+#endif /* ADC_STATS_H_ */
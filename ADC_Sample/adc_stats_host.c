@@ -0,0 +1,121 @@
+// PC test of adc_stats.c, the SIMD version against ADC_stats_calc_ref
+//
+//     gcc -O2 -DADC_STATS_SIMD -I. -I../Host adc_stats_host.c adc_stats.c -o adc_stats
+//
+// With ADC_STATS_SIMD the DSP instructions come lane by lane from
+// Host/msp.h, so ADC_stats_calc takes the same path as on the Cortex-M4.
+// Every length from 0 to 67 (all the 0-3 sample tails) and full 1024
+// sample buffers of random, constant, ramp and full scale data must give
+// bit for bit the same results as the reference. Then prints the host time
+// per sample of both, which shows the cost of the lane emulation and not
+// the Cortex-M4 speed. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "adc_stats.h"
+
+#define BUFFER      1024
+#define ROUNDS      20000
+
+static uint16_t buffer[BUFFER] __attribute__((aligned(4)));
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+// both versions over the first length samples, field by field
+static void compare(uint16_t length, const char* what)
+{
+    ADC_stats simd, ref;
+    char text[80];
+
+    ADC_stats_calc(buffer, length, &simd);
+    ADC_stats_calc_ref(buffer, length, &ref);
+    snprintf(text, sizeof(text), "%s, %u samples", what, length);
+    check((simd.min == ref.min) && (simd.max == ref.max) &&
+          (simd.peak_to_peak == ref.peak_to_peak) && (simd.mean == ref.mean) &&
+          (simd.sum == ref.sum) && (simd.variance == ref.variance), text);
+}
+
+static void fill(uint16_t mask, const char* what)
+{
+    uint16_t index;
+
+    for (index = 0; index < BUFFER; index++)
+        buffer[index] = rand() & mask;
+    for (index = 0; index < 68; index++)
+        compare(index, what);
+    compare(BUFFER, what);
+}
+
+static double ns_per_sample(void (*calc)(const uint16_t*, uint16_t, ADC_stats*))
+{
+    struct timespec start, end;
+    volatile uint32_t sink = 0;
+    ADC_stats stats;
+    uint32_t round;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (round = 0; round < ROUNDS; round++) {
+        buffer[round & (BUFFER - 1)] = round & 0x3FFF;  // not hoisted out
+        calc(buffer, BUFFER, &stats);
+        sink += stats.variance;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) /
+           ((double)ROUNDS * BUFFER);
+}
+
+int main(void)
+{
+    ADC_stats stats;
+    uint16_t index;
+
+#ifndef ADC_STATS_SIMD
+    printf("ADC_STATS_SIMD not given, ADC_stats_calc is the reference\n");
+#endif
+
+    // an empty block is all zero, not the 0xFFFF / 0 min and max seeds
+    ADC_stats_calc(buffer, 0, &stats);
+    check(!stats.min && !stats.max && !stats.peak_to_peak && !stats.mean &&
+          !stats.sum && !stats.variance, "empty block all zero");
+    ADC_stats_calc_ref(buffer, 0, &stats);
+    check(!stats.peak_to_peak, "empty block peak to peak, reference");
+
+    srand(1);
+    fill(0x3FFF, "random 14-bit");
+    fill(0x7FFF, "random up to 0x7FFF");
+    fill(0x000F, "random small");
+    fill(0x0000, "all zero");
+
+    for (index = 0; index < BUFFER; index++)
+        buffer[index] = 0x3FFF;
+    compare(BUFFER, "full scale");
+    for (index = 0; index < BUFFER; index++)
+        buffer[index] = index * 16;
+    compare(BUFFER, "rising ramp");
+    for (index = 0; index < BUFFER; index++)
+        buffer[index] = 0x3FFF - index * 16;
+    compare(BUFFER, "falling ramp");
+    for (index = 0; index < BUFFER; index++)
+        buffer[index] = (index & 1) ? 0x3FFF : 0;
+    compare(BUFFER, "alternating lanes");
+
+    ADC_stats_calc(buffer, BUFFER, &stats);
+    check((stats.min == 0) && (stats.max == 0x3FFF) && (stats.peak_to_peak == 0x3FFF) &&
+          (stats.mean == 0x1FFF), "alternating lanes values");
+
+    printf("%u samples: reference %.2f ns/sample, ADC_stats_calc %.2f ns/sample (host)\n",
+           BUFFER, ns_per_sample(ADC_stats_calc_ref), ns_per_sample(ADC_stats_calc));
+    return failed;
+}
+
+#endif
@@ -0,0 +1,76 @@
+// Reset to main timing with the DWT cycle counter and a fast clock for the
+// C init. Everything here before BOOT_INIT_DONE runs before .data and
+// .bss are set up, so it only uses registers and the noinit boot record.
+
+#include "msp.h"
+#include "boot.h"
+#include "clock.h"
+
+#define RESET_MHZ   3                   // DCO at reset
+
+#pragma NOINIT(BOOT_time)
+BOOT_record BOOT_time;
+
+// Function to start CYCCNT from 0, first thing in Reset_Handler
+void BOOT_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;     // enable DWT
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// Function to set the final MCLK after SystemInit, before the C init,
+// with the register steps of clock.c in the order CLOCK_set_profile
+// goes up: VCORE1 and the flash wait state first, the SMCLK divider
+// before the DCO so SMCLK never goes above 3 MHz.
+void BOOT_clock(void)
+{
+#if BOOT_FAST_CLOCK
+    CLOCK_vcore(1);                     // LDO VCORE1
+    CLOCK_wait(1);
+    CLOCK_flash_buffer(CLOCK_BUFFER_INSTR | CLOCK_BUFFER_DATA);
+    CLOCK_select(CLOCK_SOURCE_DCO, 4);  // SMCLK = DCO / 16
+    CLOCK_dco(5);                       // DCO 48 MHz, SMCLK 48 / 16 = 3 MHz
+
+    BOOT_time.mclk = 48000000;
+#else
+    BOOT_time.mclk = RESET_MHZ * 1000000;
+#endif
+
+    BOOT_stamp(BOOT_CLOCK);
+}
+
+// TI run time hook, called by _c_int00 before the C init.
+// Returns 1 to run the C init.
+int _system_pre_init(void)
+{
+    BOOT_stamp(BOOT_INIT);
+    return 1;
+}
+
+// TI run time hook, called by _c_int00 after the C init and before main.
+// The init set SystemCoreClock back to the SystemInit clock.
+void _system_post_cinit(void)
+{
+    SystemCoreClock = BOOT_time.mclk;
+    BOOT_stamp(BOOT_INIT_DONE);
+}
+
+// Function to keep the cycle count of a step
+void BOOT_stamp(uint8_t step)
+{
+    BOOT_time.cycles[step] = DWT->CYCCNT;
+}
+
+// Time of a step from reset in us. Up to BOOT_CLOCK the counter runs at
+// the reset clock, after it at BOOT_time.mclk.
+uint32_t BOOT_us(uint8_t step)
+{
+    uint32_t clock = BOOT_time.cycles[BOOT_CLOCK];
+
+    if (step == BOOT_CLOCK)
+        return clock / RESET_MHZ;
+
+    return clock / RESET_MHZ +
+           (BOOT_time.cycles[step] - clock) / (BOOT_time.mclk / 1000000);
+}
@@ -0,0 +1,60 @@
+/*
+ * boot.h
+ *
+ *  Reset to main timing and a fast start up path
+ *
+ *  The DWT cycle counter is started first thing in Reset_Handler and each
+ *  step of the start up writes its count into a boot record:
+ *
+ *      BOOT_CLOCK      SystemInit and BOOT_clock done, MCLK is final
+ *      BOOT_INIT       _c_int00 starts the .data copy and .bss zero fill
+ *      BOOT_INIT_DONE  C init done, just before main
+ *      BOOT_MAIN       first line of main (BOOT_stamp from main)
+ *      BOOT_SAMPLE     first sample started (BOOT_stamp from main)
+ *
+ *  BOOT_INIT and BOOT_INIT_DONE come from the _system_pre_init and
+ *  _system_post_cinit hooks of the TI run time library. The record is in
+ *  .TI.noinit so the C init does not clear it. BOOT_us gives the time of
+ *  a step from reset. The time before the first instruction (supply ramp
+ *  and the device boot code in ROM) is not counted.
+ *
+ *  Faster start up:
+ *    - BOOT_clock sets MCLK to 48 MHz before the C init with the register
+ *      steps of clock.c, so the copy and fill loops run 16 times faster
+ *      than at the 3 MHz reset clock.
+ *      SMCLK is divided by 16 and stays at 3 MHz, drivers are not changed.
+ *      BOOT_FAST_CLOCK 0 leaves SystemInit's 3 MHz to compare.
+ *    - Large buffers that are always written before they are read are
+ *      marked with #pragma NOINIT so they are not zero filled.
+ *    - The project links with --cinit_compression=off and
+ *      --copy_compression=off (.cproject) so .data is copied with memcpy
+ *      (words) instead of decompressed one byte at a time.
+ */
+
+#ifndef BOOT_H_
+#define BOOT_H_
+
+#include <stdint.h>
+
+#define BOOT_FAST_CLOCK 1               // 48 MHz before the C init
+
+#define BOOT_CLOCK      0
+#define BOOT_INIT       1
+#define BOOT_INIT_DONE  2
+#define BOOT_MAIN       3
+#define BOOT_SAMPLE     4
+#define BOOT_STEPS      5
+
+typedef struct {
+    uint32_t cycles[BOOT_STEPS];        // CYCCNT at each step
+    uint32_t mclk;                      // Hz from BOOT_CLOCK on
+} BOOT_record;
+
+extern BOOT_record BOOT_time;
+
+void BOOT_start(void);
+void BOOT_clock(void);
+void BOOT_stamp(uint8_t step);
+uint32_t BOOT_us(uint8_t step);
+
+#endif /* BOOT_H_ */
@@ -1,15 +1,18 @@
 //******************************************************************************
 //  MSP432P401 Demo - ADC14, Sample A1, AVcc Ref
 //
-//   Description: ADC14 is running in single conversion mode, sampling from A1
-//   with reference to AVcc using the sample and hold timer. On initialization
-//   the SC bit is set to start a conversion. On the interrupt when completing
-//   a conversion the value is saved in a global and a flag is set. In main,
-//   the while loop uses the global flag to reset the SC bit to start and new
-//   conversion and save 20 samples before processing. After 20 samples, the
-//   max, min, and average of the samples is calculated and printed to the
-//   console using printf because I am being lazy and am a horrible, terrible
-//   programmer. DO NOT DO THIS!!! After processing the 20 samples, repeats.
+//   Description: ADC14 samples A1 continuously with reference to AVcc. The
+//   conversions are triggered by TIMER_A0 at SAMPLE_RATE and DMA moves every
+//   result into one of two ping-pong buffers (adc_dma.c), so the CPU does not
+//   touch individual samples. When a buffer is full, the DMA ISR hands it to
+//   adc_buffer_full() which flags it for main. In main, the max, min, and
+//   average of the buffer is calculated (adc_stats.c) and sent out the
+//   backchannel UART at 115200 baud (P1.3). LOG_printf (logger.c) only
+//   formats into the UART TX ring buffer and returns, so main never blocks
+//   on the console. Lines that do not fit are dropped and counted, and
+//   buffers that fill before main is done are counted as overruns.
+//   The time from reset to main and to the first sample (boot.c) is sent
+//   once at start up.
 //
 //
 //                MSP432P401x
@@ -19,95 +22,69 @@
 //          --|RST              |
 //            |                 |
 //        >---|P5.4/A1          |
+//            |     P1.3/UCA0TXD|----> PC (console)
 //
 //   Paul Hummel
 //   Cal Poly
 //   Spring 2020
 //******************************************************************************
 #include "msp.h"
-#include <stdio.h>
+#include "adc_dma.h"
+#include "adc_stats.h"
+#include "uart.h"
+#include "logger.h"
+#include "boot.h"
 
-#define ADC_SAMPLE_SIZE 20
+#define SAMPLE_RATE 50000       // samples per second
 
-static volatile uint8_t ADC_Flag = 0;
-static volatile uint16_t ADC_Sample = 0;
+static const uint16_t* volatile adc_buffer = 0;    // full buffer for main
+static volatile uint32_t adc_overruns = 0;
 
+void adc_buffer_full(const uint16_t* buffer, uint16_t length);
 
 void main(void) {
+    BOOT_stamp(BOOT_MAIN);
     WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD; // halt watchdog timer
 
-    uint16_t adc_buffer[ADC_SAMPLE_SIZE];
-    uint8_t adc_buffer_index = 0;
-    uint16_t adc_avg, adc_min, adc_max;
-    uint32_t adc_total;
+    ADC_stats stats;
 
-    P5->SEL1 |= BIT4;                   // Configure P5.4 for ADC
-    P5->SEL0 |= BIT4;
-
-    // Sampling time, S&H=192, ADC14 on
-    ADC14->CTL0 = ADC14_CTL0_SHT0__4
-                | ADC14_CTL0_SHP
-                | ADC14_CTL0_SSEL__SMCLK
-                | ADC14_CTL0_ON;
-    ADC14->CTL1 = ADC14_CTL1_RES_3;         // Use sampling timer, 12-bit conversion results
-
-    ADC14->MCTL[0] = ADC14_MCTLN_INCH_1;   // A1 ADC input select; Vref=AVCC
-    ADC14->IER0 |= ADC14_IER0_IE0;          // Enable ADC conv complete interrupt
-    ADC14->CTL0 |= ADC14_CTL0_ENC;          // Enable conversion
-
-    NVIC->ISER[0] = 1 << ((ADC14_IRQn) & 31);   // Enable ADC interrupt in NVIC module
+    UART_init();        // console output
+    LOG_init();
+    ADC_DMA_init(SAMPLE_RATE, adc_buffer_full);
 
     __enable_irq();     // Enable global interrupt
 
-    // Start sampling/conversion
-    ADC14->CTL0 |= ADC14_CTL0_SC;
+    ADC_DMA_start();    // Start continuous sampling
+    BOOT_stamp(BOOT_SAMPLE);
+
+    LOG_printf("Boot us: clock %lu  init %lu  main %lu  sample %lu\n",
+               BOOT_us(BOOT_CLOCK), BOOT_us(BOOT_INIT_DONE) - BOOT_us(BOOT_INIT),
+               BOOT_us(BOOT_MAIN), BOOT_us(BOOT_SAMPLE));
 
     while (1)
     {
-        if (ADC_Flag) { // conversion done
-
-            ADC_Flag = 0;                               // save sample, clear flag, move index
-            adc_buffer[adc_buffer_index] = ADC_Sample;
-            adc_buffer_index++;
-
-            if (adc_buffer_index == ADC_SAMPLE_SIZE) {   // have all the samples wanted, so begin processing
-
-                adc_total = 0;  // clear measurements
-                adc_max = 0;
-                adc_min = 0xFFFF;
+        if (adc_buffer) { // buffer full
 
-                for (adc_buffer_index = 0; adc_buffer_index < ADC_SAMPLE_SIZE; adc_buffer_index++){
-                    adc_total += adc_buffer[adc_buffer_index];
+            // min, max, and average of all samples in the buffer
+            ADC_stats_calc(adc_buffer, ADC_DMA_BUFFER_SIZE, &stats);
 
-                    if (adc_buffer[adc_buffer_index] > adc_max) // check for max
-                        adc_max = adc_buffer[adc_buffer_index];
+            LOG_printf("Average is %u\n", stats.mean);
+            LOG_printf("Minimum is %u\n", stats.min);
+            LOG_printf("Maximum is %u\n", stats.max);
+            LOG_printf("Delta   is %u\n", stats.peak_to_peak);
+            LOG_printf("Overruns   %lu  Dropped lines %lu\n\n",
+                       adc_overruns, LOG_dropped());
 
-                    if (adc_buffer[adc_buffer_index] < adc_min) // check for min
-                        adc_min = adc_buffer[adc_buffer_index];
-                }
-
-                adc_avg = adc_total / ADC_SAMPLE_SIZE;
-
-                printf("Average is %d\n",adc_avg);  // horrible and should not be done!!!!
-                printf("Minimum is %d\n",adc_min);
-                printf("Maximum is %d\n",adc_max);
-                printf("Delta   is %d\n\n",adc_max-adc_min);
-                adc_buffer_index = 0;                   // reset buffer to fill again
-
-                //__delay_cycles(100000);
-
-            }
-
-            ADC14->CTL0 |= ADC14_CTL0_SC;   // start next sample
+            adc_buffer = 0;     // done with this buffer
         }
     }
 }
 
-// ADC14 interrupt service routine
-void ADC14_IRQHandler(void) {
+// Called from the DMA ISR each time a buffer of samples is full
+void adc_buffer_full(const uint16_t* buffer, uint16_t length) {
 
-    if (ADC14->IFGR0 & ADC14_IFGR0_IFG0) {  // MEM[0] triggered interrupt
-        ADC_Sample = ADC14->MEM[0] ;        // save result and set global flag
-        ADC_Flag = 1;
-    }
+    if (adc_buffer)         // main has not finished the last buffer
+        adc_overruns++;
+
+    adc_buffer = buffer;    // give the new buffer to main
 }
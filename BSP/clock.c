@@ -0,0 +1,219 @@
+// MCLK / SMCLK profiles changed at run time with VCORE and flash wait
+// states stepped in a safe order
+
+#include "clock.h"
+
+typedef struct {
+    uint32_t hz;                    // MCLK
+    uint8_t source;
+    uint8_t dcorsel;                // DCO range, 0 = 1.5 MHz ... 5 = 48 MHz
+    uint8_t divs;                   // SMCLK = source / 2^divs
+    uint8_t wait;                   // flash wait states, both banks
+    uint8_t vcore;                  // 0 = AM_LDO_VCORE0, 1 = AM_LDO_VCORE1
+} CLOCK_profile;
+
+// sorted by MCLK, every entry needs at least the VCORE and wait states
+// of the entries before it. SMCLK stays at 12 MHz or less, the VCORE0
+// limit.
+static const CLOCK_profile profiles[] = {
+    {  1500000, CLOCK_SOURCE_DCO,  0, 0, 0, 0 },
+    {  3000000, CLOCK_SOURCE_DCO,  1, 0, 0, 0 },
+    {  6000000, CLOCK_SOURCE_DCO,  2, 0, 0, 0 },
+    { 12000000, CLOCK_SOURCE_DCO,  3, 0, 0, 0 },
+    { 24000000, CLOCK_SOURCE_DCO,  4, 1, 1, 0 },
+#if CLOCK_HFXT
+    { 48000000, CLOCK_SOURCE_HFXT, 1, 2, 1, 1 },  // DCO left at 3 MHz, unused
+#else
+    { 48000000, CLOCK_SOURCE_DCO,  5, 2, 1, 1 },
+#endif
+};
+
+#define PROFILES    (sizeof(profiles) / sizeof(profiles[0]))
+
+#if !defined(CLOCK_MODEL)
+#include "msp.h"
+
+#define LOCK()      primask = __get_PRIMASK(); __disable_irq()
+#define UNLOCK()    __set_PRIMASK(primask)
+
+// Function to change the active mode to LDO VCORE0 or VCORE1
+void CLOCK_vcore(uint8_t vcore)
+{
+    if (((PCM->CTL0 & PCM_CTL0_CPM_MASK) >> PCM_CTL0_CPM_OFS) == vcore)
+        return;                     // already there, CPM 0 / 1 = LDO VCORE0 / 1
+
+    while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+    PCM->CTL0 = PCM_CTL0_KEY_VAL | (vcore ? PCM_CTL0_AMR_1 : PCM_CTL0_AMR_0);
+    while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+}
+
+// Function to set the flash read wait states, each bank has its own register
+void CLOCK_wait(uint8_t wait)
+{
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) |
+                         ((uint32_t)wait << FLCTL_BANK0_RDCTL_WAIT_OFS);
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) |
+                         ((uint32_t)wait << FLCTL_BANK1_RDCTL_WAIT_OFS);
+}
+
+// Function to set the flash read buffers of both banks, CLOCK_BUFFER_INSTR
+// and / or CLOCK_BUFFER_DATA, 0 for none
+void CLOCK_flash_buffer(uint8_t buffers)
+{
+    uint32_t bank0 = 0, bank1 = 0;
+
+    if (buffers & CLOCK_BUFFER_INSTR) {
+        bank0 |= FLCTL_BANK0_RDCTL_BUFI;
+        bank1 |= FLCTL_BANK1_RDCTL_BUFI;
+    }
+    if (buffers & CLOCK_BUFFER_DATA) {
+        bank0 |= FLCTL_BANK0_RDCTL_BUFD;
+        bank1 |= FLCTL_BANK1_RDCTL_BUFD;
+    }
+
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL &
+                          ~(FLCTL_BANK0_RDCTL_BUFI | FLCTL_BANK0_RDCTL_BUFD)) | bank0;
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL &
+                          ~(FLCTL_BANK1_RDCTL_BUFI | FLCTL_BANK1_RDCTL_BUFD)) | bank1;
+}
+
+// Function to start the 48 MHz crystal on PJ.2 / PJ.3 and wait until it
+// runs without a fault
+void CLOCK_hfxt(void)
+{
+    PJ->SEL0 |= BIT2 | BIT3;        // HFXIN / HFXOUT
+    PJ->SEL1 &= ~(BIT2 | BIT3);
+
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL2 = (CS->CTL2 & ~CS_CTL2_HFXTFREQ_MASK) | CS_CTL2_HFXTFREQ_6 |
+               CS_CTL2_HFXTDRIVE | CS_CTL2_HFXT_EN;     // 40 - 48 MHz
+    while (CS->IFG & CS_IFG_HFXTIFG)
+        CS->CLRIFG |= CS_CLRIFG_CLR_HFXTIFG;
+    CS->KEY = 0;
+}
+
+// Function to select the MCLK / SMCLK source and the SMCLK divider, MCLK
+// is not divided
+void CLOCK_select(uint8_t source, uint8_t divs)
+{
+    uint32_t sel = (source == CLOCK_SOURCE_HFXT)
+                 ? (CS_CTL1_SELM__HFXTCLK | CS_CTL1_SELS__HFXTCLK)
+                 : (CS_CTL1_SELM__DCOCLK | CS_CTL1_SELS__DCOCLK);
+
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL1 = (CS->CTL1 & ~(CS_CTL1_SELM_MASK | CS_CTL1_SELS_MASK |
+                             CS_CTL1_DIVM_MASK | CS_CTL1_DIVS_MASK)) |
+               sel | CS_CTL1_DIVM__1 | ((uint32_t)divs << CS_CTL1_DIVS_OFS);
+    CS->KEY = 0;
+}
+
+// Function to set the DCO range with the tuning reset
+void CLOCK_dco(uint8_t dcorsel)
+{
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL0 = (uint32_t)dcorsel << CS_CTL0_DCORSEL_OFS;
+    CS->KEY = 0;
+}
+
+// Function to get SMCLK from the dividers left by SystemInit or the start
+// up code. MCLK and SMCLK come from the same source, SystemCoreClock is
+// MCLK.
+static uint32_t clock_start_smclk(void)
+{
+    uint32_t ctl1 = CS->CTL1;
+
+    return (SystemCoreClock << ((ctl1 & CS_CTL1_DIVM_MASK) >> CS_CTL1_DIVM_OFS))
+           >> ((ctl1 & CS_CTL1_DIVS_MASK) >> CS_CTL1_DIVS_OFS);
+}
+#else
+// register steps, clock_start_smclk and SystemCoreClock are in clock_host.c
+#define LOCK()      primask = 0
+#define UNLOCK()    (void)primask
+
+extern uint32_t SystemCoreClock;
+
+uint32_t clock_start_smclk(void);
+#endif
+
+static const CLOCK_profile* current = 0;    // 0 until the first change
+static CLOCK_notify drivers[CLOCK_DRIVERS];
+static uint8_t driver_count = 0;
+static uint8_t hfxt_on = 0;
+
+// Function to add a driver to call around every profile change.
+// Returns 0 when the list is full.
+uint8_t CLOCK_register(CLOCK_notify notify)
+{
+    if (driver_count >= CLOCK_DRIVERS)
+        return 0;
+
+    drivers[driver_count++] = notify;
+    return 1;
+}
+
+static void clock_notify(uint8_t event)
+{
+    uint8_t driver;
+
+    for (driver = 0; driver < driver_count; driver++)
+        drivers[driver](event, CLOCK_mclk(), CLOCK_smclk());
+}
+
+// Function to move MCLK to the profile at hz. Returns 0 if there is no
+// profile for hz. Interrupts are off while the registers change.
+uint8_t CLOCK_set_profile(uint32_t hz)
+{
+    const CLOCK_profile* next = 0;
+    uint32_t primask;
+    uint8_t profile;
+
+    for (profile = 0; profile < PROFILES; profile++)
+        if (profiles[profile].hz == hz)
+            next = &profiles[profile];
+
+    if (!next)
+        return 0;
+
+    clock_notify(CLOCK_BEFORE);
+    LOCK();
+
+    if ((next->source == CLOCK_SOURCE_HFXT) && !hfxt_on) {
+        CLOCK_hfxt();
+        hfxt_on = 1;
+    }
+
+    if (hz > SystemCoreClock) {     // core and flash ready before the clock
+        CLOCK_vcore(next->vcore);
+        CLOCK_wait(next->wait);
+        CLOCK_select(next->source, next->divs);     // lower SMCLK first
+        CLOCK_dco(next->dcorsel);
+    } else {                        // clock down before core and flash
+        CLOCK_dco(next->dcorsel);
+        CLOCK_select(next->source, next->divs);
+        CLOCK_wait(next->wait);
+        CLOCK_vcore(next->vcore);
+    }
+
+    current = next;
+    SystemCoreClock = hz;
+
+    UNLOCK();
+    clock_notify(CLOCK_AFTER);
+
+    return 1;
+}
+
+// MCLK in Hz
+uint32_t CLOCK_mclk(void)
+{
+    return SystemCoreClock;
+}
+
+// SMCLK in Hz, from the start up dividers until the first change
+uint32_t CLOCK_smclk(void)
+{
+    if (!current)
+        return clock_start_smclk();
+
+    return current->hz >> current->divs;
+}
@@ -0,0 +1,87 @@
+/*
+ * clock.h
+ *
+ *  Run time MCLK / SMCLK scaling with VCORE and flash wait state sequencing
+ *
+ *  CLOCK_set_profile(hz) moves MCLK to one of the profiles below and
+ *  does the steps in the order the part needs:
+ *
+ *      going up    VCORE1 (AMR), flash wait states, dividers, DCO range
+ *      going down  DCO range, dividers, flash wait states, VCORE0 (AMR)
+ *
+ *  so MCLK is never faster than the core voltage and flash allow and
+ *  SMCLK is never above its limit, not even between two writes.
+ *
+ *      MCLK        source      VCORE   wait    SMCLK
+ *      1.5 MHz     DCO         0       0       1.5 MHz
+ *      3 MHz       DCO         0       0       3 MHz
+ *      6 MHz       DCO         0       0       6 MHz
+ *      12 MHz      DCO         0       0       12 MHz
+ *      24 MHz      DCO         0       1       12 MHz
+ *      48 MHz      DCO / HFXT  1       1       12 MHz
+ *
+ *  With CLOCK_HFXT set to 1 the 48 MHz profile runs from the 48 MHz
+ *  crystal on PJ.2 / PJ.3 instead of the DCO. The crystal is started the
+ *  first time it is used and left running.
+ *
+ *  Drivers that divide SMCLK or MCLK (UART baud, I2C, timers) register a
+ *  CLOCK_notify. It is called with CLOCK_BEFORE and the old clocks so the
+ *  driver can finish or stop what it is doing, and with CLOCK_AFTER and
+ *  the new clocks to set its dividers again. SystemCoreClock is set to
+ *  MCLK before the CLOCK_AFTER calls.
+ *
+ *  CLOCK_flash_buffer turns the flash read buffers on or off for both
+ *  banks. BUFI keeps the last 128 bit instruction line and BUFD the last
+ *  data line, so code running in a loop or reading a table in flash does
+ *  not pay the wait state on every fetch. SystemInit at 3 MHz leaves both
+ *  off. The part has no prefetch setting, so the buffers are all there is
+ *  to tune.
+ *
+ *  The register steps CLOCK_set_profile is made of are public for start
+ *  up code that sets the clock before the C init (ADC_Sample BOOT_clock).
+ *  They touch no variables, but the order is up to the caller and only
+ *  CLOCK_set_profile calls the notify functions. CLOCK_smclk works out
+ *  SMCLK from the dividers SystemInit or the start up code left until the
+ *  first CLOCK_set_profile.
+ *
+ *  ACLK is not changed. clock.c also builds on a PC with clock_host.c and
+ *  -DCLOCK_MODEL, which replaces the register steps with a model of the
+ *  part and checks every step of every profile change. Without
+ *  CLOCK_MODEL a PC build uses the registers of the model in Host/.
+ */
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include <stdint.h>
+
+#ifndef CLOCK_HFXT
+#define CLOCK_HFXT      0           // 1 to run the 48 MHz profile from HFXT
+#endif
+#define CLOCK_DRIVERS   4           // most notify functions
+
+#define CLOCK_BEFORE    0
+#define CLOCK_AFTER     1
+
+#define CLOCK_BUFFER_INSTR  0x01    // BUFI
+#define CLOCK_BUFFER_DATA   0x02    // BUFD
+
+#define CLOCK_SOURCE_DCO    0       // CLOCK_select sources
+#define CLOCK_SOURCE_HFXT   1
+
+typedef void (*CLOCK_notify)(uint8_t event, uint32_t mclk, uint32_t smclk);
+
+uint8_t CLOCK_set_profile(uint32_t hz);
+uint8_t CLOCK_register(CLOCK_notify notify);
+uint32_t CLOCK_mclk(void);
+uint32_t CLOCK_smclk(void);
+void CLOCK_flash_buffer(uint8_t buffers);
+
+// register steps
+void CLOCK_vcore(uint8_t vcore);
+void CLOCK_wait(uint8_t wait);
+void CLOCK_hfxt(void);
+void CLOCK_select(uint8_t source, uint8_t divs);
+void CLOCK_dco(uint8_t dcorsel);
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,154 @@
+// PC model of the clock registers to check the order of profile changes
+//
+//     gcc -O2 -DCLOCK_MODEL clock_host.c clock.c -o clock
+//     gcc -O2 -DCLOCK_MODEL -DCLOCK_HFXT=1 clock_host.c clock.c -o clock
+//
+// Every register step of clock.c updates the model and the limits below
+// are checked after each one, so a step done too early shows up even if
+// the final state is right. First the steps are run in the order of the
+// ADC_Sample BOOT_clock (48 MHz, SMCLK / 16) and CLOCK_smclk must give
+// the 3 MHz SMCLK they leave before any profile change. Then every
+// profile is changed to every other one and the notify calls are checked
+// for the old and new clocks. Prints the steps of each change and exits
+// with 1 if any check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include "clock.h"
+
+#define MHZ(f)      ((uint32_t)((f) * 1000000))
+
+uint32_t SystemCoreClock = MHZ(3);      // SystemInit default
+
+static const uint32_t dco_hz[] = {
+    MHZ(1.5), MHZ(3), MHZ(6), MHZ(12), MHZ(24), MHZ(48)
+};
+
+// reset state after SystemInit, DCO 3 MHz, LDO VCORE0, 0 wait states
+static struct {
+    uint8_t vcore, wait, hfxt, source, divs, dcorsel, buffers;
+} part = { 0, 0, 0, 0, 0, 1, 0 };
+
+static char steps[128];
+static uint16_t failures = 0;
+
+static uint32_t mclk(void)
+{
+    return part.source ? MHZ(48) : dco_hz[part.dcorsel];
+}
+
+// datasheet limits for LDO VCORE0 / VCORE1
+static void check(const char* step)
+{
+    uint32_t max_mclk = part.vcore ? MHZ(48) : MHZ(24);
+    uint32_t max_smclk = part.vcore ? MHZ(24) : MHZ(12);
+    uint32_t max_no_wait = part.vcore ? MHZ(16) : MHZ(12);
+    const char* error = 0;
+
+    if (mclk() > max_mclk)
+        error = "MCLK above VCORE limit";
+    else if ((mclk() >> part.divs) > max_smclk)
+        error = "SMCLK above VCORE limit";
+    else if (!part.wait && (mclk() > max_no_wait))
+        error = "flash wait states too low";
+    else if (part.source && !part.hfxt)
+        error = "HFXT selected before it runs";
+
+    strcat(steps, " ");
+    strcat(steps, step);
+    if (error) {
+        strcat(steps, " <- ");
+        strcat(steps, error);
+        failures++;
+    }
+}
+
+void CLOCK_vcore(uint8_t vcore) { part.vcore = vcore; check("vcore"); }
+void CLOCK_wait(uint8_t wait) { part.wait = wait; check("wait"); }
+void CLOCK_flash_buffer(uint8_t buffers) { part.buffers = buffers; check("buffer"); }
+void CLOCK_hfxt(void) { part.hfxt = 1; check("hfxt"); }
+void CLOCK_dco(uint8_t dcorsel) { part.dcorsel = dcorsel; check("dco"); }
+
+void CLOCK_select(uint8_t source, uint8_t divs)
+{
+    part.source = source;
+    part.divs = divs;
+    check("select");
+}
+
+uint32_t clock_start_smclk(void)
+{
+    return mclk() >> part.divs;
+}
+
+static uint32_t expect_before, expect_after;
+
+static void driver(uint8_t event, uint32_t mclk, uint32_t smclk)
+{
+    uint32_t expect = (event == CLOCK_BEFORE) ? expect_before : expect_after;
+
+    if ((mclk != expect) || (SystemCoreClock != expect) || (smclk > MHZ(12))) {
+        strcat(steps, (event == CLOCK_BEFORE) ? " <- before" : " <- after");
+        failures++;
+    }
+}
+
+static void change(uint32_t hz)
+{
+    steps[0] = 0;
+    expect_before = SystemCoreClock;
+    expect_after = hz;
+
+    if (!CLOCK_set_profile(hz)) {
+        strcat(steps, " <- no profile");
+        failures++;
+    } else if (mclk() != hz) {
+        strcat(steps, " <- wrong MCLK");
+        failures++;
+    }
+}
+
+int main(void)
+{
+    static const uint32_t profiles[] = {
+        MHZ(1.5), MHZ(3), MHZ(6), MHZ(12), MHZ(24), MHZ(48)
+    };
+    uint8_t from, to, count = sizeof(profiles) / sizeof(profiles[0]);
+
+    // BOOT_clock before the C init
+    steps[0] = 0;
+    CLOCK_vcore(1);
+    CLOCK_wait(1);
+    CLOCK_flash_buffer(CLOCK_BUFFER_INSTR | CLOCK_BUFFER_DATA);
+    CLOCK_select(CLOCK_SOURCE_DCO, 4);
+    CLOCK_dco(5);
+    SystemCoreClock = MHZ(48);
+    if (CLOCK_smclk() != MHZ(3)) {
+        strcat(steps, " <- SMCLK not 3 MHz");
+        failures++;
+    }
+    printf(" boot -> 48.0 MHz:%s\n", steps);
+
+    CLOCK_register(driver);
+
+    for (from = 0; from < count; from++) {
+        for (to = 0; to < count; to++) {
+            change(profiles[from]);
+            change(profiles[to]);
+            printf("%5.1f -> %4.1f MHz:%s\n", profiles[from] / 1e6,
+                   profiles[to] / 1e6, steps);
+        }
+    }
+
+    if (CLOCK_set_profile(MHZ(16))) {
+        printf("16 MHz accepted without a profile\n");
+        failures++;
+    }
+
+    printf("%u failures\n", failures);
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,165 @@
+// Delay functions based on SysTick and the running clock speed
+// Paul Hummel
+
+#include "msp.h"
+#include "delay.h"
+#include "clock.h"
+
+#define SYSTICK_MAX   0x00FFFFFF            // SysTick is a 24-bit down counter
+
+static volatile uint32_t systick_wraps = 0; // upper bits of the cycle count
+static uint32_t mclk_freq = 3000000;        // MCLK in Hz
+static uint64_t base_cycles = 0;            // cycle count at last clock change
+static uint64_t base_us = 0;                // micros at last clock change
+static uint8_t registered = 0;              // CLOCK_notify added
+
+#if DELAY_USE_LPM0
+static volatile uint8_t timer_done = 0;
+#endif
+
+// Function to read the 64-bit count of MCLK cycles since delay_init()
+static uint64_t cycle_count(void)
+{
+    uint32_t wraps, value;
+
+    do {                                    // re-read if SysTick wrapped
+        wraps = systick_wraps;
+        value = SysTick->VAL;
+    } while (wraps != systick_wraps);
+
+    return ((uint64_t)wraps << 24) + (SYSTICK_MAX - value);
+}
+
+// Function to add the cycles since the last fold to base_us at freq. The
+// part us left over stays in the cycle count, so folding loses no time.
+static void delay_fold(uint32_t freq)
+{
+    uint64_t us = ((cycle_count() - base_cycles) * 1000000) / freq;
+
+    base_us += us;
+    base_cycles += (us * freq) / 1000000;
+}
+
+// CLOCK_set_profile notify - delays and micros() follow the new MCLK.
+// clock.c raises MCLK last and lowers it first, so the register steps in
+// between run at the lower of the two clocks.
+static void delay_notify(uint8_t event, uint32_t mclk, uint32_t smclk)
+{
+    (void)smclk;
+    if (event == CLOCK_BEFORE) {
+        delay_fold(mclk_freq);
+    } else {
+        delay_fold((mclk < mclk_freq) ? mclk : mclk_freq);
+        mclk_freq = mclk;
+    }
+}
+
+// Function to start SysTick free running from MCLK and read the clock speed.
+// Every later CLOCK_set_profile is followed through a CLOCK_notify.
+void delay_init(void)
+{
+    SysTick->LOAD = SYSTICK_MAX;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |    // MCLK
+                    SysTick_CTRL_TICKINT_Msk |      // interrupt on wrap
+                    SysTick_CTRL_ENABLE_Msk;
+
+    systick_wraps = 0;
+    base_cycles = 0;
+    base_us = 0;
+
+    SystemCoreClockUpdate();
+    mclk_freq = SystemCoreClock;
+
+    if (!registered)
+        registered = CLOCK_register(delay_notify);
+
+#if DELAY_USE_LPM0
+    NVIC->ISER[0] = 1 << ((T32_INT1_IRQn) & 31);
+#endif
+}
+
+// Function to re-read the clock speed after MCLK has been changed without
+// CLOCK_set_profile. micros() keeps counting from where it was.
+void delay_clock_update(void)
+{
+    delay_fold(mclk_freq);
+
+    SystemCoreClockUpdate();
+    mclk_freq = SystemCoreClock;
+}
+
+// Microseconds since delay_init()
+uint32_t micros(void)
+{
+    return base_us + ((cycle_count() - base_cycles) * 1000000) / mclk_freq;
+}
+
+// Function to spin for a number of MCLK cycles counted on SysTick
+static void spin(uint64_t cycles)
+{
+    uint32_t last = SysTick->VAL;
+    uint32_t now;
+    uint64_t elapsed = 0;
+
+    while (elapsed < cycles) {
+        now = SysTick->VAL;
+        elapsed += (last - now) & SYSTICK_MAX;  // handles 24-bit wrap
+        last = now;
+    }
+}
+
+// Function to spin for time us. The wait is counted in MCLK cycles so it
+// is as accurate as the clock. The call itself takes a few cycles.
+void delay_us(uint32_t time)
+{
+    spin(((uint64_t)time * mclk_freq) / 1000000);
+}
+
+#if DELAY_USE_LPM0
+
+// Function to sleep in LPM0 for time ms. Timer32 one-shot counts MCLK and
+// wakes the CPU when it reaches 0.
+void delay_ms(uint32_t time)
+{
+    uint32_t cycles = ((uint64_t)time * mclk_freq) / 1000;
+
+    if (cycles == 0)
+        return;
+
+    timer_done = 0;
+    // 32-bit before LOAD, a 16-bit timer only loads the low half
+    TIMER32_1->CONTROL = TIMER32_CONTROL_IE |       // interrupt at 0
+                         TIMER32_CONTROL_SIZE |     // 32-bit
+                         TIMER32_CONTROL_ONESHOT;   // stop at 0
+    TIMER32_1->LOAD = cycles;
+    TIMER32_1->CONTROL |= TIMER32_CONTROL_ENABLE;   // start
+
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;     // LPM0 keeps MCLK peripherals
+    while (!timer_done)
+        __sleep();                          // woken by any interrupt
+}
+
+// Timer32 ISR ends the delay_ms sleep
+void T32_INT1_IRQHandler(void)
+{
+    TIMER32_1->INTCLR = 0;
+    TIMER32_1->CONTROL = 0;
+    timer_done = 1;
+}
+
+#else
+
+// Function to spin for time ms, one wait so the call cost is only paid once
+void delay_ms(uint32_t time)
+{
+    spin(((uint64_t)time * mclk_freq) / 1000);
+}
+
+#endif
+
+// SysTick ISR counts wraps so the cycle count is 64-bit
+void SysTick_Handler(void)
+{
+    systick_wraps++;
+}
@@ -0,0 +1,49 @@
+/*
+ * delay.h
+ *
+ *  Created on: Apr 5, 2018
+ *      Author: Paul Hummel
+ *
+ *  Delay functions timed with SysTick counting MCLK. The MCLK frequency is
+ *  read from the CS registers with SystemCoreClockUpdate(), so the delays
+ *  stay correct at any DCO setting. delay_init() registers a CLOCK_notify,
+ *  so every CLOCK_set_profile after it is followed and delay.c needs
+ *  clock.c in the project. Code that writes the CS registers itself calls
+ *  delay_clock_update() after the change.
+ *
+ *  micros() is a free running microsecond count (wraps after ~71 minutes).
+ *
+ *  With DELAY_USE_LPM0 set to 1, delay_ms() sleeps in LPM0 on a Timer32
+ *  interrupt instead of spinning. Short delay_us() delays always spin.
+ *
+ *  delay_init() does not enable interrupts. The spinning delays work with
+ *  them off, micros() past the first SysTick wrap (0.35 s at 48 MHz) and
+ *  the LPM0 delay_ms() need the caller to have called __enable_irq().
+ *
+ *  delay.c owns SysTick: it runs it free from MCLK over the full 24 bits
+ *  and defines SysTick_Handler to count the wraps. A program that links
+ *  delay.c cannot use SysTick or have its own SysTick_Handler, a periodic
+ *  tick goes on a Timer_A or TIMER32_2 instead. With DELAY_USE_LPM0 delay.c
+ *  also owns TIMER32_1 and T32_INT1_IRQHandler.
+ *
+ *  DELAY_USE_LPM0 is set for a project with a predefined symbol
+ *  (-DDELAY_USE_LPM0=1), the BSP default is 0.
+ */
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+#include <stdint.h>
+
+#ifndef DELAY_USE_LPM0
+#define DELAY_USE_LPM0 0
+#endif
+
+void delay_init(void);
+void delay_clock_update(void);
+void delay_ms(uint32_t time);
+void delay_us(uint32_t time);
+uint32_t micros(void);
+
+
+#endif /* DELAY_H_ */
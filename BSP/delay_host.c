@@ -0,0 +1,156 @@
+// PC test of delay.c against the SysTick and CS models in Host/
+//
+//     gcc -O2 -I../Host delay_host.c delay.c clock.c system_msp432p401r.c
+//         ../Host/msp_host.c -lm -o delay
+//
+// and again with -DDELAY_USE_LPM0=1 for the Timer32 sleep in delay_ms.
+//
+// At every DCORSEL setting, after delay_clock_update, delay_us and
+// delay_ms must last the time asked for and micros() must follow the
+// simulated time. The delay error is printed in us and in MCLK cycles: it
+// is the last SysTick read of the wait loop plus the call, so it is within
+// 1 us from 6 MHz up and within a few cycles below that, where one cycle
+// is already 0.33 - 0.67 us. Asleep, delay_ms also pays the Timer32
+// interrupt that wakes it. micros() may be off by the few cycles between
+// the CS write and delay_clock_update, they run at the new clock but
+// count at the old.
+//
+// The same must hold after CLOCK_set_profile with no delay_clock_update,
+// delay.c follows it through its CLOCK_notify. The register steps between
+// CLOCK_BEFORE and CLOCK_AFTER count at the lower clock but a few of them
+// run at the higher one, so micros() may move by a few cycles of the
+// lower clock at each change. Also checks that delay_init leaves PRIMASK
+// as it was. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "msp.h"
+#include "delay.h"
+#include "clock.h"
+
+#define US          (HOST_PS / 1000000)
+#define LOOP_CYCLES (3 * HOST_ACCESS_CYCLES)    // SysTick read, call and return
+#define STEP_CYCLES (8 * HOST_ACCESS_CYCLES)    // CLOCK_set_profile steps at the other clock
+
+#if DELAY_USE_LPM0
+#define WAKE_CYCLES 48                  // interrupt entry, T32_INT1_IRQHandler and return
+#else
+#define WAKE_CYCLES 0
+#endif
+
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void set_clock(uint32_t dcorsel)
+{
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL1 = CS_CTL1_SELA__REFOCLK | CS_CTL1_SELS__DCOCLK | CS_CTL1_SELM__DCOCLK |
+               CS_CTL1_DIVS__2;         // SMCLK <= 24 MHz
+    CS->CTL0 = dcorsel << CS_CTL0_DCORSEL_OFS;
+    CS->KEY = 0;
+}
+
+// length of fn(time) minus time, in ps
+static int64_t error_of(void (*fn)(uint32_t), uint32_t time, uint64_t unit)
+{
+    uint64_t start = HOST_time();
+
+    fn(time);
+    return (int64_t)(HOST_time() - start) - (int64_t)(time * unit);
+}
+
+static const uint32_t us_times[] = { 1, 2, 10, 37, 40, 100, 1000, 1520, 50000 };
+static const uint32_t ms_times[] = { 1, 2, 50 };
+
+static uint64_t start_time;
+static uint32_t start_us;
+static double old_cycle_ps;
+static int64_t drift;                   // micros() error allowed for the profile changes
+
+// Function to time the delays at the clock just set and check micros()
+static void measure(const char* mhz)
+{
+    uint32_t index;
+    int64_t error, worst, limit, ms_worst, ms_limit, micros_error, micros_limit;
+    double cycle_ps = (double)HOST_PS / HOST_mclk();
+
+    worst = 0;
+    for (index = 0; index < sizeof(us_times) / sizeof(us_times[0]); index++) {
+        error = error_of(delay_us, us_times[index], US);
+        if (llabs(error) > llabs(worst))
+            worst = error;
+    }
+    ms_worst = 0;
+    for (index = 0; index < sizeof(ms_times) / sizeof(ms_times[0]); index++) {
+        error = error_of(delay_ms, ms_times[index], 1000 * US);
+        if (llabs(error) > llabs(ms_worst))
+            ms_worst = error;
+    }
+
+    // 2 s asleep, several SysTick wraps at 48 MHz
+    HOST_run(2 * HOST_PS);
+    micros_error = (int64_t)(micros() - start_us) * US - (int64_t)(HOST_time() - start_time);
+
+    limit = (HOST_mclk() >= 6000000) ? (int64_t)US : (int64_t)(LOOP_CYCLES * cycle_ps);
+    ms_limit = limit + (int64_t)(WAKE_CYCLES * cycle_ps);
+    micros_limit = 3 * US + (int64_t)(LOOP_CYCLES * fabs(cycle_ps - old_cycle_ps)) + drift;
+    old_cycle_ps = cycle_ps;
+    check((worst >= 0) && (worst <= limit), "delay error");
+    check((ms_worst >= 0) && (ms_worst <= ms_limit), "delay_ms error");
+    check(llabs(micros_error) <= micros_limit, "micros() within 3 us after the clock changes");
+    if (llabs(ms_worst) > llabs(worst))
+        worst = ms_worst;
+    printf("%7s  %+9.3f us (%+5.1f cycles)            %+.3f us\n", mhz,
+           (double)worst / US, worst / cycle_ps, (double)micros_error / US);
+}
+
+int main(void)
+{
+    static const char* const dco[6] = { "1.5", "3", "6", "12", "24", "48" };
+    static const uint32_t profiles[] = { 1500000, 12000000, 48000000, 24000000, 3000000 };
+    char mhz[12];
+    uint32_t dcorsel, profile;
+
+    PCM->CTL0 = PCM_CTL0_KEY_VAL | PCM_CTL0_AMR_1;  // 48 MHz needs VCORE1
+    while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) | FLCTL_BANK0_RDCTL_WAIT_1;
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) | FLCTL_BANK1_RDCTL_WAIT_1;
+
+    __disable_irq();
+    delay_init();
+    check(__get_PRIMASK() == 1, "delay_init leaves interrupts off");
+    __enable_irq();                     // micros() past a SysTick wrap
+    start_us = micros();
+    start_time = HOST_time();
+    old_cycle_ps = (double)HOST_PS / HOST_mclk();
+
+    printf("DCO MHz  worst delay_us / delay_ms error   micros() error\n");
+    for (dcorsel = 0; dcorsel < 6; dcorsel++) {
+        set_clock(dcorsel);
+        delay_clock_update();
+        measure(dco[dcorsel]);
+    }
+
+    printf("CLOCK_set_profile, no delay_clock_update\n");
+    for (profile = 0; profile < sizeof(profiles) / sizeof(profiles[0]); profile++) {
+        check(CLOCK_set_profile(profiles[profile]), "CLOCK_set_profile");
+        drift += (int64_t)(STEP_CYCLES * fmax(old_cycle_ps, (double)HOST_PS / HOST_mclk()));
+        snprintf(mhz, sizeof(mhz), "%.3g", profiles[profile] / 1e6);
+        measure(mhz);
+    }
+
+    check(HOST_stats.flash_errors == 0, "no clock errors");
+    return failed;
+}
+
+#endif
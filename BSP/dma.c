@@ -0,0 +1,62 @@
+// uDMA control table shared by the DMA drivers and the DMA_INT1 handler
+
+#include "msp.h"
+#include "dma.h"
+
+// primary structures for 8 channels followed by the alternate structures,
+// the table must be aligned to its size
+#pragma DATA_ALIGN(dma_table, 256)
+static DMA_descriptor dma_table[2 * DMA_CHANNELS];
+
+static DMA_handler int1_handler = 0;
+
+// Function to enable the controller on the control table. Every driver
+// calls it, the table does not move so calling it again changes nothing.
+void DMA_init(void)
+{
+    DMA_Control->CFG = DMA_CFG_MASTEN;
+    DMA_Control->CTLBASE = (uintptr_t)dma_table;
+}
+
+// Function to connect channel to its trigger source (datasheet DMA
+// sources), single requests only and requests not masked
+void DMA_channel(uint8_t channel, uint8_t source)
+{
+    DMA_Channel->CH_SRCCFG[channel] = source;
+    DMA_Control->USEBURSTCLR = 1 << channel;
+    DMA_Control->REQMASKCLR = 1 << channel;
+}
+
+// Function to have handler called when channel completes and enable
+// DMA_INT1 in the NVIC
+void DMA_int1(uint8_t channel, DMA_handler handler)
+{
+    int1_handler = handler;
+    DMA_Channel->INT1_SRCCFG = DMA_INT1_SRCCFG_EN | channel;
+    NVIC->ISER[1] = 1 << ((DMA_INT1_IRQn) & 31);
+}
+
+DMA_descriptor* DMA_primary(uint8_t channel)
+{
+    return &dma_table[channel];
+}
+
+DMA_descriptor* DMA_alternate(uint8_t channel)
+{
+    return &dma_table[DMA_CHANNELS + channel];
+}
+
+// Function to fill a descriptor, the control word is written last
+void DMA_set(DMA_descriptor* descriptor, volatile const void* src_end,
+             volatile void* dst_end, uint32_t control)
+{
+    descriptor->src_end = (volatile void*)src_end;
+    descriptor->dst_end = dst_end;
+    descriptor->control = control;
+}
+
+void DMA_INT1_IRQHandler(void)
+{
+    if (int1_handler)
+        int1_handler();
+}
@@ -0,0 +1,59 @@
+/*
+ * dma.h
+ *
+ *  uDMA control table and descriptor helpers for the DMA drivers
+ *
+ *  There is one control table for the whole part: a primary descriptor
+ *  for each of the 8 channels followed by the alternate descriptors,
+ *  aligned to its size. dma.c owns it, DMA_init points the controller at
+ *  it and each driver only writes the descriptors of its own channels.
+ *
+ *  DMA_INT1 is dedicated to the completion of one channel. dma.c owns
+ *  DMA_INT1_IRQHandler, it calls the handler given to DMA_int1, so only
+ *  one driver in a program can use it. The handler clears the channel
+ *  flags in DMA_Channel->INT0_CLRFLG itself.
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <stdint.h>
+
+#define DMA_CHANNELS    8
+
+// uDMA channel control word fields
+#define DMA_DST_INC_8   (0u << 30)      // destination increment byte
+#define DMA_DST_INC_16  (1u << 30)      // destination increment halfword
+#define DMA_DST_INC_0   (3u << 30)      // destination address does not increment
+#define DMA_DST_SIZE_8  (0u << 28)      // destination data size byte
+#define DMA_DST_SIZE_16 (1u << 28)      // destination data size halfword
+#define DMA_SRC_INC_8   (0u << 26)      // source increment byte
+#define DMA_SRC_INC_0   (3u << 26)      // source address does not increment
+#define DMA_SRC_SIZE_8  (0u << 24)      // source data size byte
+#define DMA_SRC_SIZE_16 (1u << 24)      // source data size halfword
+#define DMA_ARB_1       (0u << 14)      // 1 transfer per trigger
+#define DMA_N_MINUS_1(n) (((uint32_t)(n) - 1) << 4)
+#define DMA_CYCLE_MASK  7
+#define DMA_BASIC       1               // cycle control - basic
+#define DMA_PINGPONG    3               // cycle control - ping-pong
+
+// uDMA channel control structure
+typedef struct {
+    volatile void* src_end;             // last source address
+    volatile void* dst_end;             // last destination address
+    volatile uint32_t control;          // channel control word
+    uint32_t spare;
+} DMA_descriptor;
+
+typedef void (*DMA_handler)(void);
+
+void DMA_init(void);
+void DMA_channel(uint8_t channel, uint8_t source);
+void DMA_int1(uint8_t channel, DMA_handler handler);
+DMA_descriptor* DMA_primary(uint8_t channel);
+DMA_descriptor* DMA_alternate(uint8_t channel);
+void DMA_set(DMA_descriptor* descriptor, volatile const void* src_end,
+             volatile void* dst_end, uint32_t control);
+
+
+#endif /* DMA_H_ */
@@ -0,0 +1,259 @@
+// Frequency / period measurement with extended Timer_A timestamps
+//
+// FREQ_RECIPROCAL: input edge -> TIMER_A0 CCRn capture -> 32-bit timestamp
+//                  first edge after gate and min_edges closes the window
+// FREQ_GATED:      input edge -> TIMER_A1 clock (TA1CLK), counted in TA1R
+//                  TIMER_A0 CCR1 compare steps -> gate, read TA1R
+// TIMER_A0 / A1 roll over -> upper 16 bits of the timestamp / edge count
+
+#include "msp.h"
+#include "freq.h"
+
+#define HALF_COUNT  0x8000
+
+static FREQ_Mode freq_mode = FREQ_RECIPROCAL;
+static uint32_t gate_counts;            // minimum window, TIMER_A0 counts
+static uint16_t min_periods;            // minimum input periods per window
+static uint16_t gate_steps;             // CCR1 steps per gate (gated mode)
+
+static volatile uint32_t ta0_overflow = 0;
+static volatile uint32_t ta1_overflow = 0;
+
+// window being measured, only used by the ISRs
+static uint8_t window_open = 0;
+static uint32_t window_start;           // timestamp or edge count at start
+static uint32_t window_periods;
+static uint16_t window_steps;
+
+// last finished window for FREQ_read
+static FREQ_Window result;
+static volatile uint8_t result_ready = 0;
+static volatile uint32_t missed = 0;
+
+// Function to extend a TIMER_A0 capture to 32 bits. A roll over that is
+// still pending belongs to this capture only if the capture is from the
+// low half of the count, it happened after the roll over.
+static uint32_t FREQ_stamp(uint16_t capture)
+{
+    uint32_t high = ta0_overflow;
+
+    if ((TIMER_A0->CTL & TIMER_A_CTL_IFG) && (capture < HALF_COUNT))
+        high++;
+
+    return (high << 16) | capture;
+}
+
+// Function to read the 32-bit TIMER_A1 edge count. TA1R is clocked by
+// the input so it is read until 2 reads match.
+static uint32_t FREQ_edge_count(void)
+{
+    uint32_t high = ta1_overflow;
+    uint16_t count, check;
+
+    count = TIMER_A1->R;
+    do {
+        check = count;
+        count = TIMER_A1->R;
+    } while (count != check);
+
+    if ((TIMER_A1->CTL & TIMER_A_CTL_IFG) && (count < HALF_COUNT))
+        high++;
+
+    return (high << 16) | count;
+}
+
+// Function to hand a finished window to FREQ_read. An unread result is
+// replaced by the newer one.
+static void FREQ_publish(uint32_t events, uint32_t counts)
+{
+    result.events = events;
+    result.counts = counts;
+    result_ready = 1;
+}
+
+// Function to set up TIMER_A0 for the selected mode and TIMER_A1 to count
+// input edges in gated mode. gate_ms is the minimum time per result, in
+// reciprocal mode min_edges is the minimum number of periods per result.
+// Interrupts are left as they were, the caller enables them.
+void FREQ_init(FREQ_Mode mode, uint16_t gate_ms, uint16_t min_edges)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    freq_mode = mode;
+    gate_counts = (uint32_t)gate_ms * (FREQ_TIMER_CLK / 1000);
+    min_periods = (min_edges == 0) ? 1 : min_edges;
+    gate_steps = (gate_counts + FREQ_GATE_STEP - 1) / FREQ_GATE_STEP;
+    if (gate_steps == 0)
+        gate_steps = 1;
+
+    ta0_overflow = 0;
+    ta1_overflow = 0;
+    window_open = 0;
+    result_ready = 0;
+    missed = 0;
+
+    TIMER_A0->CTL = TIMER_A_CTL_CLR;
+    TIMER_A0->CCTL[1] = 0;
+    TIMER_A0->CCTL[FREQ_CCR] = 0;
+    TIMER_A1->CTL = TIMER_A_CTL_CLR;
+
+    if (mode == FREQ_RECIPROCAL) {
+        TIMER_A0->CCTL[FREQ_CCR] = TIMER_A_CCTLN_CM__RISING // capture rising edge
+                                 | FREQ_CCIS                // select input
+                                 | TIMER_A_CCTLN_SCS        // synchronous captures
+                                 | TIMER_A_CCTLN_CAP        // capture mode
+                                 | TIMER_A_CCTLN_CCIE;      // enable interrupts
+
+        TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK
+                      | FREQ_TIMER_ID
+                      | TIMER_A_CTL_IE              // roll over extends stamps
+                      | TIMER_A_CTL_MC__CONTINUOUS;
+    }
+    else {
+        P7->SEL0 |= BIT2;       // TA1CLK on P7.2 (default port map)
+        P7->SEL1 &= ~BIT2;
+        P7->DIR &= ~BIT2;
+
+        TIMER_A1->CTL = TIMER_A_CTL_SSEL__TACLK     // count input edges
+                      | TIMER_A_CTL_IE              // roll over extends count
+                      | TIMER_A_CTL_MC__CONTINUOUS;
+
+        window_steps = 0;
+        TIMER_A0->CCR[1] = FREQ_GATE_STEP;
+        TIMER_A0->CCTL[1] = TIMER_A_CCTLN_CCIE;     // compare, gate steps
+        TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK
+                      | FREQ_TIMER_ID
+                      | TIMER_A_CTL_MC__CONTINUOUS;
+
+        NVIC->ISER[0] = (1 << (TA1_N_IRQn & 31));
+    }
+
+    NVIC->ISER[0] = (1 << (TA0_N_IRQn & 31));
+
+    __set_PRIMASK(primask);
+}
+
+// Function to get the last finished window. Returns 1 if there is a new
+// one since the last read.
+uint8_t FREQ_read_window(FREQ_Window* window)
+{
+    uint32_t primask;
+
+    if (!result_ready)
+        return 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();                // window is 2 words, copy it whole
+    *window = result;
+    result_ready = 0;
+    __set_PRIMASK(primask);
+
+    return 1;
+}
+
+// Function to get the frequency of the last finished window in
+// 1 / FREQ_SCALE Hz. Returns 1 if there is a new result since the last read.
+uint8_t FREQ_read(uint32_t* freq)
+{
+    FREQ_Window window;
+
+    if (!FREQ_read_window(&window) || (window.counts == 0))
+        return 0;
+
+    *freq = (((uint64_t)window.events * FREQ_TIMER_CLK * FREQ_SCALE)
+            + (window.counts / 2)) / window.counts;
+
+    return 1;
+}
+
+// Returns the number of captures lost to capture overflow (COV)
+uint32_t FREQ_missed(void)
+{
+    return missed;
+}
+
+// Function for an input edge in reciprocal mode
+static void FREQ_capture(void)
+{
+    uint16_t capture;
+    uint32_t stamp;
+
+    capture = TIMER_A0->CCR[FREQ_CCR];
+    TIMER_A0->CCTL[FREQ_CCR] &= ~TIMER_A_CCTLN_CCIFG;
+
+    if (TIMER_A0->CCTL[FREQ_CCR] & TIMER_A_CCTLN_COV) {
+        // edges were lost, time from the newest capture on
+        TIMER_A0->CCTL[FREQ_CCR] &= ~TIMER_A_CCTLN_COV;
+        capture = TIMER_A0->CCR[FREQ_CCR];
+        missed++;
+        window_open = 0;
+    }
+
+    stamp = FREQ_stamp(capture);
+
+    if (!window_open) {
+        window_start = stamp;
+        window_periods = 0;
+        window_open = 1;
+        return;
+    }
+
+    window_periods++;
+    if ((window_periods >= min_periods) &&
+        (stamp - window_start >= gate_counts)) {
+        FREQ_publish(window_periods, stamp - window_start);
+        window_start = stamp;               // this edge starts the next window
+        window_periods = 0;
+    }
+}
+
+// Function for a CCR1 gate step in gated mode
+static void FREQ_gate(void)
+{
+    uint32_t count;
+
+    TIMER_A0->CCTL[1] &= ~TIMER_A_CCTLN_CCIFG;
+    TIMER_A0->CCR[1] += FREQ_GATE_STEP;
+
+    if (++window_steps < gate_steps)
+        return;
+
+    window_steps = 0;
+    count = FREQ_edge_count();
+
+    if (window_open)
+        FREQ_publish(count - window_start,
+                     (uint32_t)gate_steps * FREQ_GATE_STEP);
+
+    window_start = count;
+    window_open = 1;
+}
+
+// TIMER_A0 ISR - captures and gate steps, roll over last so a capture sees
+// the roll over as pending
+void TA0_N_IRQHandler(void)
+{
+    if ((freq_mode == FREQ_RECIPROCAL) &&
+        (TIMER_A0->CCTL[FREQ_CCR] & TIMER_A_CCTLN_CCIFG))
+        FREQ_capture();
+
+    if ((freq_mode == FREQ_GATED) &&
+        (TIMER_A0->CCTL[1] & TIMER_A_CCTLN_CCIFG))
+        FREQ_gate();
+
+    if (TIMER_A0->CTL & TIMER_A_CTL_IFG) {
+        TIMER_A0->CTL &= ~TIMER_A_CTL_IFG;
+        ta0_overflow++;
+    }
+}
+
+// TIMER_A1 ISR - input edge count roll over in gated mode
+void TA1_N_IRQHandler(void)
+{
+    if (TIMER_A1->CTL & TIMER_A_CTL_IFG) {
+        TIMER_A1->CTL &= ~TIMER_A_CTL_IFG;
+        ta1_overflow++;
+    }
+}
@@ -0,0 +1,240 @@
+// PC test of freq.c against the Timer_A model in Host/, with each
+// project's freq.h
+//
+//     gcc -O2 -I../TimerA_Capture -I../Host freq_host.c freq.c ../Host/msp_host.c -lm -o freq
+//     gcc -O2 -I../Comp_Freq -I../Host freq_host.c freq.c ../Host/msp_host.c -lm -o freq
+//
+// Square waves are fed into the FREQ_CCR capture input for FREQ_RECIPROCAL
+// and into TA1CLK for FREQ_GATED, with SMCLK set so TIMER_A0 runs at
+// FREQ_TIMER_CLK. Every result must be within 1 timer count over its
+// window (reciprocal) or 1 edge per gate (gated) of the input, windows
+// must be back to back with no periods lost and no capture may be missed.
+// One run puts each edge 2 counts before or after a TIMER_A0 roll over
+// with interrupts off, so the capture must go to the right 65536 counts
+// with the roll over still pending. Also checks that FREQ_init and
+// FREQ_read_window leave PRIMASK as it was. Prints each frequency with
+// the result, the error and the interrupts and CPU time per second.
+// Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include "msp.h"
+#include "freq.h"
+
+#define GATE_MS     100
+#define RUN_WINDOWS 8
+
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+// SMCLK = DCO = FREQ_TIMER_CLK times the TIMER_A0 input divider
+static void set_clock(void)
+{
+    static const uint32_t dco[] = { 1500000, 3000000, 6000000, 12000000, 24000000 };
+    uint32_t smclk = FREQ_TIMER_CLK << ((FREQ_TIMER_ID & TIMER_A_CTL_ID_MASK) >> TIMER_A_CTL_ID_OFS);
+    uint32_t dcorsel;
+
+    for (dcorsel = 0; (dcorsel < 4) && (dco[dcorsel] != smclk); dcorsel++);
+    check(dco[dcorsel] == smclk, "SMCLK for FREQ_TIMER_CLK from the DCO");
+
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) | FLCTL_BANK0_RDCTL_WAIT_1;
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) | FLCTL_BANK1_RDCTL_WAIT_1;
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL0 = dcorsel << CS_CTL0_DCORSEL_OFS;
+    CS->KEY = 0;
+}
+
+// reciprocal: run the wave on the capture input until RUN_WINDOWS results.
+// HOST_run stops on the first instruction past the time asked, so the
+// expected counts come from the times the edges were actually fed.
+static void reciprocal(double hz, uint16_t min_edges)
+{
+    uint64_t period = (uint64_t)(HOST_PS / hz), next, edge_time = 0, open_time = 0;
+    uint64_t time, cpu, interrupts;
+    uint32_t windows = 0, worst = 0, error, expect, edges = 0, open_edge = 0, lost = 0;
+    uint32_t counts = 0;
+    uint8_t input = (FREQ_CCIS == TIMER_A_CCTLN_CCIS_1);
+    FREQ_Window window;
+    double measured = 0, seconds;
+
+    HOST_timer_input(0, FREQ_CCR, input, 0);
+    FREQ_init(FREQ_RECIPROCAL, GATE_MS, min_edges);
+    time = HOST_time();
+    cpu = HOST_stats.isr;
+    interrupts = HOST_stats.interrupts;
+    next = time + HOST_PS / 1000 + period / 3;
+
+    while (windows < RUN_WINDOWS) {
+        HOST_run(next - HOST_time());
+        edge_time = HOST_time();
+        HOST_timer_input(0, FREQ_CCR, input, 1);
+        HOST_run(period / 2);
+        HOST_timer_input(0, FREQ_CCR, input, 0);
+        if (edges++ == 0)
+            open_time = edge_time;
+        next += period;
+
+        if (FREQ_read_window(&window)) {
+            // the window runs from the edge that opened it to this one
+            expect = (uint32_t)((double)(edge_time - open_time) * FREQ_TIMER_CLK / HOST_PS + 0.5);
+            error = (window.counts > expect) ? window.counts - expect : expect - window.counts;
+            if (error > worst)
+                worst = error;
+            if (window.events != edges - 1 - open_edge)
+                lost++;
+            measured = (double)window.events * FREQ_TIMER_CLK / window.counts;
+            counts = window.counts;
+            open_edge = edges - 1;
+            open_time = edge_time;
+            windows++;
+        }
+    }
+    seconds = (double)(HOST_time() - time) / HOST_PS;
+    printf("  %10.3f Hz  %12.4f Hz  %+9.1f ppm  %3u counts off  %6.0f interrupts/s  %4.1f %% CPU\n",
+           hz, measured, (measured / hz - 1) * 1e6, worst,
+           (HOST_stats.interrupts - interrupts) / seconds, 100.0 * (HOST_stats.isr - cpu) / (HOST_time() - time));
+    check(worst <= 1, "reciprocal result within 1 count of the window");
+    check(counts >= (uint32_t)GATE_MS * (FREQ_TIMER_CLK / 1000), "window at least the gate time");
+    check(lost == 0, "windows back to back, every period in one");
+    check(FREQ_missed() == 0, "no captures missed");
+}
+
+// reciprocal with every edge 2 counts before or after a TIMER_A0 roll
+// over while interrupts are off, as in another ISR or a critical section,
+// so the capture and the roll over are pending together
+static void roll_over(void)
+{
+    uint64_t count_ps = HOST_PS / FREQ_TIMER_CLK, edge_time, open_time = 0;
+    uint32_t windows = 0, worst = 0, error, expect, edges = 0;
+    uint8_t input = (FREQ_CCIS == TIMER_A_CCTLN_CCIS_1);
+    FREQ_Window window;
+    uint16_t count;
+
+    HOST_timer_input(0, FREQ_CCR, input, 0);
+    FREQ_init(FREQ_RECIPROCAL, 1, 1);
+
+    while (windows < RUN_WINDOWS) {
+        count = TIMER_A0->R;
+        edge_time = HOST_time() + (0x10000 - count) * count_ps;
+        edge_time += (edges & 1) ? 2 * count_ps : -2 * count_ps;
+        HOST_run(edge_time - 20 * count_ps - HOST_time());
+        __disable_irq();
+        HOST_run(edge_time - HOST_time());
+        edge_time = HOST_time();
+        HOST_timer_input(0, FREQ_CCR, input, 1);
+        HOST_run(10 * count_ps);
+        HOST_timer_input(0, FREQ_CCR, input, 0);
+        HOST_run(10 * count_ps);
+        __enable_irq();
+        HOST_run(1000 * count_ps);          // ISR, past the roll over
+        // every edge after the first closes a window of one period
+        if (edges++ > 0) {
+            if (FREQ_read_window(&window) && (window.events == 1)) {
+                expect = (uint32_t)((double)(edge_time - open_time) * FREQ_TIMER_CLK / HOST_PS + 0.5);
+                error = (window.counts > expect) ? window.counts - expect : expect - window.counts;
+            }
+            else
+                error = 0x10000;
+            if (error > worst)
+                worst = error;
+            windows++;
+        }
+        open_time = edge_time;
+    }
+    printf("  edges 2 counts from the roll over: %u counts off\n", worst);
+    check(worst <= 1, "captures next to a roll over in the right 65536 counts");
+}
+
+// FREQ_init and FREQ_read_window with a result waiting, interrupts off
+static void primask(void)
+{
+    uint8_t input = (FREQ_CCIS == TIMER_A_CCTLN_CCIS_1);
+    FREQ_Window window;
+    uint8_t edge;
+
+    __disable_irq();
+    FREQ_init(FREQ_RECIPROCAL, 1, 1);
+    check(__get_PRIMASK() == 1, "FREQ_init leaves interrupts off");
+    __enable_irq();
+    FREQ_init(FREQ_RECIPROCAL, 1, 1);
+    check(__get_PRIMASK() == 0, "FREQ_init leaves interrupts on");
+
+    for (edge = 0; edge < 2; edge++) {
+        HOST_timer_input(0, FREQ_CCR, input, 1);
+        HOST_run(HOST_PS / 1000);
+        HOST_timer_input(0, FREQ_CCR, input, 0);
+        HOST_run(HOST_PS / 1000);
+    }
+    __disable_irq();
+    check(FREQ_read_window(&window) && (__get_PRIMASK() == 1), "FREQ_read_window leaves interrupts off");
+    __enable_irq();
+}
+
+// gated: count edges on TA1CLK, fed every 10 us for the time that passed
+static void gated(double hz)
+{
+    uint64_t step = 10 * (HOST_PS / 1000000), time, fed, interrupts;
+    uint32_t windows = 0, worst = 0, error, expect;
+    uint32_t edges, total = 0;
+    FREQ_Window window;
+    double measured = 0, seconds;
+
+    FREQ_init(FREQ_GATED, GATE_MS, 1);
+    time = fed = HOST_time();
+    interrupts = HOST_stats.interrupts;
+
+    while (windows < RUN_WINDOWS) {
+        HOST_run(step);
+        edges = (uint32_t)(hz * (HOST_time() - time) / HOST_PS) - total;
+        total += edges;
+        HOST_timer_clock(1, edges);
+        fed = HOST_time();
+
+        if (FREQ_read_window(&window)) {
+            expect = (uint32_t)(hz * window.counts / FREQ_TIMER_CLK + 0.5);
+            error = (window.events > expect) ? window.events - expect : expect - window.events;
+            if (error > worst)
+                worst = error;
+            measured = (double)window.events * FREQ_TIMER_CLK / window.counts;
+            windows++;
+        }
+    }
+    seconds = (double)(fed - time) / HOST_PS;
+    printf("  %10.0f Hz  %12.1f Hz  %+9.1f ppm  %3u edges off   %6.0f interrupts/s\n",
+           hz, measured, (measured / hz - 1) * 1e6, worst, (HOST_stats.interrupts - interrupts) / seconds);
+    // edges come in 10 us lumps, so a gate can be off by one lump
+    check(worst <= 1 + (uint32_t)(hz * step / HOST_PS), "gated result within 1 edge per gate");
+}
+
+int main(void)
+{
+    static const double reciprocal_hz[] = { 1.0, 9.0, 45.7, 1000.0, 12345.678, 20000.0 };
+    static const double gated_hz[] = { 100000, 1000000, 4500000 };
+    uint8_t index;
+
+    set_clock();
+    primask();
+
+    printf("FREQ_RECIPROCAL, CCR%u, %u Hz timer, gate %u ms:\n", FREQ_CCR, FREQ_TIMER_CLK, GATE_MS);
+    for (index = 0; index < sizeof(reciprocal_hz) / sizeof(reciprocal_hz[0]); index++)
+        reciprocal(reciprocal_hz[index], 1);
+    reciprocal(9.0, 4);                     // Comp_Freq MIN_EDGES
+    roll_over();
+
+    printf("FREQ_GATED, TA1CLK, gate %u ms:\n", GATE_MS);
+    for (index = 0; index < sizeof(gated_hz) / sizeof(gated_hz[0]); index++)
+        gated(gated_hz[index]);
+
+    check(__get_PRIMASK() == 0, "interrupts still on");
+    return failed;
+}
+
+#endif
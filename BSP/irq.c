@@ -0,0 +1,126 @@
+// Vector table in SRAM and thunks that pass a context to the handler
+
+#include "msp.h"
+#include "irq.h"
+
+#define IRQ_VALID(irqn) (((irqn) >= 0) && ((irqn) < IRQ_COUNT))
+
+#if defined(__arm__) || defined(__TI_ARM__)
+
+#define EXCEPTIONS      16              // core vectors before IRQ 0
+#define VECTORS         (EXCEPTIONS + IRQ_COUNT)
+#define SRAM_DATA       0x20000000      // SRAM on the system bus (.bss)
+#define SRAM_CODE       0x01000000      // same SRAM on the code bus
+#define THUMB           1               // bit 0 of every code address
+
+typedef struct {
+    uint16_t code[4];
+    void* ctx;                          // loaded into r0
+    IRQ_handler handler;                // loaded into pc
+} IRQ_thunk;
+
+// ldr r0, [pc, #4] ; ldr.w pc, [pc, #8] ; nop (never run, keeps ctx
+// word aligned)
+static const uint16_t thunk_code[4] = { 0x4801, 0xF8DF, 0xF008, 0xBF00 };
+
+// VTOR needs the table aligned to its size rounded up to a power of 2
+#pragma DATA_ALIGN(vectors, 256)
+static volatile uint32_t vectors[VECTORS];
+
+static IRQ_thunk thunks[IRQ_COUNT][2];
+static uint8_t initialized = 0;
+
+// Function to give the vector for a thunk, its code bus address
+static uint32_t thunk_vector(IRQ_thunk* thunk)
+{
+    return (uint32_t)thunk - SRAM_DATA + SRAM_CODE + THUMB;
+}
+
+// Function to copy the vector table in use to SRAM and switch to it.
+// Only the first call does anything, VTOR moved back to another table
+// later is left there and the SRAM table keeps its vectors.
+void IRQ_init(void)
+{
+    const uint32_t* table = (const uint32_t*)SCB->VTOR;
+    uint16_t index;
+
+    if (initialized)
+        return;
+    initialized = 1;
+
+    for (index = 0; index < VECTORS; index++)
+        vectors[index] = table[index];
+
+    __DSB();                            // copy done before the switch
+    SCB->VTOR = (uint32_t)vectors;
+    __DSB();
+    __ISB();
+}
+
+// Function to put isr straight in the vector for irqn. Returns 0 if irqn
+// is not a device interrupt.
+uint8_t IRQ_vector(IRQn_Type irqn, void (*isr)(void))
+{
+    if (!IRQ_VALID(irqn))
+        return 0;
+
+    IRQ_init();
+    vectors[EXCEPTIONS + irqn] = (uint32_t)isr;
+    __DSB();
+    return 1;
+}
+
+// Function to have handler(ctx) run for irqn. The thunk not in the
+// vector is filled, then the vector moved to it in one write. Returns 0
+// if irqn is not a device interrupt.
+uint8_t IRQ_register(IRQn_Type irqn, IRQ_handler handler, void* ctx)
+{
+    IRQ_thunk* thunk;
+    uint8_t index;
+
+    if (!IRQ_VALID(irqn))
+        return 0;
+
+    thunk = &thunks[irqn][0];
+    IRQ_init();
+    if (vectors[EXCEPTIONS + irqn] == thunk_vector(thunk))
+        thunk = &thunks[irqn][1];
+
+    for (index = 0; index < 4; index++)
+        thunk->code[index] = thunk_code[index];
+    thunk->ctx = ctx;
+    thunk->handler = handler;
+
+    __DSB();                            // thunk in SRAM before it is used
+    vectors[EXCEPTIONS + irqn] = thunk_vector(thunk);
+    __DSB();
+    __ISB();
+    return 1;
+}
+
+#else
+// PC build, the model in Host/ runs the handlers
+
+void IRQ_init(void)
+{
+}
+
+uint8_t IRQ_vector(IRQn_Type irqn, void (*isr)(void))
+{
+    if (!IRQ_VALID(irqn))
+        return 0;
+
+    HOST_vector(irqn, isr);
+    return 1;
+}
+
+uint8_t IRQ_register(IRQn_Type irqn, IRQ_handler handler, void* ctx)
+{
+    if (!IRQ_VALID(irqn))
+        return 0;
+
+    HOST_register(irqn, handler, ctx);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * irq.h
+ *
+ *  Vector table in SRAM with handlers set at run time
+ *
+ *  The vector table in startup_msp432p401r_ccs.c is fixed when the program
+ *  is linked, one handler name for each interrupt, so a driver for
+ *  EUSCI_A0 - A3 or TIMER_A0 - A3 needs a handler for each instance.
+ *  IRQ_init copies the table to SRAM and points SCB->VTOR at the copy,
+ *  after which a vector can be changed while the program runs:
+ *
+ *      static void uart_isr(void* ctx)
+ *      {
+ *          EUSCI_A_Type* uart = ctx;
+ *          ...
+ *      }
+ *
+ *      IRQ_register(EUSCIA0_IRQn, uart_isr, EUSCI_A0);
+ *      IRQ_register(EUSCIA2_IRQn, uart_isr, EUSCI_A2);
+ *
+ *  The vector of a registered interrupt points at a 16 byte thunk in SRAM
+ *  (run through the code bus alias like RAMFUNC) that is only
+ *
+ *      ldr     r0, [pc, #4]        ctx
+ *      ldr.w   pc, [pc, #8]        handler
+ *
+ *  so the handler is a plain C function and gets ctx as its argument with
+ *  no table lookup on the way in, 2 loads more than a handler in the
+ *  vector itself. IRQ_vector puts a void (*)(void) handler straight in the
+ *  vector with no thunk.
+ *
+ *  Each interrupt has 2 thunks. IRQ_register fills the one that is not in
+ *  the vector and then changes the vector with one word write, so an
+ *  interrupt taken at any time runs either the old handler and ctx or the
+ *  new ones, never a mix. Register an interrupt from one place at a time
+ *  (main or a task), not from an ISR that can preempt that same interrupt.
+ *
+ *  IRQ_register and IRQ_vector return 0 and change nothing for an irqn
+ *  that is not a device interrupt (SysTick and the other core exceptions
+ *  are below 0). IRQ_init copies the table once, the first time it is
+ *  called. A program that moves VTOR back to the flash table afterwards
+ *  (ExecutionTiming) keeps the SRAM table and its vectors as they are.
+ *
+ *  The table and thunks take 228 + 1312 bytes of SRAM. Enable the
+ *  interrupt in the NVIC as usual, IRQ_register does not change it. On a
+ *  PC build irq.c hands the handlers to the model in Host/.
+ */
+
+#ifndef IRQ_H_
+#define IRQ_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+#define IRQ_COUNT   (PORT6_IRQn + 1)    // device interrupts in the table
+
+typedef void (*IRQ_handler)(void* ctx);
+
+void IRQ_init(void);
+uint8_t IRQ_vector(IRQn_Type irqn, void (*isr)(void));
+uint8_t IRQ_register(IRQn_Type irqn, IRQ_handler handler, void* ctx);
+
+#endif /* IRQ_H_ */
@@ -0,0 +1,139 @@
+// Non-blocking integer-only printf to the UART TX ring buffer
+
+#include <stdarg.h>
+#include "logger.h"
+#include "uart.h"
+
+static volatile uint32_t dropped_lines = 0;
+
+// Function to write an unsigned number in base 10 or 16 into the line
+// buffer right justified in width characters. Returns characters written.
+static uint16_t format_number(char* out, uint16_t space, uint32_t value,
+                              uint8_t base, uint8_t upper, uint8_t negative,
+                              uint8_t width, char pad)
+{
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char reverse[11];
+    uint8_t count = 0;
+    uint16_t length = 0;
+
+    do {                                    // digits are found lowest first
+        reverse[count++] = digits[value % base];
+        value /= base;
+    } while (value);
+
+    if (negative && (pad == '0') && (length < space)) {
+        out[length++] = '-';                // sign goes before zero padding
+        if (width) width--;
+        negative = 0;
+    }
+
+    while ((width > count + negative) && (length < space)) {
+        out[length++] = pad;
+        width--;
+    }
+
+    if (negative && (length < space))
+        out[length++] = '-';
+
+    while (count && (length < space))
+        out[length++] = reverse[--count];
+
+    return length;
+}
+
+// Function to reset the drop counter, the UART must already be initialized
+void LOG_init(void)
+{
+    dropped_lines = 0;
+}
+
+// Function to format and queue a line of text for the UART. Never waits for
+// the UART. Returns the number of characters queued, 0 if the line was dropped.
+uint16_t LOG_printf(const char* format, ...)
+{
+    char line[LOG_LINE_SIZE];
+    uint16_t length = 0;
+    uint8_t width, is_long;
+    char pad;
+    const char* text;
+    int32_t number;
+    va_list args;
+
+    va_start(args, format);
+
+    while (*format && (length < LOG_LINE_SIZE)) {
+        if (*format != '%') {
+            line[length++] = *format++;
+            continue;
+        }
+
+        format++;                           // skip %
+        pad = ' ';
+        width = 0;
+        is_long = 0;
+
+        if (*format == '0') {               // zero padding
+            pad = '0';
+            format++;
+        }
+        while ((*format >= '0') && (*format <= '9'))
+            width = width * 10 + (*format++ - '0');
+        if (*format == 'l') {               // long is the same size as int
+            is_long = 1;
+            format++;
+        }
+
+        switch (*format) {
+            case 'd':
+            case 'i':
+                number = is_long ? va_arg(args, long) : va_arg(args, int);
+                length += format_number(&line[length], LOG_LINE_SIZE - length,
+                        (number < 0) ? -(uint32_t)number : (uint32_t)number,
+                        10, 0, number < 0, width, pad);
+                break;
+            case 'u':
+                length += format_number(&line[length], LOG_LINE_SIZE - length,
+                        is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int),
+                        10, 0, 0, width, pad);
+                break;
+            case 'x':
+            case 'X':
+                length += format_number(&line[length], LOG_LINE_SIZE - length,
+                        is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int),
+                        16, *format == 'X', 0, width, pad);
+                break;
+            case 'c':
+                line[length++] = (char)va_arg(args, int);
+                break;
+            case 's':
+                text = va_arg(args, const char*);
+                while (*text && (length < LOG_LINE_SIZE))
+                    line[length++] = *text++;
+                break;
+            case '%':
+                line[length++] = '%';
+                break;
+            default:                        // unknown or end of string
+                format--;
+                break;
+        }
+        format++;
+    }
+
+    va_end(args);
+
+    // queue the whole line or nothing so lines are never cut in half
+    if (UART_tx_free() < length) {
+        dropped_lines++;
+        return 0;
+    }
+
+    return UART_write(line, length);
+}
+
+// Number of lines dropped because the UART TX buffer was full
+uint32_t LOG_dropped(void)
+{
+    return dropped_lines;
+}
@@ -0,0 +1,26 @@
+/*
+ * logger.h
+ *
+ *  Non-blocking formatted output to the UART (backchannel COM port)
+ *
+ *  LOG_printf() formats into a small line buffer and queues it with
+ *  UART_write(), which returns immediately. The UART TX interrupt sends
+ *  the characters in the background. If the TX buffer does not have room
+ *  for the whole line, the line is dropped and counted instead of waiting.
+ *
+ *  Only integer formats are supported:
+ *      %d %i %u %x %X %c %s %%  with optional 0 flag, width and l modifier
+ */
+
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include <stdint.h>
+
+#define LOG_LINE_SIZE 80    // longest formatted line
+
+void LOG_init(void);
+uint16_t LOG_printf(const char* format, ...);
+uint32_t LOG_dropped(void);
+
+#endif /* LOGGER_H_ */
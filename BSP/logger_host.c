@@ -0,0 +1,174 @@
+// PC test of logger.c with uart.c against the eUSCI_A and Timer_A models
+// in Host/
+//
+//     gcc -O2 -I../Host logger_host.c logger.c uart.c ../Host/msp_host.c -lm -o logger
+//
+// Checks each format against the expected text, that a line longer than
+// LOG_LINE_SIZE is cut at the buffer, and that a line that does not fit in
+// the TX ring is dropped whole and counted. Then logs as fast as main can
+// while a 20 kHz TA0 interrupt stands in for the sample stream: every
+// period must be serviced, so no sample is lost to the logging. Prints the
+// CPU cycles per LOG_printf call and per byte sent (register accesses,
+// TX ISR entry and exit; the formatting C is not in the model) and the
+// host time of the formatting. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "msp.h"
+#include "uart.h"
+#include "logger.h"
+
+#define SAMPLE_RATE 20000
+#define LOG_TIME    (HOST_PS / 10)      // 100 ms of logging
+#define LINE        "line %02u 0123456789 0123456789\n"
+#define LINE_LENGTH 30
+#define FORMAT_CYCLES 1000              // formatting one line, not modelled
+
+static char sent[8192];
+static uint16_t sent_count;
+static volatile uint32_t samples;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void uart_tx(uint8_t uart, uint8_t byte)
+{
+    if (sent_count < sizeof(sent))
+        sent[sent_count++] = byte;
+}
+
+static void wait_idle(void)
+{
+    while (!UART_tx_idle())
+        HOST_run(10 * HOST_PS / 1000000);
+}
+
+// CPU busy and ISR time in MCLK cycles since the last call
+static uint64_t cpu_cycles(void)
+{
+    static uint64_t last;
+    uint64_t ps = HOST_stats.busy + HOST_stats.isr, cycles;
+
+    cycles = (ps - last) * HOST_mclk() / HOST_PS;
+    last = ps;
+    return cycles;
+}
+
+static void expect(const char* want, const char* what)
+{
+    uint8_t ok;
+
+    wait_idle();
+    ok = (sent_count == strlen(want)) && !memcmp(sent, want, sent_count);
+    check(ok, what);
+    if (!ok)
+        printf("     got \"%.*s\"\n", sent_count, sent);
+    sent_count = 0;
+}
+
+// the sample stream: one interrupt per sample period
+void TA0_0_IRQHandler(void)
+{
+    TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+    samples++;
+}
+
+int main(void)
+{
+    char longer[LOG_LINE_SIZE + 20];
+    struct timespec start, end;
+    uint64_t begin, call_cycles, lines, bytes, periods;
+    uint32_t dropped;
+    uint16_t count;
+
+    HOST_uart_tx = uart_tx;
+    UART_init();
+    LOG_init();
+    __enable_irq();
+
+    LOG_printf("%d %i %u %x %X %c %s %%\n", -42, 7, 40000u, 0xbeef, 0xbeef, 'k', "ok");
+    expect("-42 7 40000 beef BEEF k ok %\n", "basic formats");
+    LOG_printf("[%5d] [%05d] [%05d] [%3u]\n", 42, 42, -42, 9);
+    expect("[   42] [00042] [-0042] [  9]\n", "width and zero padding");
+    LOG_printf("%ld %lu %08lX\n", (long)INT32_MIN, 4294967295ul, 0x1234abcdul);
+    expect("-2147483648 4294967295 1234ABCD\n", "long formats");
+
+    memset(longer, 'a', sizeof(longer) - 1);
+    longer[sizeof(longer) - 1] = 0;
+    count = LOG_printf("%s", longer);
+    check(count == LOG_LINE_SIZE, "long line cut at LOG_LINE_SIZE");
+    sent_count = 0;
+    wait_idle();
+    sent_count = 0;
+
+    // more than the TX ring holds: whole lines queued, the rest dropped
+    dropped = LOG_dropped();
+    for (count = 0; count < 20; count++)
+        LOG_printf(LINE, count);
+    wait_idle();
+    check(LOG_dropped() > dropped, "lines dropped when the ring is full");
+    check(sent_count % LINE_LENGTH == 0, "dropped lines are not cut in half");
+    check(sent_count / LINE_LENGTH + LOG_dropped() - dropped == 20, "every line sent or counted");
+    printf("burst of 20 lines: %u sent, %u dropped\n", sent_count / LINE_LENGTH,
+           LOG_dropped() - dropped);
+
+    // log flat out from main against a 20 kHz sample interrupt, the
+    // formatting time is charged with __delay_cycles
+    TIMER_A0->CCR[0] = HOST_smclk() / SAMPLE_RATE - 1;
+    TIMER_A0->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__UP | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA0_0_IRQn) & 31);
+
+    sent_count = 0;
+    samples = 0;
+    lines = 0;
+    dropped = LOG_dropped();
+    begin = HOST_time();
+    while (HOST_time() - begin < LOG_TIME) {
+        __delay_cycles(FORMAT_CYCLES);
+        LOG_printf("Average is %u\n", (unsigned)samples);
+        lines++;
+    }
+    TIMER_A0->CTL = 0;
+    periods = (HOST_time() - begin) * SAMPLE_RATE / HOST_PS;
+    wait_idle();
+
+    check((samples == periods) || (samples == periods + 1), "no sample periods lost while logging");
+    printf("%llu calls in 100 ms, %u dropped, %u samples in %llu periods\n",
+           (unsigned long long)lines, LOG_dropped() - dropped, samples,
+           (unsigned long long)periods);
+
+    // per call and per byte costs on an idle UART
+    cpu_cycles();
+    LOG_printf("Average is %u\n", 8292u);
+    call_cycles = cpu_cycles();
+    wait_idle();
+    bytes = cpu_cycles();
+    printf("LOG_printf %llu cycles per call, TX ISR %.1f cycles per byte\n",
+           (unsigned long long)call_cycles, (double)bytes / 15);
+    check(call_cycles < 200, "a call is a few register accesses");
+
+    // with the ring full every call formats and drops without a register
+    // access, so this is the formatting alone
+    while (UART_tx_free() >= LOG_LINE_SIZE)
+        UART_write(longer, LOG_LINE_SIZE);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (count = 0; count < 10000; count++)
+        LOG_printf("Overruns %lu  Dropped lines %lu\n", 3ul, (unsigned long)count);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    printf("formatting %.0f ns per call (host)\n",
+           ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / 10000);
+
+    return failed;
+}
+
+#endif
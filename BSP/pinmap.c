@@ -0,0 +1,43 @@
+// Pin setup from a const table with one 16-bit write per port register
+
+#include "msp.h"
+#include "pinmap.h"
+
+#define PAIRS   5               // PA - PE
+
+// PA - PE are 0x20 apart. The address is worked out from PA on every
+// access so a PC build goes through the model for each one.
+#define PIN_PAIR(pair)  ((DIO_PORT_Interruptable_Type*)((uintptr_t)PA + (pair) * 0x20))
+
+// Function to set every pin in the table. Register values for all pins
+// are built first and each port pair register is written once.
+void PIN_apply(const PIN_config* pins, uint16_t count)
+{
+    uint16_t used[PAIRS] = {0}, sel0[PAIRS] = {0}, sel1[PAIRS] = {0};
+    uint16_t dir[PAIRS] = {0}, ren[PAIRS] = {0}, out[PAIRS] = {0};
+    uint16_t bit;
+    uint8_t pair;
+
+    for (; count; count--, pins++) {
+        pair = (pins->port - 1) >> 1;
+        bit = 1 << (pins->pin + (((pins->port - 1) & 1) ? 8 : 0));  // even port is the high byte
+
+        used[pair] |= bit;
+        if (pins->mode & PIN_SEL0) sel0[pair] |= bit;
+        if (pins->mode & PIN_SEL1) sel1[pair] |= bit;
+        if (pins->mode & PIN_DIR)  dir[pair] |= bit;
+        if (pins->mode & PIN_REN)  ren[pair] |= bit;
+        if (pins->mode & PIN_HIGH) out[pair] |= bit;
+    }
+
+    for (pair = 0; pair < PAIRS; pair++) {
+        if (!used[pair])
+            continue;
+
+        PIN_PAIR(pair)->OUT = out[pair];   // level and pull direction first
+        PIN_PAIR(pair)->REN = ren[pair];
+        PIN_PAIR(pair)->DIR = dir[pair];
+        PIN_PAIR(pair)->SEL1 = sel1[pair];
+        PIN_PAIR(pair)->SEL0 = sel0[pair];
+    }
+}
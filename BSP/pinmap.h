@@ -0,0 +1,76 @@
+/*
+ * pinmap.h
+ *
+ *  Pin setup from one declarative list per project
+ *
+ *  Every pin a project uses is listed once as PIN(port, pin, mode) in an
+ *  X-macro and PIN_TABLE turns the list into a const table:
+ *
+ *      #define BOARD_PINS(PIN) \
+ *          PIN(1, 0, PIN_OUT_LOW)      \
+ *          PIN(1, 1, PIN_IN_PULLUP)
+ *
+ *      PIN_TABLE(board_pins, BOARD_PINS);
+ *      ...
+ *      PIN_apply(board_pins, PIN_COUNT(board_pins));
+ *
+ *  The list is checked when it compiles. Each entry declares an enum
+ *  constant PIN_P<port>_<pin>, so a pin listed twice (two functions on
+ *  one pin) is a redeclaration error. A port outside 1 - 10, a pin above
+ *  7 (above 5 on P10, the P401R has no P10.6 / P10.7) or a pull resistor
+ *  on an output makes an array of negative size.
+ *
+ *  PIN_apply builds every register value for each port pair (PA = P1/P2
+ *  ... PE = P9/P10) and writes it with one 16-bit store, OUT and REN
+ *  first so outputs and pulls are right before DIR and the function
+ *  select change. Pins of a written pair that are not in the list go to
+ *  their reset state (GPIO input), pairs with no pins are not touched.
+ *  It is meant for start up, before drivers set up their own pins.
+ */
+
+#ifndef PINMAP_H_
+#define PINMAP_H_
+
+#include <stdint.h>
+
+// mode bits
+#define PIN_SEL0        0x01
+#define PIN_SEL1        0x02
+#define PIN_DIR         0x04
+#define PIN_REN         0x08
+#define PIN_HIGH        0x10    // OUT = 1, pull up with PIN_REN
+
+// modes
+#define PIN_IN          0
+#define PIN_IN_PULLUP   (PIN_REN | PIN_HIGH)
+#define PIN_IN_PULLDOWN PIN_REN
+#define PIN_OUT_LOW     PIN_DIR
+#define PIN_OUT_HIGH    (PIN_DIR | PIN_HIGH)
+#define PIN_FUNC1       PIN_SEL0                // primary module function
+#define PIN_FUNC2       PIN_SEL1                // secondary module function
+#define PIN_FUNC3       (PIN_SEL0 | PIN_SEL1)   // tertiary module function
+#define PIN_FUNC1_OUT   (PIN_SEL0 | PIN_DIR)    // e.g. timer output, MCLK out
+
+typedef struct {
+    uint8_t port;               // 1 - 10
+    uint8_t pin;                // 0 - 7
+    uint8_t mode;
+} PIN_config;
+
+#define PIN_ENTRY_(port, pin, mode)     { (port), (pin), (mode) },
+#define PIN_UNIQUE_(port, pin, mode)    PIN_P##port##_##pin,
+#define PIN_VALID_(port, pin, mode) \
+    ((port) >= 1) && ((port) <= 10) && ((pin) <= 7) && \
+    (((port) != 10) || ((pin) <= 5)) && \
+    (((mode) & (PIN_DIR | PIN_REN)) != (PIN_DIR | PIN_REN)) &&
+
+#define PIN_TABLE(name, MAP) \
+    enum { MAP(PIN_UNIQUE_) name##_pins_ }; \
+    typedef char name##_valid_[(MAP(PIN_VALID_) 1) ? 1 : -1]; \
+    static const PIN_config name[] = { MAP(PIN_ENTRY_) }
+
+#define PIN_COUNT(name) (sizeof(name) / sizeof((name)[0]))
+
+void PIN_apply(const PIN_config* pins, uint16_t count);
+
+#endif /* PINMAP_H_ */
@@ -0,0 +1,93 @@
+// PC test of pinmap.c against the port model in Host/
+//
+//     gcc -O2 -I../Host pinmap_host.c pinmap.c ../Host/msp_host.c -lm -o pinmap
+//
+// A table with pins on both ports of PA, on P5 and on P10 is applied to
+// ports left in a mess, and every register of the ports in those pairs
+// must hold the table with the other pins of the pair back to GPIO input.
+// Pairs with no pins must not be touched. Outputs driven high and pull
+// ups must never be seen driving low on the way, so OUT has to be written
+// before DIR. PIN_VALID_, the compile time check of PIN_TABLE, is also
+// run as an expression for the P10 range and the other rules. Exits with
+// 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include "msp.h"
+#include "pinmap.h"
+
+#define TEST_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      \
+    PIN(1, 1, PIN_IN_PULLUP)    \
+    PIN(1, 2, PIN_FUNC1)        \
+    PIN(2, 0, PIN_OUT_HIGH)     \
+    PIN(2, 4, PIN_FUNC1_OUT)    \
+    PIN(5, 6, PIN_IN_PULLDOWN)  \
+    PIN(10, 5, PIN_FUNC3)
+
+PIN_TABLE(test_pins, TEST_PINS);
+
+#define VALID(port, pin, mode)  (PIN_VALID_(port, pin, mode) 1)
+
+static uint8_t glitch;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+// P2.0 is set up high, it must never be an output driving low
+static void port_out(uint8_t port, uint8_t out, uint8_t dir)
+{
+    if ((port == 2) && (dir & BIT0) && !(out & BIT0))
+        glitch = 1;
+}
+
+static void mess(DIO_PORT_Interruptable_Type* pair)
+{
+    pair->SEL0 = 0xA5A5;
+    pair->SEL1 = 0x0F0F;
+    pair->REN = 0x3C3C;
+    pair->OUT = 0x5A5A;
+}
+
+int main(void)
+{
+    mess(PA);
+    mess(PC);
+    mess(PD);
+    mess(PE);
+    PC->DIR = 0x00F0;
+    HOST_port_out = port_out;
+
+    PIN_apply(test_pins, PIN_COUNT(test_pins));
+
+    check((P1->SEL0 == (BIT2)) && (P1->SEL1 == 0) && (P1->DIR == BIT0) &&
+          (P1->REN == BIT1) && (P1->OUT == BIT1), "P1 registers from the table");
+    check((P2->SEL0 == BIT4) && (P2->SEL1 == 0) && (P2->DIR == (BIT0 | BIT4)) &&
+          (P2->REN == 0) && (P2->OUT == BIT0), "P2 registers from the table, high byte of PA");
+    check((P5->SEL0 == 0) && (P5->SEL1 == 0) && (P5->DIR == 0) &&
+          (P5->REN == BIT6) && (P5->OUT == 0), "P5 pull down, rest of P5 / P6 back to GPIO input");
+    check((P6->SEL0 == 0) && (P6->REN == 0) && (P6->DIR == 0), "P6 reset with its pair");
+    check((P10->SEL0 == BIT5) && (P10->SEL1 == BIT5) && (P10->DIR == 0) &&
+          (P9->SEL0 == 0) && (P9->SEL1 == 0), "P10.5 tertiary function, high byte of PE");
+    check((PD->SEL0 == 0xA5A5) && (PD->SEL1 == 0x0F0F) && (PD->REN == 0x3C3C) &&
+          (PD->OUT == 0x5A5A), "pair with no pins not touched");
+    check(!glitch, "P2.0 never driven low on the way to high");
+
+    check(VALID(10, 5, PIN_IN) && VALID(9, 7, PIN_IN) && VALID(1, 0, PIN_OUT_HIGH),
+          "P10.5, P9.7 and P1.0 accepted");
+    check(!VALID(10, 6, PIN_IN) && !VALID(10, 7, PIN_OUT_LOW), "P10.6 and P10.7 rejected");
+    check(!VALID(0, 0, PIN_IN) && !VALID(11, 0, PIN_IN) && !VALID(3, 8, PIN_IN),
+          "ports outside 1 - 10 and pins above 7 rejected");
+    check(!VALID(4, 1, PIN_OUT_LOW | PIN_REN), "pull resistor on an output rejected");
+
+    return failed;
+}
+
+#endif
@@ -0,0 +1,282 @@
+// PWM with period latched duty changes and fades for all Timer_A
+//
+// PWM_set_duty / PWM_fade -> store new duty, enable TAx CCR0 interrupt
+// TAx CCR0 (end of period) -> step fades, write new CCRn values
+// nothing left to latch    -> disable TAx CCR0 interrupt
+// CLOCK_set_profile          -> dividers and CCRs set again for SMCLK
+
+#include "msp.h"
+#include "pwm.h"
+#include "clock.h"
+#include "irq.h"
+
+// TIMER_A0 - A3 are 0x400 apart, TAx_0 interrupts 2 apart. The address
+// is worked out from TIMER_A0 on every access so a PC build goes through
+// the model for each one.
+#define PWM_TA(timer)   ((Timer_A_Type*)((uintptr_t)TIMER_A0 + (timer) * 0x400))
+#define PWM_IRQ(timer)  ((IRQn_Type)(TA0_0_IRQn + 2 * (timer)))
+
+#define DUTY_SHIFT  15          // duty held as Q16.15 so a fade step fits int32
+#define MAX_DIVIDER 64          // ID /8 * IDEX /8
+#define MAX_COUNTS  0xFFFF      // CCR0 + 1, full duty is CCR0 + 1 too
+
+typedef struct {
+    int32_t duty;               // current duty << DUTY_SHIFT
+    int32_t step;               // added each period while fading
+    uint32_t periods;           // fade periods left
+    uint16_t target;            // duty at the end of the fade
+    uint8_t pending;            // latch the duty at the end of the period
+    uint8_t on;                 // output in reset/set, not held low
+} PWM_Channel;
+
+static PWM_Channel channels[PWM_TIMERS][PWM_CHANNELS];
+static uint32_t period_counts[PWM_TIMERS];  // CCR0 + 1
+static uint32_t timer_clk[PWM_TIMERS];      // SMCLK after the dividers
+static uint32_t timer_freq[PWM_TIMERS];     // asked for in PWM_init
+static uint8_t running = 0;                 // bit per timer started
+
+static void PWM_isr(void* ctx);
+
+// Function to get the CCRn value for a duty. 0 is held low by the caller
+// and CCR0 + 1 never matches so the output stays high.
+static uint16_t PWM_ccr(uint8_t timer, uint16_t duty)
+{
+    if (duty == PWM_FULL)
+        return period_counts[timer];
+
+    return ((uint32_t)duty * period_counts[timer] + 0x8000) >> 16;
+}
+
+// Function to write a channel duty to its CCR. Called at the start of a
+// period, TAR may already be past the new CCRn so that reset is done here.
+static void PWM_latch(uint8_t timer, uint8_t channel)
+{
+    PWM_Channel* pwm = &channels[timer][channel];
+    uint8_t ccr = channel + 1;
+    uint16_t value, count;
+
+    value = PWM_ccr(timer, pwm->duty >> DUTY_SHIFT);
+
+    if (value == 0) {
+        PWM_TA(timer)->CCTL[ccr] = TIMER_A_CCTLN_OUTMOD_0;     // hold low
+        pwm->on = 0;
+        return;
+    }
+
+    PWM_TA(timer)->CCR[ccr] = value;
+
+    if (!pwm->on) {
+        // output set like the period started in reset/set mode
+        PWM_TA(timer)->CCTL[ccr] = TIMER_A_CCTLN_OUTMOD_0 | TIMER_A_CCTLN_OUT;
+        PWM_TA(timer)->CCTL[ccr] = TIMER_A_CCTLN_OUTMOD_7;
+        pwm->on = 1;
+    }
+
+    count = PWM_TA(timer)->R;
+    if ((count >= value) && (count != PWM_TA(timer)->CCR[0])) {
+        // new reset point already passed in this period
+        PWM_TA(timer)->CCTL[ccr] = TIMER_A_CCTLN_OUTMOD_0;
+        PWM_TA(timer)->CCTL[ccr] = TIMER_A_CCTLN_OUTMOD_7;
+    }
+}
+
+// Function to turn on the CCR0 interrupt. A flag left from an earlier
+// period is cleared so the latch waits for the next period boundary.
+static void PWM_request(uint8_t timer)
+{
+    if (!(PWM_TA(timer)->CCTL[0] & TIMER_A_CCTLN_CCIE)) {
+        PWM_TA(timer)->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+        PWM_TA(timer)->CCTL[0] |= TIMER_A_CCTLN_CCIE;
+    }
+}
+
+// Function to set the dividers and CCR0 of a timer for its frequency
+// from smclk and restart it, duties are written again for the new period.
+// Called with interrupts off.
+static void PWM_setup(uint8_t timer, uint32_t smclk)
+{
+    static const uint16_t id_bits[4] = {
+        TIMER_A_CTL_ID__1, TIMER_A_CTL_ID__2,
+        TIMER_A_CTL_ID__4, TIMER_A_CTL_ID__8
+    };
+    uint32_t divider = 1, counts, freq = timer_freq[timer];
+    uint8_t id = 0, channel, ccie;
+
+    // smallest divider that fits the period in 16 bits
+    while ((smclk / divider / freq > MAX_COUNTS) && (divider < MAX_DIVIDER))
+        divider <<= 1;
+
+    counts = smclk / divider / freq;
+    if (counts > MAX_COUNTS)
+        counts = MAX_COUNTS;
+    if (counts < 2)
+        counts = 2;
+
+    ccie = PWM_TA(timer)->CCTL[0] & TIMER_A_CCTLN_CCIE;     // fades go on
+    PWM_TA(timer)->CTL = TIMER_A_CTL_CLR;       // stop and clear TAR
+    PWM_TA(timer)->CCTL[0] = 0;
+
+    timer_clk[timer] = smclk / divider;
+    period_counts[timer] = counts;
+    PWM_TA(timer)->CCR[0] = counts - 1;
+
+    while ((1u << id) < divider && id < 3)
+        id++;
+    PWM_TA(timer)->EX0 = (divider >> id) - 1;   // IDEX /1 - /8
+
+    for (channel = 0; channel < PWM_CHANNELS; channel++) {
+        channels[timer][channel].on = 0;
+        PWM_latch(timer, channel);
+    }
+
+    PWM_TA(timer)->CCTL[0] = ccie;
+    PWM_TA(timer)->CTL = TIMER_A_CTL_SSEL__SMCLK
+                       | id_bits[id]
+                       | TIMER_A_CTL_MC__UP
+                       | TIMER_A_CTL_CLR;
+}
+
+// CLOCK_set_profile notify - the running timers get dividers for the new
+// SMCLK. The period in between runs at the new SMCLK on the old dividers.
+static void PWM_clock(uint8_t event, uint32_t mclk, uint32_t smclk)
+{
+    uint32_t primask;
+    uint8_t timer;
+
+    (void)mclk;
+    if (event != CLOCK_AFTER)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (timer = 0; timer < PWM_TIMERS; timer++)
+        if (running & (1 << timer))
+            PWM_setup(timer, smclk);
+    __set_PRIMASK(primask);
+}
+
+// Function to start a timer in up mode at the closest frequency it can
+// make from SMCLK. Duties already set are kept, fades end at the current
+// duty. The TAx_0 interrupt of the timer is registered and enabled.
+void PWM_init(uint8_t timer, uint32_t freq)
+{
+    uint32_t primask;
+    uint8_t channel;
+
+    if (timer >= PWM_TIMERS)
+        return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!running)
+        CLOCK_register(PWM_clock);
+    running |= 1 << timer;
+    timer_freq[timer] = (freq == 0) ? 1 : freq;
+
+    for (channel = 0; channel < PWM_CHANNELS; channel++) {
+        channels[timer][channel].periods = 0;
+        channels[timer][channel].pending = 0;
+    }
+    PWM_TA(timer)->CCTL[0] = 0;
+    PWM_setup(timer, CLOCK_smclk());
+
+    IRQ_register(PWM_IRQ(timer), PWM_isr, (void*)(uintptr_t)timer);
+    NVIC->ISER[0] = (1 << (PWM_IRQ(timer) & 31));
+
+    __set_PRIMASK(primask);
+}
+
+// Function to set a channel duty from the next period on
+void PWM_set_duty(uint8_t timer, uint8_t channel, uint16_t duty)
+{
+    PWM_Channel* pwm = &channels[timer][channel - 1];
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pwm->periods = 0;
+    pwm->target = duty;
+    pwm->duty = (int32_t)duty << DUTY_SHIFT;
+    pwm->pending = 1;
+    PWM_request(timer);
+    __set_PRIMASK(primask);
+}
+
+// Function to move a channel duty in a straight line from its current
+// duty to a new one over time_ms, a step at the end of each period
+void PWM_fade(uint8_t timer, uint8_t channel, uint16_t duty, uint16_t time_ms)
+{
+    PWM_Channel* pwm = &channels[timer][channel - 1];
+    uint32_t periods, primask;
+
+    periods = ((uint64_t)time_ms * timer_clk[timer])
+            / (1000 * period_counts[timer]);
+
+    if (periods == 0) {
+        PWM_set_duty(timer, channel, duty);
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pwm->target = duty;
+    pwm->step = (((int32_t)duty << DUTY_SHIFT) - pwm->duty) / (int32_t)periods;
+    pwm->periods = periods;
+    PWM_request(timer);
+    __set_PRIMASK(primask);
+}
+
+// Returns the duty a channel is at now, part way through a fade
+uint16_t PWM_get_duty(uint8_t timer, uint8_t channel)
+{
+    return channels[timer][channel - 1].duty >> DUTY_SHIFT;
+}
+
+// Returns 1 while any channel of the timer is fading
+uint8_t PWM_fading(uint8_t timer)
+{
+    uint8_t channel;
+
+    for (channel = 0; channel < PWM_CHANNELS; channel++)
+        if (channels[timer][channel].periods)
+            return 1;
+
+    return 0;
+}
+
+// Function for the end of a period - step fades and latch new duties
+static void PWM_period(uint8_t timer)
+{
+    PWM_Channel* pwm;
+    uint8_t channel, busy = 0;
+
+    PWM_TA(timer)->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+    for (channel = 0; channel < PWM_CHANNELS; channel++) {
+        pwm = &channels[timer][channel];
+
+        if (pwm->periods) {
+            if (--pwm->periods)
+                pwm->duty += pwm->step;
+            else
+                pwm->duty = (int32_t)pwm->target << DUTY_SHIFT;
+            pwm->pending = 1;
+            busy |= (pwm->periods != 0);
+        }
+
+        if (pwm->pending) {
+            pwm->pending = 0;
+            PWM_latch(timer, channel);
+        }
+    }
+
+    if (!busy)
+        PWM_TA(timer)->CCTL[0] &= ~TIMER_A_CCTLN_CCIE;  // steady, stop interrupts
+}
+
+// TAx_0 ISR registered by PWM_init, ctx is the timer
+static void PWM_isr(void* ctx)
+{
+    PWM_period((uint8_t)(uintptr_t)ctx);
+}
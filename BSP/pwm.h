@@ -0,0 +1,43 @@
+/*
+ * pwm.h
+ *
+ *  PWM on any Timer_A (0 - 3) and CCR (1 - 4) in up mode
+ *
+ *  CCR0 sets the period and each CCRn output runs reset/set (OUTMOD_7), so
+ *  the output is high from the start of the period until TAR reaches CCRn.
+ *  Duty is 16 bits, 0 is always low and PWM_FULL is always high.
+ *
+ *  Timer_A has no CCR shadow registers, so a CCRn written in the middle of
+ *  a period can skip its reset and give a whole high period. New duties are
+ *  only stored by PWM_set_duty and PWM_fade, the CCR0 interrupt at the end
+ *  of each period writes them to the CCRs. A fade moves the duty a step
+ *  per period in the same interrupt. The CCR0 interrupt is turned off when
+ *  there is nothing left to latch so a steady output costs no CPU time.
+ *
+ *  The timers run from SMCLK as CLOCK_smclk gives it. PWM_init registers
+ *  a CLOCK_notify the first time, so after CLOCK_set_profile each running
+ *  timer gets dividers and CCRs for the new SMCLK and keeps its frequency,
+ *  duties and fades. The period the change happens in is off.
+ *
+ *  PWM_init registers the TAx_0 interrupt of its timer with IRQ_register
+ *  and enables it, the TAx_0 vectors of other timers are left to the
+ *  program. Pins are set up by the caller. PWM_init, PWM_set_duty and
+ *  PWM_fade leave PRIMASK as it was.
+ */
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include <stdint.h>
+
+#define PWM_TIMERS      4
+#define PWM_CHANNELS    4           // CCR1 - CCR4
+#define PWM_FULL        0xFFFF      // 100% duty
+
+void PWM_init(uint8_t timer, uint32_t freq);
+void PWM_set_duty(uint8_t timer, uint8_t channel, uint16_t duty);
+void PWM_fade(uint8_t timer, uint8_t channel, uint16_t duty, uint16_t time_ms);
+uint16_t PWM_get_duty(uint8_t timer, uint8_t channel);
+uint8_t PWM_fading(uint8_t timer);
+
+#endif /* PWM_H_ */
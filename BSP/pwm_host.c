@@ -0,0 +1,294 @@
+// PC test of pwm.c against the Timer_A model in Host/
+//
+//     gcc -O2 -I../Host pwm_host.c pwm.c clock.c irq.c system_msp432p401r.c ../Host/msp_host.c
+//         -lm -o pwm
+//
+// Every edge of TA2.3 is timed from the model. Each cycle must be one
+// period long within a timer count and high for the duty within 2 counts,
+// 0 and PWM_FULL must hold the output low and high. Duties set at random
+// points of a period must show up whole from the next period on (the one
+// after if the call runs over the period boundary) with the period they
+// were set in left as it was, and a duty below the ISR latency must cut
+// that period short, never give a whole high period. A fade must step up
+// once per period and end on its target, and a steady output must take no
+// interrupts. After CLOCK_set_profile the period and duty must be the
+// same at the new SMCLK, also part way through a fade. PWM_init,
+// PWM_set_duty and PWM_fade must leave PRIMASK as it was, and
+// TA0_0_IRQHandler here must still run, PWM_init only takes the TAx_0
+// vector of its own timer. Prints the measured period and duty error,
+// the latency of a duty change and the interrupts of a steady output.
+// Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "msp.h"
+#include "pwm.h"
+#include "clock.h"
+
+#define TIMER       2               // TA2.3 as in PWM_Demo
+#define CHANNEL     3
+#define FREQ        1000
+#define PERIOD_PS   (HOST_PS / FREQ)
+#define LOG_SIZE    4096
+#define CALL_PS     (20 * (HOST_PS / 1000000))  // PWM_set_duty at 3 MHz
+
+typedef struct {
+    uint64_t rise;
+    uint64_t high;
+    uint64_t period;                // to the next rise
+} Cycle;
+
+static Cycle cycles[LOG_SIZE];
+static uint32_t cycle_count;
+static uint64_t rise_at, fall_at;
+static uint8_t level;
+static volatile uint32_t other_isr;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void output(uint8_t timer, uint8_t ccr, uint8_t out)
+{
+    uint64_t now = HOST_time();
+
+    if ((timer != TIMER) || (ccr != CHANNEL))
+        return;
+    level = out;
+    if (!out) {
+        fall_at = now;
+        return;
+    }
+    if (rise_at && (cycle_count < LOG_SIZE)) {
+        cycles[cycle_count].rise = rise_at;
+        cycles[cycle_count].high = fall_at - rise_at;
+        cycles[cycle_count++].period = now - rise_at;
+    }
+    rise_at = now;
+}
+
+// TIMER_A0 is not used by the PWM, its TAx_0 vector is the program's
+void TA0_0_IRQHandler(void)
+{
+    TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+    other_isr++;
+}
+
+static void run_ms(uint32_t ms)
+{
+    HOST_run((uint64_t)ms * (HOST_PS / 1000));
+}
+
+// ps per count of the PWM timer from its dividers
+static uint64_t count_ps(void)
+{
+    uint32_t id = (TIMER_A2->CTL & TIMER_A_CTL_ID_MASK) >> TIMER_A_CTL_ID_OFS;
+    uint32_t divider = (1 << id) * (TIMER_A2->EX0 + 1);
+
+    return HOST_PS * divider / HOST_smclk();
+}
+
+static uint64_t diff(uint64_t a, uint64_t b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+static uint64_t high_of(uint16_t duty)
+{
+    return (uint64_t)((double)duty * PERIOD_PS / 65536);
+}
+
+// runs ms and checks every whole cycle is one period high for duty
+static void steady(const char* what, uint16_t duty, uint32_t ms)
+{
+    uint64_t count = count_ps(), worst_period = 0, worst_high = 0;
+    uint32_t index;
+    char text[96];
+
+    cycle_count = 0;
+    run_ms(ms);
+    for (index = 1; index < cycle_count; index++) {
+        if (diff(cycles[index].period, PERIOD_PS) > worst_period)
+            worst_period = diff(cycles[index].period, PERIOD_PS);
+        if (diff(cycles[index].high, high_of(duty)) > worst_high)
+            worst_high = diff(cycles[index].high, high_of(duty));
+    }
+    printf("  %-28s %5.1f %% duty: %u cycles, period %+.3f us, high %+.3f us off worst (count %.3f us)\n",
+           what, duty * 100.0 / 65536, cycle_count, worst_period / 1e6, worst_high / 1e6, count / 1e6);
+    snprintf(text, sizeof(text), "%s: cycles of one period", what);
+    check((cycle_count >= ms * FREQ / 1000 - 2) && (worst_period <= count), text);
+    snprintf(text, sizeof(text), "%s: high for the duty", what);
+    check(worst_high <= 2 * count, text);
+}
+
+// duty a, then b set at a random point of a period, 4 periods later
+// the next change. The cycle b is set in must be a, every later one b.
+// A call that runs across the period boundary clears that CCR0 flag as
+// a stale one, the latch is then one period later.
+static void changes(uint16_t a, uint16_t b, uint16_t count, uint64_t* latency)
+{
+    uint64_t set_at, unit = count_ps();
+    uint32_t index, first;
+    uint16_t change;
+    uint8_t ok = 1;
+
+    for (change = 0; change < count; change++) {
+        PWM_set_duty(TIMER, CHANNEL, a);
+        HOST_run(3 * PERIOD_PS + rand() % PERIOD_PS);
+        cycle_count = 0;
+        set_at = HOST_time();
+        PWM_set_duty(TIMER, CHANNEL, b);
+        HOST_run(3 * PERIOD_PS);
+
+        // cycle 0 started before the change
+        first = 1;
+        if ((cycle_count > 1) && (cycles[1].rise - set_at < CALL_PS) &&
+            (diff(cycles[1].high, high_of(a)) <= 2 * unit))
+            first = 2;
+        ok &= (cycle_count >= 3) && (cycles[0].rise < set_at);
+        for (index = 0; index < cycle_count; index++) {
+            ok &= diff(cycles[index].period, PERIOD_PS) <= unit;
+            ok &= diff(cycles[index].high, high_of((index < first) ? a : b)) <= 2 * unit;
+        }
+        if (cycles[first - 1].rise + PERIOD_PS - set_at > *latency)
+            *latency = cycles[first - 1].rise + PERIOD_PS - set_at;
+    }
+    check(ok, "duty changes whole at the next period, the period it was set in kept");
+}
+
+int main(void)
+{
+    uint64_t latency = 0, set_at, unit, short_high;
+    uint32_t index, cycle, first, interrupts, fade_cycles;
+    uint8_t ok;
+
+    SystemInit();                           // 3 MHz DCO, SystemCoreClock
+    HOST_timer_output = output;
+    srand(1);
+
+    // another timer's TAx_0 interrupt, the PWM must leave its vector
+    TIMER_A0->CCR[0] = 3000 - 1;
+    TIMER_A0->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__UP | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA0_0_IRQn) & 31);
+
+    __disable_irq();
+    PWM_set_duty(TIMER, CHANNEL, 0x4000);
+    check(__get_PRIMASK() == 1, "PWM_set_duty leaves interrupts off");
+    PWM_init(TIMER, FREQ);
+    check(__get_PRIMASK() == 1, "PWM_init leaves interrupts off");
+    PWM_fade(TIMER, CHANNEL, 0x4000, 100);
+    check(__get_PRIMASK() == 1, "PWM_fade leaves interrupts off");
+    __enable_irq();
+    PWM_set_duty(TIMER, CHANNEL, 0x4000);
+    check(__get_PRIMASK() == 0, "PWM_set_duty leaves interrupts on");
+
+    printf("%u Hz on TA2.3, SMCLK %u Hz:\n", FREQ, HOST_smclk());
+    run_ms(5);
+    steady("25 %", 0x4000, 50);
+    other_isr = 0;
+    run_ms(10);
+    check(other_isr >= 9, "TA0_0_IRQHandler of the program still runs");
+    TIMER_A0->CTL = 0;
+
+    PWM_set_duty(TIMER, CHANNEL, 0xC000);
+    run_ms(3);
+    steady("75 %", 0xC000, 50);
+
+    PWM_set_duty(TIMER, CHANNEL, 0);
+    run_ms(3);
+    cycle_count = 0;
+    run_ms(20);
+    check((cycle_count == 0) && (level == 0), "duty 0 holds the output low");
+    PWM_set_duty(TIMER, CHANNEL, PWM_FULL);
+    run_ms(3);
+    cycle_count = 0;
+    run_ms(20);
+    check((cycle_count == 0) && (level == 1), "PWM_FULL holds the output high");
+    PWM_set_duty(TIMER, CHANNEL, 0x8000);
+    run_ms(3);
+    steady("50 % after PWM_FULL", 0x8000, 20);
+
+    // duty changes at random points of the period
+    changes(0x4000, 0xC000, 100, &latency);
+    changes(0xC000, 0x2000, 100, &latency);
+    printf("  200 changes, new duty from %.1f us after PWM_set_duty worst\n", latency / 1e6);
+
+    // a duty below what TAR has reached when the ISR latches it
+    unit = count_ps();
+    ok = 1;
+    short_high = 0;
+    for (index = 0; index < 50; index++) {
+        PWM_set_duty(TIMER, CHANNEL, 0xC000);
+        HOST_run(3 * PERIOD_PS + rand() % PERIOD_PS);
+        cycle_count = 0;
+        set_at = HOST_time();
+        PWM_set_duty(TIMER, CHANNEL, 64);   // CCRn 3, reset point passed
+        HOST_run(3 * PERIOD_PS);
+        ok &= cycle_count >= 3;
+        first = ((cycles[1].rise - set_at < CALL_PS) &&
+                 (diff(cycles[1].high, high_of(0xC000)) <= 2 * unit)) ? 2 : 1;
+        for (cycle = first; cycle < cycle_count; cycle++) {
+            ok &= diff(cycles[cycle].period, PERIOD_PS) <= unit;
+            ok &= cycles[cycle].high < PERIOD_PS / 50;
+            if (cycles[cycle].high > short_high)
+                short_high = cycles[cycle].high;
+        }
+    }
+    printf("  duty below the ISR latency: high %.1f us worst\n", short_high / 1e6);
+    check(ok, "duty set below TAR cuts the period short, no whole high period");
+
+    // fade 25 % -> 75 % over 100 ms, a step a period
+    PWM_set_duty(TIMER, CHANNEL, 0x4000);
+    run_ms(3);
+    cycle_count = 0;
+    PWM_fade(TIMER, CHANNEL, 0xC000, 100);
+    while (PWM_fading(TIMER))
+        run_ms(1);
+    run_ms(5);
+    fade_cycles = 0;
+    ok = 1;
+    for (index = 1; index < cycle_count; index++) {
+        ok &= cycles[index].high + unit >= cycles[index - 1].high;
+        if (cycles[index].high < high_of(0xC000) - 2 * unit)
+            fade_cycles++;
+    }
+    printf("  fade 25 -> 75 %% over 100 ms: %u cycles on the way\n", fade_cycles);
+    check(ok, "fade only steps up");
+    check((fade_cycles >= 98) && (fade_cycles <= 102), "fade takes 100 periods");
+    check(diff(cycles[cycle_count - 1].high, high_of(0xC000)) <= 2 * unit, "fade ends on the target");
+    check(PWM_get_duty(TIMER, CHANNEL) == 0xC000, "PWM_get_duty at the target");
+
+    interrupts = HOST_stats.interrupts;
+    run_ms(1000);
+    printf("  steady: %u interrupts in 1 s\n", HOST_stats.interrupts - interrupts);
+    check(HOST_stats.interrupts == interrupts, "steady output takes no interrupts");
+
+    // SMCLK 3 -> 12 MHz and back, once part way through a fade
+    check(CLOCK_set_profile(12000000), "12 MHz profile");
+    run_ms(3);
+    printf("SMCLK %u Hz after CLOCK_set_profile:\n", HOST_smclk());
+    steady("75 % at 12 MHz", 0xC000, 50);
+    PWM_fade(TIMER, CHANNEL, 0x4000, 100);
+    run_ms(50);
+    check(CLOCK_set_profile(48000000), "48 MHz profile");
+    run_ms(30);
+    check(CLOCK_set_profile(3000000), "3 MHz profile");
+    run_ms(30);
+    check(!PWM_fading(TIMER) && (PWM_get_duty(TIMER, CHANNEL) == 0x4000),
+          "fade goes on through profile changes and ends on time");
+    run_ms(3);
+    printf("SMCLK %u Hz:\n", HOST_smclk());
+    steady("25 % back at 3 MHz", 0x4000, 50);
+
+    return failed;
+}
+
+#endif
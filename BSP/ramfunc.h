@@ -0,0 +1,37 @@
+/*
+ * ramfunc.h
+ *
+ *  Run a function from SRAM instead of flash
+ *
+ *      RAMFUNC void TA0_N_IRQHandler(void)
+ *      {
+ *          ...
+ *      }
+ *
+ *  RAMFUNC puts the function in the .TI.ramfunc section. The CCS linker
+ *  command file for the MSP432P401R loads that section into flash and
+ *  runs it from SRAM_CODE (the SRAM code bus alias at 0x01000000) with
+ *  table(BINIT), so _c_int00 copies it to SRAM before main like .data.
+ *  Calls, function pointers and vector table entries get the SRAM
+ *  address.
+ *
+ *  From SRAM an instruction fetch has no flash wait states and does not
+ *  depend on the flash read buffer, so an ISR or a hot loop takes the same
+ *  cycles at every clock profile. Each RAMFUNC takes SRAM from the data,
+ *  so keep it to code that runs often: ISRs, filter loops, the FSM
+ *  dispatch. Flash buffering for the rest is set with CLOCK_flash_buffer
+ *  (clock.h).
+ *
+ *  Other compilers (the PC builds) leave the function in place.
+ */
+
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+#if defined(__TI_ARM__)
+#define RAMFUNC     __attribute__((ramfunc))
+#else
+#define RAMFUNC
+#endif
+
+#endif /* RAMFUNC_H_ */
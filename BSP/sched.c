@@ -0,0 +1,272 @@
+// Run to completion task scheduler with tickless idle
+//
+// SCHED_post (any ISR)  -> work queue
+// TIMER_A3 CCR0         -> wake for the first started timer
+// TIMER_A3 roll over    -> upper 16 bits of the tick count
+// SCHED_run (main)      -> due timers, then queued work, then sleep
+//
+// The work queue has one consumer (SCHED_run) and any number of
+// interrupts can post, so a slot is claimed with interrupts masked like
+// FSM_post.
+
+#include "msp.h"
+#include "sched.h"
+
+#define QUEUE_MASK  (SCHED_QUEUE_SIZE - 1)
+#define HALF_COUNT  0x8000
+#define MIN_SLEEP   2               // ticks, closer than this is not slept
+
+typedef struct {
+    SCHED_task task;
+    uint32_t data;
+} SCHED_work;
+
+static SCHED_timer* timers = 0;     // started timers, first due first
+
+static SCHED_work queue[SCHED_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;    // written by SCHED_post
+static volatile uint16_t queue_tail = 0;    // written by SCHED_run
+static volatile uint16_t dropped = 0;
+
+static volatile uint32_t overflow = 0;
+static uint32_t start_tick;
+static uint32_t idle_ticks = 0;
+static uint32_t wakeups = 0;
+static uint32_t max_late = 0;
+
+// Function to read the 32-bit tick count, call with interrupts masked.
+// TA3R is clocked by ACLK, not MCLK, so it is read until 2 reads match.
+static uint32_t SCHED_ticks(void)
+{
+    uint32_t high = overflow;
+    uint16_t count, check;
+
+    count = TIMER_A3->R;
+    do {
+        check = count;
+        count = TIMER_A3->R;
+    } while (count != check);
+
+    if ((TIMER_A3->CTL & TIMER_A_CTL_IFG) && (count < HALF_COUNT))
+        high++;                     // roll over not counted yet
+
+    return (high << 16) | count;
+}
+
+// Function to start TIMER_A3 counting ACLK
+void SCHED_init(void)
+{
+    timers = 0;
+    queue_head = queue_tail = 0;
+    overflow = 0;
+
+    TIMER_A3->CCTL[0] = 0;
+    TIMER_A3->CTL = TIMER_A_CTL_SSEL__ACLK      // 32768 Hz
+                  | TIMER_A_CTL_IE              // roll over extends ticks
+                  | TIMER_A_CTL_MC__CONTINUOUS
+                  | TIMER_A_CTL_CLR;
+
+    start_tick = 0;
+    idle_ticks = wakeups = max_late = 0;
+
+    NVIC->ISER[0] = (1 << (TA3_0_IRQn & 31));
+    NVIC->ISER[0] = (1 << (TA3_N_IRQn & 31));
+}
+
+// Returns the time in ticks since SCHED_init
+uint32_t SCHED_now(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t now;
+
+    __disable_irq();
+    now = SCHED_ticks();
+    __set_PRIMASK(primask);
+
+    return now;
+}
+
+// Function to put a timer in the started list in order of due time
+static void SCHED_insert(SCHED_timer* timer)
+{
+    SCHED_timer** link = &timers;
+
+    while (*link && ((int32_t)((*link)->due - timer->due) <= 0))
+        link = &(*link)->next;
+
+    timer->next = *link;
+    *link = timer;
+    timer->started = 1;
+}
+
+// Function to run a task after delay_ms, then every period_ms if it is
+// not 0. Starting a timer that is already started restarts it.
+void SCHED_start(SCHED_timer* timer, SCHED_task task, uint32_t data,
+                 uint32_t delay_ms, uint32_t period_ms)
+{
+    SCHED_stop(timer);
+
+    timer->task = task;
+    timer->data = data;
+    timer->period = SCHED_MS(period_ms);
+    timer->due = SCHED_now() + SCHED_MS(delay_ms);
+
+    SCHED_insert(timer);
+}
+
+// Function to take a timer out of the started list
+void SCHED_stop(SCHED_timer* timer)
+{
+    SCHED_timer** link = &timers;
+
+    if (!timer->started)
+        return;
+
+    while (*link && (*link != timer))
+        link = &(*link)->next;
+
+    if (*link)
+        *link = timer->next;
+
+    timer->started = 0;
+}
+
+// Function to queue a task to run from SCHED_run, safe to call from any
+// interrupt. Returns 0 if the queue is full and the work was dropped.
+uint8_t SCHED_post(SCHED_task task, uint32_t data)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint16_t head;
+
+    __disable_irq();
+
+    head = queue_head;
+    if (((head + 1) & QUEUE_MASK) == queue_tail) {  // queue full
+        dropped++;
+        __set_PRIMASK(primask);
+        return 0;
+    }
+
+    queue[head].task = task;
+    queue[head].data = data;
+    queue_head = (head + 1) & QUEUE_MASK;   // publish after it is written
+
+    __set_PRIMASK(primask);
+
+    return 1;
+}
+
+// Function to copy the run time counters. CPU load is
+// (elapsed - idle) / elapsed.
+void SCHED_get_stats(SCHED_stats* stats)
+{
+    stats->elapsed = SCHED_now() - start_tick;
+    stats->idle = idle_ticks;
+    stats->wakeups = wakeups;
+    stats->max_late = max_late;
+    stats->dropped = dropped;
+}
+
+// Function to run every timer that is due. A periodic timer is moved on
+// by whole periods so it does not drift, periods already missed are
+// skipped.
+static void SCHED_run_timers(void)
+{
+    SCHED_timer* timer;
+    uint32_t now = SCHED_now();
+
+    while (timers && ((int32_t)(timers->due - now) <= 0)) {
+        timer = timers;
+        timers = timer->next;
+        timer->started = 0;
+
+        if (now - timer->due > max_late)
+            max_late = now - timer->due;
+
+        if (timer->period) {
+            do {
+                timer->due += timer->period;
+            } while ((int32_t)(timer->due - now) <= 0);
+            SCHED_insert(timer);
+        }
+
+        timer->task(timer->data);           // may stop or restart the timer
+        now = SCHED_now();
+    }
+}
+
+// Function to run every queued work item, including ones posted while
+// running
+static void SCHED_run_queue(void)
+{
+    uint16_t tail = queue_tail;
+    SCHED_work work;
+
+    while (tail != queue_head) {
+        work = queue[tail];
+        tail = (tail + 1) & QUEUE_MASK;
+        queue_tail = tail;                  // release the slot
+        work.task(work.data);
+    }
+}
+
+// Function to sleep until the first timer is due or any interrupt. Work
+// and timers are checked with interrupts off so one arriving before
+// __sleep() still wakes the CPU.
+static void SCHED_idle(void)
+{
+    uint32_t now;
+    int32_t wait = 0x7FFFFFFF;
+
+    __disable_irq();
+
+    if (queue_tail == queue_head) {
+        now = SCHED_ticks();
+
+        if (timers) {
+            wait = timers->due - now;
+            if (wait < 0x10000) {           // else the roll over wakes first
+                TIMER_A3->CCR[0] = (uint16_t)timers->due;
+                TIMER_A3->CCTL[0] = TIMER_A_CCTLN_CCIE;     // clears CCIFG
+                wait = timers->due - SCHED_ticks();
+            }
+        }
+
+        if (wait >= MIN_SLEEP) {            // compare can not be missed
+            __sleep();
+            idle_ticks += SCHED_ticks() - now;
+            wakeups++;
+        }
+    }
+
+    __enable_irq();
+}
+
+// Function to run the scheduler forever
+void SCHED_run(void)
+{
+    start_tick = SCHED_now();
+
+    __enable_irq();
+
+    while (1) {
+        SCHED_run_timers();
+        SCHED_run_queue();
+        SCHED_idle();
+    }
+}
+
+// TIMER_A3 CCR0 ISR - a timer is due, only wakes SCHED_run
+void TA3_0_IRQHandler(void)
+{
+    TIMER_A3->CCTL[0] &= ~(TIMER_A_CCTLN_CCIE | TIMER_A_CCTLN_CCIFG);
+}
+
+// TIMER_A3 roll over ISR
+void TA3_N_IRQHandler(void)
+{
+    if (TIMER_A3->CTL & TIMER_A_CTL_IFG) {
+        TIMER_A3->CTL &= ~TIMER_A_CTL_IFG;
+        overflow++;
+    }
+}
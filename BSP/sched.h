@@ -0,0 +1,60 @@
+/*
+ * sched.h
+ *
+ *  Run to completion task scheduler with tickless idle
+ *
+ *  A task is a function that runs once to the end each time it is called.
+ *  Tasks are started by timers (one shot or periodic) or posted as work
+ *  items from interrupts with SCHED_post. SCHED_run never returns, it runs
+ *  due timers and posted work in main context and when there is nothing
+ *  left it sets TIMER_A3 CCR0 to the next timer due and sleeps in LPM0.
+ *  There is no periodic tick, the CPU only wakes for a due timer, a
+ *  TIMER_A3 roll over (every 2 s) or another interrupt.
+ *
+ *  TIMER_A3 runs continuously from ACLK (32768 Hz) so time is kept while
+ *  MCLK is off. Timer_A is not clocked in LPM3 on the MSP432, only in LPM0.
+ *
+ *  SCHED_timer structs belong to the caller and must stay in memory while
+ *  started. Timers are started and stopped from tasks or main only,
+ *  interrupts use SCHED_post.
+ */
+
+#ifndef SCHED_H_
+#define SCHED_H_
+
+#include <stdint.h>
+
+#define SCHED_TICK_HZ       32768   // ACLK
+#define SCHED_QUEUE_SIZE    16      // must be a power of 2
+
+#define SCHED_MS(ms)    ((uint32_t)(((uint64_t)(ms) * SCHED_TICK_HZ + 500) / 1000))
+
+typedef void (*SCHED_task)(uint32_t data);
+
+typedef struct SCHED_timer {
+    SCHED_task task;
+    uint32_t data;
+    uint32_t due;                   // tick to run at
+    uint32_t period;                // ticks, 0 for one shot
+    struct SCHED_timer* next;       // started timers, sorted by due
+    uint8_t started;
+} SCHED_timer;
+
+typedef struct {
+    uint32_t elapsed;               // ticks since SCHED_run started
+    uint32_t idle;                  // ticks asleep
+    uint32_t wakeups;               // times woken from idle
+    uint32_t max_late;              // most ticks a timer ran after due
+    uint32_t dropped;               // work lost with the queue full
+} SCHED_stats;
+
+void SCHED_init(void);
+void SCHED_start(SCHED_timer* timer, SCHED_task task, uint32_t data,
+                 uint32_t delay_ms, uint32_t period_ms);
+void SCHED_stop(SCHED_timer* timer);
+uint8_t SCHED_post(SCHED_task task, uint32_t data);
+uint32_t SCHED_now(void);
+void SCHED_get_stats(SCHED_stats* stats);
+void SCHED_run(void);
+
+#endif /* SCHED_H_ */
@@ -0,0 +1,257 @@
+// PC test of sched.c against the Timer_A model in Host/, TIMER_A3 on ACLK
+//
+//     gcc -O2 -I../Host sched_host.c sched.c ../Host/msp_host.c -lm -o sched
+//
+// Each run starts SCHED_run and stops it with HOST_end. Timers of 10 ms,
+// 100 ms and 1 s and a 2.5 s one shot (further than a TIMER_A3 roll over)
+// run for 3 s: every run must be at most 1 tick late and on the grid of
+// its first due time, with no periods lost, and the CPU may only wake for
+// a due timer or a roll over, there is no tick. The one shot alone must
+// wake the CPU twice in 3 s. The CPU duty from SCHED_get_stats must match
+// the time the model spent asleep. Then a TIMER_A0 interrupt posts work
+// every 1.37 ms and each item is timed from the post to its task. Last a
+// 50 ms task holds up a 10 ms timer, which must skip the periods it
+// missed and go back to its grid, max_late must match the lateness seen,
+// and work posted while the queue is full must be counted as dropped.
+// Prints the duty cycle, wakeups, lateness and wakeup latency of each
+// run. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include "msp.h"
+#include "sched.h"
+
+#define MCLK_HZ     3000000         // model default, DCO 3 MHz
+#define POST_COUNTS 4111            // SMCLK counts, 1.37 ms
+#define POST_LOG    4096
+#define LONG_MS     50
+
+typedef struct {
+    SCHED_timer timer;
+    uint32_t period;                // ticks
+    uint32_t due;                   // next due, kept by the test
+    uint32_t runs;
+    uint32_t skipped;               // periods missed and not run
+    uint32_t worst_late;            // ticks
+    uint64_t worst_latency;         // ps from the due tick
+    uint8_t off_grid;
+} Timer;
+
+static Timer timers[4];
+static uint64_t aclk_edge0;         // ACLK edge of TIMER_A3 tick 0
+static uint64_t posted_at[POST_LOG];
+static volatile uint32_t posts, handled;
+static uint32_t held_up;            // ticks
+static uint64_t worst_post, total_post;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+// time of a tick, ACLK runs from reset with no change
+static uint64_t tick_time(uint32_t tick)
+{
+    return ((aclk_edge0 + tick) * HOST_PS + SCHED_TICK_HZ - 1) / SCHED_TICK_HZ;
+}
+
+// timer task, data is the index. The due of this run is the one the test
+// kept, the next one is moved on by whole periods like sched.c does.
+static void timed(uint32_t data)
+{
+    Timer* t = &timers[data];
+    uint64_t time = HOST_time();
+    uint32_t now = SCHED_now();
+
+    if (now - t->due > t->worst_late)
+        t->worst_late = now - t->due;
+    if (time - tick_time(t->due) > t->worst_latency)
+        t->worst_latency = time - tick_time(t->due);
+    t->runs++;
+
+    if (t->period) {
+        do {
+            t->due += t->period;
+            t->skipped++;
+        } while ((int32_t)(t->due - now) <= 0);
+        t->skipped--;
+        t->off_grid |= (t->timer.due != t->due);
+    }
+}
+
+// holds up timer 0 from its next due to the end of the task
+static void long_task(uint32_t data)
+{
+    uint32_t due = timers[0].due;
+
+    __delay_cycles((uint64_t)MCLK_HZ * LONG_MS / 1000);
+    held_up = SCHED_now() - due;
+}
+
+static void work(uint32_t data)
+{
+    uint64_t latency = HOST_time() - posted_at[data % POST_LOG];
+
+    if (latency > worst_post)
+        worst_post = latency;
+    total_post += latency;
+    handled++;
+}
+
+// TIMER_A0 is not used by the scheduler, an interrupt posting work
+void TA0_0_IRQHandler(void)
+{
+    TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+    posted_at[posts % POST_LOG] = HOST_time();
+    SCHED_post(work, posts);
+    posts++;
+}
+
+static void start(uint8_t index, SCHED_task task, uint32_t delay_ms, uint32_t period_ms)
+{
+    Timer* t = &timers[index];
+
+    SCHED_start(&t->timer, task, index, delay_ms, period_ms);
+    t->period = SCHED_MS(period_ms);
+    t->due = t->timer.due;
+}
+
+static void posting(uint8_t on)
+{
+    posts = handled = 0;
+    worst_post = total_post = 0;
+    TIMER_A0->CTL = 0;
+    if (!on)
+        return;
+    TIMER_A0->CCR[0] = POST_COUNTS - 1;
+    TIMER_A0->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__UP | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA0_0_IRQn) & 31);
+}
+
+// SCHED_init and the tick grid, the timers are started by the caller
+static void init(void)
+{
+    uint16_t count;
+
+    SCHED_init();
+    count = TIMER_A3->R;
+    aclk_edge0 = (uint64_t)((unsigned __int128)HOST_time() * HOST_aclk() / HOST_PS) - count;
+    for (count = 0; count < 4; count++)
+        timers[count] = (Timer){ 0 };
+}
+
+// SCHED_run for ms, returns the stats and the fraction of time awake
+static double run(uint32_t ms, SCHED_stats* stats)
+{
+    uint64_t time = HOST_time(), sleep = HOST_stats.sleep;
+
+    HOST_end(time + (uint64_t)ms * (HOST_PS / 1000));
+    if (!sigsetjmp(HOST_exit, 1))
+        SCHED_run();
+    HOST_end(0);
+    TIMER_A0->CTL = 0;
+    SCHED_get_stats(stats);
+
+    return 1.0 - (double)(HOST_stats.sleep - sleep) / (HOST_time() - time);
+}
+
+static void report(const char* what, uint8_t count, const SCHED_stats* stats, double awake)
+{
+    uint8_t index;
+
+    printf("%s: %u ms, CPU %.3f %% (model %.3f %%), %u wakeups, max_late %u ticks\n",
+           what, stats->elapsed * 1000 / SCHED_TICK_HZ,
+           100.0 * (stats->elapsed - stats->idle) / stats->elapsed, 100.0 * awake,
+           stats->wakeups, stats->max_late);
+    for (index = 0; index < count; index++)
+        printf("  timer %u: %4u runs, %3u skipped, %u ticks late, %6.1f us after the due tick worst\n",
+               index, timers[index].runs, timers[index].skipped,
+               timers[index].worst_late, timers[index].worst_latency / 1e6);
+}
+
+int main(void)
+{
+    SCHED_stats stats;
+    double awake, duty, margin;
+    uint32_t wake_for, rollovers;
+    uint8_t index, ok;
+
+    // timers only, across a roll over
+    init();
+    posting(0);
+    start(0, timed, 10, 10);
+    start(1, timed, 100, 100);
+    start(2, timed, 1000, 1000);
+    start(3, timed, 2500, 0);               // past the first roll over
+    awake = run(3000, &stats);
+    report("timers", 4, &stats, awake);
+
+    ok = 1;
+    for (index = 0; index < 4; index++)
+        ok &= (timers[index].worst_late <= 1) && !timers[index].off_grid && !timers[index].skipped;
+    check(ok, "timers at most 1 tick late, on their grid, no periods lost");
+    check((timers[0].runs >= 299) && (timers[1].runs >= 29) && (timers[2].runs == 3),
+          "periodic timers run every period");
+    check(timers[3].runs == 1, "one shot past a roll over runs once");
+    check(stats.max_late <= 1, "SCHED_get_stats max_late at most 1 tick");
+
+    // one wakeup per due time and roll over, no periodic tick
+    rollovers = stats.elapsed >> 16;
+    wake_for = timers[0].runs + timers[1].runs + timers[2].runs + timers[3].runs + rollovers;
+    check(stats.wakeups <= wake_for + 1, "CPU wakes only for due timers and roll overs");
+    check(stats.wakeups >= wake_for - 3, "CPU sleeps between timers");
+
+    // the idle count is to a tick at each wakeup
+    duty = (double)(stats.elapsed - stats.idle) / stats.elapsed;
+    margin = (double)(stats.wakeups + 1) / stats.elapsed;
+    check((duty > awake - margin) && (duty < awake + margin), "CPU duty matches the model sleep time");
+    check(awake < 0.05, "CPU asleep most of the time");
+
+    // only the one shot, the roll over and the timer wake the CPU
+    init();
+    start(3, timed, 2500, 0);
+    awake = run(3000, &stats);
+    printf("one shot: %u ms, CPU %.4f %%, %u wakeups\n",
+           stats.elapsed * 1000 / SCHED_TICK_HZ, 100.0 * awake, stats.wakeups);
+    check((stats.wakeups == 2) && (timers[3].runs == 1) && (timers[3].worst_late <= 1),
+          "2.5 s one shot wakes the CPU at the roll over and when due");
+
+    // interrupts posting work
+    init();
+    posting(1);
+    start(0, timed, 10, 10);
+    awake = run(1000, &stats);
+    report("posts", 1, &stats, awake);
+    printf("  %u posts every %.2f ms, %u run, %.1f us from post to task, %.1f us worst\n",
+           posts, POST_COUNTS * 1000.0 / HOST_smclk(), handled,
+           total_post / 1e6 / (handled ? handled : 1), worst_post / 1e6);
+    check((posts >= 720) && (handled + 1 >= posts) && (stats.dropped == 0), "every post run");
+    check(worst_post < 2 * HOST_PS / SCHED_TICK_HZ, "posted work runs within 2 ticks");
+    check(timers[0].worst_late <= 1, "timer at most 1 tick late with posts");
+
+    // a long task holds up the timer and the queue
+    init();
+    posting(1);
+    start(0, timed, 10, 10);
+    start(1, long_task, 505, 0);
+    awake = run(1000, &stats);
+    report("long task", 1, &stats, awake);
+    printf("  %u posts, %u run, %u dropped\n", posts, handled, stats.dropped);
+    check((timers[0].worst_late >= held_up) && (timers[0].worst_late <= held_up + 2),
+          "timer late by the long task");
+    check(stats.max_late == timers[0].worst_late, "max_late is the lateness seen");
+    check((timers[0].skipped >= LONG_MS / 10 - 1) && (timers[0].skipped <= LONG_MS / 10) &&
+          !timers[0].off_grid, "missed periods skipped, timer back on its grid");
+    check((stats.dropped > 0) && (handled + stats.dropped + 1 >= posts) && (handled + stats.dropped <= posts),
+          "posts with the queue full counted as dropped");
+
+    return failed;
+}
+
+#endif
@@ -46,6 +46,11 @@ extern void _c_int00(void);
 /* External declaration for system initialization function                  */
 extern void SystemInit(void);
 
+/* Boot hooks called by Reset_Handler, empty unless the project has boot.c  */
+void Default_Boot               (void) __attribute__((weak));
+extern void BOOT_start          (void) __attribute__((weak, alias("Default_Boot")));
+extern void BOOT_clock          (void) __attribute__((weak, alias("Default_Boot")));
+
 /* Forward declaration of the default fault handlers. */
 void Default_Handler            (void) __attribute__((weak));
 extern void Reset_Handler       (void) __attribute__((weak));
@@ -180,14 +185,26 @@ void (* const interruptVectors[])(void) =
 /* application.                                                                */
 void Reset_Handler(void)
 {
+    /* Start the boot timing (boot.c) */
+    BOOT_start();
+
     SystemInit();
 
+    /* Final clock before _c_int00 copies .data and clears .bss */
+    BOOT_clock();
+
     /* Jump to the CCS C Initialization Routine. */
     __asm("    .global _c_int00\n"
           "    b.w     _c_int00");
 }
 
 
+/* Boot hook used when the project does not define its own. */
+void Default_Boot(void)
+{
+}
+
+
 /* This is the code that gets called when the processor receives an unexpected  */
 /* interrupt.  This simply enters an infinite loop, preserving the system state */
 /* for examination by a debugger.                                               */
@@ -0,0 +1,114 @@
+// PC check of SystemInit, SystemCoreClockUpdate and __delay_cycles timing
+// against the register model in Host/
+//
+//     gcc -O2 -I../Host system_host.c system_msp432p401r.c ../Host/msp_host.c -lm -o system
+//
+// Every DCORSEL and DIVM setting is written to CS, SystemCoreClockUpdate
+// must read back the MCLK the model runs at, and a 1 s __delay_cycles(MCLK)
+// blink must take 1 s of simulated time plus the P1->OUT access. Prints
+// the blink periods and exits with 1 if any check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <time.h>
+#include "msp.h"
+
+#define BLINKS      4
+
+static uint64_t toggle_time[BLINKS + 1];
+static uint8_t toggles;
+static uint8_t failed;
+
+static void check(int ok, const char* what, uint32_t got, uint32_t want)
+{
+    if (!ok) {
+        printf("FAIL %s: %u, expected %u\n", what, got, want);
+        failed = 1;
+    }
+}
+
+static void led(uint8_t port, uint8_t out, uint8_t dir)
+{
+    if ((port == 1) && (toggles <= BLINKS))
+        toggle_time[toggles++] = HOST_time();
+}
+
+static void set_clock(uint32_t dcorsel, uint32_t divm)
+{
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL0 = dcorsel << CS_CTL0_DCORSEL_OFS;
+    CS->CTL1 = CS_CTL1_SELA__REFOCLK | CS_CTL1_SELS__DCOCLK | CS_CTL1_SELM__DCOCLK |
+               (divm << CS_CTL1_DIVM_OFS) | CS_CTL1_DIVS__2;      // SMCLK <= 24 MHz
+    CS->KEY = 0;
+}
+
+// LED toggled every cycles MCLK cycles, returns the worst error in ps
+// against the expected period
+static uint64_t blink(uint32_t cycles)
+{
+    uint64_t expect = (uint64_t)((unsigned __int128)(cycles + HOST_ACCESS_CYCLES) * HOST_PS / HOST_mclk());
+    uint64_t period, error, worst = 0;
+    uint8_t index;
+
+    toggles = 0;
+    for (index = 0; index <= BLINKS; index++) {
+        P1->OUT ^= BIT0;
+        __delay_cycles(cycles);
+    }
+
+    for (index = 1; index < toggles; index++) {
+        period = toggle_time[index] - toggle_time[index - 1];
+        error = (period > expect) ? period - expect : expect - period;
+        if (error > worst)
+            worst = error;
+    }
+    return worst;
+}
+
+int main(void)
+{
+    static const char* const dco[6] = { "1.5", "3", "6", "12", "24", "48" };
+    struct timespec start, end;
+    uint32_t dcorsel, divm, expect;
+    uint64_t error;
+
+    SystemInit();
+    SystemCoreClockUpdate();
+    check(SystemCoreClock == 3000000, "SystemInit MCLK", SystemCoreClock, 3000000);
+    check(HOST_mclk() == 3000000, "model MCLK", HOST_mclk(), 3000000);
+
+    P1->DIR |= BIT0;
+    HOST_port_out = led;
+
+    // 48 MHz needs VCORE1 and a wait state, the others are set up for it too
+    PCM->CTL0 = PCM_CTL0_KEY_VAL | PCM_CTL0_AMR_1;
+    while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) | FLCTL_BANK0_RDCTL_WAIT_1;
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) | FLCTL_BANK1_RDCTL_WAIT_1;
+
+    printf("DCO MHz  DIVM  SystemCoreClock  1 s blink error\n");
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (dcorsel = 0; dcorsel < 6; dcorsel++)
+        for (divm = 0; divm < 8; divm++) {
+            set_clock(dcorsel, divm);
+            SystemCoreClockUpdate();
+            expect = (uint32_t)((1500000ULL << dcorsel) >> divm);
+            check(SystemCoreClock == expect, "SystemCoreClock", SystemCoreClock, expect);
+            check(HOST_mclk() == expect, "model MCLK", HOST_mclk(), expect);
+
+            error = blink(SystemCoreClock);
+            check(error <= 1, "blink error ps", (uint32_t)error, 0);
+            printf("%7s  /%-3u %16u  %u ps\n", dco[dcorsel], 1u << divm,
+                   SystemCoreClock, (unsigned)error);
+        }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    check(HOST_stats.flash_errors == 0, "flash / VCORE errors", HOST_stats.flash_errors, 0);
+    printf("%.0f s simulated in %.1f ms\n", (double)HOST_time() / HOST_PS,
+           (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6);
+
+    return failed;
+}
+
+#endif
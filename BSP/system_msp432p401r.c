@@ -179,7 +179,7 @@ void SystemCoreClockUpdate(void)
 
         if(dcoTune == 0)
         {
-            SystemCoreClock = centeredFreq;
+            SystemCoreClock = centeredFreq / dividerValue;
         }
         else
         {
@@ -204,7 +204,8 @@ void SystemCoreClockUpdate(void)
             SystemCoreClock = (uint32_t) ((centeredFreq)
                                / (1
                                     - ((dcoConst * dcoTune)
-                                            / (8 * (1 + dcoConst * (768 - calVal))))));
+                                            / (8 * (1 + dcoConst * (768 - calVal))))))
+                              / dividerValue;
         }
         break;
     case CS_CTL1_SELM__MODOSC:
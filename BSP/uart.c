@@ -0,0 +1,186 @@
+// Interrupt driven UART driver with TX and RX ring buffers
+// eUSCI_A0 at 115200 baud using SMCLK = 3 MHz
+
+#include "msp.h"
+#include "uart.h"
+#include "ramfunc.h"
+
+#define TX_MASK (UART_TX_SIZE - 1)
+#define RX_MASK (UART_RX_SIZE - 1)
+
+// head is only written by the producer, tail only by the consumer
+static char tx_buffer[UART_TX_SIZE];
+static volatile uint16_t tx_head = 0;   // written by UART_write
+static volatile uint16_t tx_tail = 0;   // written by ISR
+
+static char rx_buffer[UART_RX_SIZE];
+static volatile uint16_t rx_head = 0;   // written by ISR
+static volatile uint16_t rx_tail = 0;   // written by UART_read
+static volatile uint16_t rx_dropped = 0;
+
+// Function to configure eUSCI_A0 for 115200 baud and enable RX interrupts
+void UART_init(void)
+{
+    EUSCI_A0->CTLW0 |= EUSCI_A_CTLW0_SWRST; // Put eUSCI in reset
+    EUSCI_A0->CTLW0 = EUSCI_A_CTLW0_SWRST | // Remain eUSCI in reset
+    EUSCI_B_CTLW0_SSEL__SMCLK;      // Configure eUSCI clock source for SMCLK
+
+    // Baud Rate calculation
+    // 3000000/(115200) = 26.041667
+    // Fractional portion = 0.041667
+    // User's Guide Table 21-4: UCBRSx = 0x00
+    // UCBRx = int (26.041667 / 16) = 1
+    // UCBRFx = int (((26.041667/16)-1)*16) = 10
+
+    EUSCI_A0->BRW = 1;                      // Using baud rate calculator
+    EUSCI_A0->MCTLW = (10 << EUSCI_A_MCTLW_BRF_OFS) |
+    EUSCI_A_MCTLW_OS16;
+
+    // Configure UART pins
+    P1->SEL0 |= (BIT2 | BIT3);              // set 2-UART pin as secondary function
+
+    tx_head = tx_tail = 0;                  // empty buffers
+    rx_head = rx_tail = 0;
+    rx_dropped = 0;
+
+    EUSCI_A0->CTLW0 &= ~EUSCI_A_CTLW0_SWRST; // Initialize eUSCI
+    EUSCI_A0->IFG &= ~EUSCI_A_IFG_RXIFG;    // Clear eUSCI RX interrupt flag
+    EUSCI_A0->IE |= EUSCI_A_IE_RXIE;        // Enable USCI_A0 RX interrupt
+                                            // TXIE is enabled when data is queued
+
+    // Enable eUSCIA0 interrupt in NVIC module
+    NVIC->ISER[0] = 1 << ((EUSCIA0_IRQn) & 31);
+}
+
+// Function to set the baud rate dividers again after SMCLK has changed.
+// Call with the TX idle, a character being sent is cut off.
+// N = smclk / 115200, above 16 oversampling is used with
+// UCBRx = int(N / 16) and UCBRFx = int(N) % 16, below it UCBRx = int(N).
+// UCBRSx is left 0, the error is under 0.5% from 1.5 to 24 MHz.
+void UART_set_clock(uint32_t smclk)
+{
+    uint32_t n = smclk / UART_BAUD;
+
+    EUSCI_A0->CTLW0 |= EUSCI_A_CTLW0_SWRST; // clears IE, set again below
+
+    if (n >= 16) {
+        EUSCI_A0->BRW = n / 16;
+        EUSCI_A0->MCTLW = ((n % 16) << EUSCI_A_MCTLW_BRF_OFS) |
+        EUSCI_A_MCTLW_OS16;
+    }
+    else {
+        EUSCI_A0->BRW = n;
+        EUSCI_A0->MCTLW = 0;
+    }
+
+    EUSCI_A0->CTLW0 &= ~EUSCI_A_CTLW0_SWRST;
+    EUSCI_A0->IE |= EUSCI_A_IE_RXIE;        // TXIE is set by the next write
+}
+
+// Function to queue characters for transmit. Does not wait for space in the
+// buffer, returns the number of characters that were queued
+uint16_t UART_write(const char* data, uint16_t length)
+{
+    uint16_t count;
+    uint16_t head = tx_head;
+
+    for (count = 0; count < length; count++)
+    {
+        if (((head + 1) & TX_MASK) == tx_tail)  // buffer full
+            break;
+
+        tx_buffer[head] = data[count];
+        head = (head + 1) & TX_MASK;
+    }
+
+    if (count) {
+        tx_head = head;     // publish data to the ISR after it is written
+
+        // set TXIE with a single bit-band write so the ISR clearing it
+        // can not be lost between a read and write of IE
+        BITBAND_PERI(EUSCI_A0->IE, EUSCI_A_IE_TXIE_OFS) = 1;
+    }
+
+    return count;
+}
+
+// Function to queue a NULL terminated string for transmit
+uint16_t UART_write_string(const char* print_string)
+{
+    uint16_t length = 0;
+
+    while (print_string[length] != 0)
+        length++;
+
+    return UART_write(print_string, length);
+}
+
+// Function to copy up to length received characters into data. Returns the
+// number of characters copied, 0 if nothing has been received
+uint16_t UART_read(char* data, uint16_t length)
+{
+    uint16_t count;
+    uint16_t tail = rx_tail;
+
+    for (count = 0; (count < length) && (tail != rx_head); count++)
+    {
+        data[count] = rx_buffer[tail];
+        tail = (tail + 1) & RX_MASK;
+    }
+
+    rx_tail = tail;     // release the space back to the ISR
+
+    return count;
+}
+
+// Number of characters that can be queued without UART_write truncating
+uint16_t UART_tx_free(void)
+{
+    return (tx_tail - tx_head - 1) & TX_MASK;
+}
+
+// Returns 1 when the TX buffer is empty and the last character has been sent
+uint8_t UART_tx_idle(void)
+{
+    return (tx_head == tx_tail) && !(EUSCI_A0->STATW & EUSCI_A_STATW_BUSY);
+}
+
+// Number of received characters lost because the RX buffer was full
+uint16_t UART_rx_dropped(void)
+{
+    return rx_dropped;
+}
+
+// UART interrupt service routine
+// RX - move received character into the RX buffer
+// TX - send the next character or disable TXIE when the buffer is empty
+// Runs from SRAM, it is called for every character.
+RAMFUNC void EUSCIA0_IRQHandler(void)
+{
+    uint16_t head, tail;
+
+    if (EUSCI_A0->IFG & EUSCI_A_IFG_RXIFG)
+    {
+        head = rx_head;
+        if (((head + 1) & RX_MASK) == rx_tail) {    // buffer full
+            (void)EUSCI_A0->RXBUF;                  // read to clear flag
+            rx_dropped++;
+        }
+        else {
+            rx_buffer[head] = EUSCI_A0->RXBUF;
+            rx_head = (head + 1) & RX_MASK;
+        }
+    }
+
+    if ((EUSCI_A0->IE & EUSCI_A_IE_TXIE) && (EUSCI_A0->IFG & EUSCI_A_IFG_TXIFG))
+    {
+        tail = tx_tail;
+        if (tail == tx_head) {                      // nothing left to send
+            EUSCI_A0->IE &= ~EUSCI_A_IE_TXIE;
+        }
+        else {
+            EUSCI_A0->TXBUF = tx_buffer[tail];      // clears TXIFG
+            tx_tail = (tail + 1) & TX_MASK;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+/*
+ * uart.h
+ *
+ *  Interrupt driven UART driver for eUSCI_A0 (P1.2 RXD / P1.3 TXD)
+ *  115200 baud 8N1 using SMCLK = 3 MHz, UART_set_clock moves the baud
+ *  rate to another SMCLK
+ *
+ *  Transmit and receive use ring buffers. UART_write() only copies
+ *  the data into the TX buffer and enables TXIE, the ISR drains the
+ *  buffer one byte per TXIFG. Received bytes are put in the RX buffer
+ *  by the ISR and read with UART_read().
+ *
+ *  Each buffer has a single producer and a single consumer (main code
+ *  and the ISR) so no interrupt locking is needed.
+ */
+
+#ifndef UART_H_
+#define UART_H_
+
+#include <stdint.h>
+
+#define UART_TX_SIZE  256   // must be a power of 2
+#define UART_RX_SIZE  64    // must be a power of 2
+#define UART_BAUD     115200
+
+void UART_init(void);
+void UART_set_clock(uint32_t smclk);
+uint16_t UART_write(const char* data, uint16_t length);
+uint16_t UART_write_string(const char* print_string);
+uint16_t UART_read(char* data, uint16_t length);
+uint16_t UART_tx_free(void);
+uint8_t UART_tx_idle(void);
+uint16_t UART_rx_dropped(void);
+
+#endif /* UART_H_ */
@@ -0,0 +1,154 @@
+// PC test of uart.c against the eUSCI_A model in Host/
+//
+//     gcc -O2 -I../Host uart_host.c uart.c ../Host/msp_host.c -lm -o uart
+//
+// Checks bytes out in order at the bit time of BRW / BRF, RX into the ring
+// with drops counted once it is full, a full TX buffer truncating the
+// write, and the baud rate after UART_set_clock. Then compares the CPU
+// time to send a block with the ISR against the polled TXIFG loop the
+// driver replaced. Model cycles are register accesses and exception entry
+// and exit, the C between them is not counted. Exits with 1 if a check
+// fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "msp.h"
+#include "uart.h"
+
+#define BLOCK       200
+
+static char sent[1024];
+static uint64_t sent_time[1024];
+static uint16_t sent_count;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void uart_tx(uint8_t uart, uint8_t byte)
+{
+    if (sent_count < sizeof(sent)) {
+        sent_time[sent_count] = HOST_time();
+        sent[sent_count++] = byte;
+    }
+}
+
+static void wait_idle(void)
+{
+    while (!UART_tx_idle())
+        HOST_run(10 * HOST_PS / 1000000);
+}
+
+// CPU busy and ISR time in MCLK cycles since the last call
+static uint64_t cpu_cycles(void)
+{
+    static uint64_t last;
+    uint64_t ps = HOST_stats.busy + HOST_stats.isr, cycles;
+
+    cycles = (ps - last) * HOST_mclk() / HOST_PS;
+    last = ps;
+    return cycles;
+}
+
+// the TX path UART_Demo had: wait for TXIFG before every byte
+static void polled_write(const char* data, uint16_t length)
+{
+    while (length--) {
+        while (!(EUSCI_A0->IFG & EUSCI_A_IFG_TXIFG));
+        EUSCI_A0->TXBUF = *data++;
+    }
+}
+
+// bit time in SMCLK cycles between two bytes sent back to back
+static double byte_gap(uint16_t first)
+{
+    return (double)(sent_time[first + 1] - sent_time[first]) * HOST_smclk() / HOST_PS / 10;
+}
+
+int main(void)
+{
+    static const char text[] = "Hello, ring buffer";
+    char block[BLOCK], in[UART_RX_SIZE];
+    uint64_t isr_cycles, polled_cycles;
+    uint16_t index, count;
+
+    HOST_uart_tx = uart_tx;
+    UART_init();
+    __enable_irq();
+
+    // bytes out in order, 16 * BRW + BRF = 26 SMCLK cycles per bit at 3 MHz
+    count = UART_write_string(text);
+    check(count == strlen(text), "write returns the length");
+    wait_idle();
+    check((sent_count == strlen(text)) && !memcmp(sent, text, sent_count), "bytes sent in order");
+    check(fabs(byte_gap(0) - 26.0) < 0.01, "bit time 16 * BRW + BRF");
+    printf("3 MHz: %u bytes, %.1f SMCLK cycles per bit, %.0f baud\n",
+           sent_count, byte_gap(0), HOST_smclk() / byte_gap(0));
+
+    // RX: 10 bytes read back, then more than the ring holds
+    for (index = 0; index < 10; index++)
+        HOST_uart_rx(0, '0' + index);
+    HOST_run(2 * HOST_PS / 1000);
+    count = UART_read(in, sizeof(in));
+    check((count == 10) && !memcmp(in, "0123456789", 10), "RX bytes in order");
+
+    for (index = 0; index < 100; index++)
+        HOST_uart_rx(0, (uint8_t)index);
+    HOST_run(20 * HOST_PS / 1000);
+    count = UART_read(in, sizeof(in));
+    check(count == UART_RX_SIZE - 1, "RX ring holds size - 1");
+    check(UART_rx_dropped() == 100 - (UART_RX_SIZE - 1), "RX drops counted");
+    printf("RX: %u kept, %u dropped of 100\n", count, UART_rx_dropped());
+
+    // a write larger than the free space is truncated, not blocked
+    memset(block, 'x', sizeof(block));
+    sent_count = 0;
+    count = UART_write(block, sizeof(block));
+    index = UART_write(block, sizeof(block));
+    check(index < sizeof(block), "write truncates at the free space");
+    check(UART_tx_free() < 4, "TX buffer full after truncated write");
+    count += index;
+    wait_idle();
+    check(sent_count == count, "every queued byte sent");
+
+    // baud rate kept after SMCLK moves to 12 MHz
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL0 = CS_CTL0_DCORSEL_3;
+    CS->KEY = 0;
+    UART_set_clock(HOST_smclk());
+    sent_count = 0;
+    UART_write("ab", 2);
+    wait_idle();
+    check(fabs(byte_gap(0) - 104.0) < 0.01, "bit time at 12 MHz");
+    printf("12 MHz: %.1f SMCLK cycles per bit, %.0f baud\n", byte_gap(0), HOST_smclk() / byte_gap(0));
+
+    // CPU time for a block: ISR driven against the polled loop
+    cpu_cycles();
+    UART_write(block, BLOCK);
+    wait_idle();
+    isr_cycles = cpu_cycles();
+
+    polled_write(block, BLOCK);
+    wait_idle();
+    polled_cycles = cpu_cycles();
+
+    printf("%u bytes at 12 MHz MCLK: ISR %llu cycles (%.1f per byte), polled %llu cycles "
+           "(%.1f per byte), %.1f cycles per byte saved\n", BLOCK,
+           (unsigned long long)isr_cycles, (double)isr_cycles / BLOCK,
+           (unsigned long long)polled_cycles, (double)polled_cycles / BLOCK,
+           (double)(polled_cycles - isr_cycles) / BLOCK);
+    check(isr_cycles * 10 < polled_cycles, "ISR path under a tenth of the polled CPU time");
+    check(HOST_stats.overruns == 0, "no TXBUF overruns");
+
+    return failed;
+}
+
+#endif
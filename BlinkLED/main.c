@@ -2,6 +2,12 @@
 // Paul Hummel
 
 #include "msp.h"
+#include "pinmap.h"
+
+#define BLINK_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      /* P1.0 red LED */
+
+PIN_TABLE(blink_pins, BLINK_PINS);
 
 int main(void) {
     int i;
@@ -9,9 +15,7 @@ int main(void) {
     // stop watchdog timer
     WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;
 
-    P1->SEL0 &= BIT0;                   // P1.0 set as GPIO
-    P1->SEL1 &= BIT0;
-    P1->DIR |= BIT0;                    // P1.0 set as output
+    PIN_apply(blink_pins, PIN_COUNT(blink_pins));   // P1.0 GPIO output
 
     while (1)                           // continuous loop
     {
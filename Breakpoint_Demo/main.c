@@ -2,24 +2,22 @@
 // Paul Hummel
 
 #include "msp.h"
+#include "pinmap.h"
+
+#define DEMO_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      /* P1.0 red LED */ \
+    PIN(1, 1, PIN_IN_PULLUP)    /* P1.1 left button */
+
+PIN_TABLE(demo_pins, DEMO_PINS);
 
 int main(void)
 {
     // Hold the watchdog
     WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;
 
-    // Configuring P1.0 as output for red LED
+    // P1.0 as output for red LED
     // and P1.1 (left button) as input with pull-up resistor.
-
-    P1->SEL0 &= ~(BIT0 + BIT1); // set P1.0 and P1.1 as GPIO
-    P1->SEL1 &= ~(BIT0 + BIT1);
-
-    P1->DIR |= BIT0;        // set P1.0 output
-    P1->OUT &= ~BIT0;
-
-    P1->DIR &= ~BIT1;       // set P1.1 as input
-    P1->REN |= BIT1;        // enable pull up resistor
-    P1->OUT |= BIT1;
+    PIN_apply(demo_pins, PIN_COUNT(demo_pins));
 
     P1->IES |= BIT1;        // Interrupt on high-to-low transition
     P1->IFG &= ~BIT1;       // Clear all P1 interrupt flags
@@ -38,7 +36,8 @@ int main(void)
     // Enable global interrupt
     __enable_irq();
 
-    while (1);  // loop that does nothing
+    while (1)
+        __sleep();  // all work is in the ISRs, sleep in LPM0
 }
 
 // Port1 ISR
@@ -1,39 +1,67 @@
 /*
- *  Set DCOCLK to 12 MHz
- *  Set ACLK to REFOCLK at 32.678 kHz
- *  Set MCLK and SMCLK to DCO
+ *  Scale MCLK at run time with clock.c
+ *  Boost MCLK to 48 MHz for a burst of work, drop to 1.5 MHz when idle
+ *  Set ACLK to REFOCLK at 32.678 kHz (reset default)
  *
- *  Verify clock speed using __delay_cycles macro and blinking LED
+ *  delay_ms comes from BSP/delay.c. delay_init registers a CLOCK_notify
+ *  that moves the delays to the new MCLK after every change, like a UART
+ *  or timer driver would, so the LED blinks at the same rate at both clocks.
+ *  P1.0 is on during the 48 MHz burst and off at 1.5 MHz. MCLK is on P4.3
+ *  to check with a scope.
+ *
+ *  SystemCoreClockUpdate() is used to read back the MCLK frequency from the
+ *  CS registers. If it does not match the profile the RGB LED is turned red.
  *
  *  Paul Hummel
  */
 
 #include "msp.h"
 #include <stdint.h>
+#include "clock.h"
+#include "delay.h"
+#include "pinmap.h"
+
+#define BOOST_FREQ  48000000            // MCLK for the burst
+#define IDLE_FREQ   1500000             // MCLK between bursts
+#define BURST_MS    500
+#define IDLE_MS     1500
+
+#define CLOCK_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      /* P1.0 LED, on during the burst */ \
+    PIN(2, 0, PIN_OUT_LOW)      /* P2.0 RGB red, profile error */ \
+    PIN(4, 3, PIN_FUNC1_OUT)    /* P4.3 MCLK out */
 
-#define CYCLES 3000000
+PIN_TABLE(clock_pins, CLOCK_PINS);
+
+void setProfile(uint32_t freq);
 
 uint16_t main(void) {
 
     WDT_A->CTL = WDT_A_CTL_PW |             // Stop WDT
     WDT_A_CTL_HOLD;
 
-    P1->SEL0 &= ~BIT0;                      // P1.0 set GPIO
-    P1->SEL1 &= ~BIT0;
-    P1->DIR |= BIT0;                        // P1.0 set as output
-
-
-    CS->KEY = CS_KEY_VAL ;                  // Unlock CS module for register access
-    CS->CTL0 = 0;                           // Reset tuning parameters
-    CS->CTL0 = CS_CTL0_DCORSEL_3;           // Set DCO to 12MHz (nominal, center of 8-16MHz range)
-    // Select ACLK = REFO, SMCLK = MCLK = DCO
-    CS->CTL1 = CS_CTL1_SELA_2 | CS_CTL1_SELS_3 | CS_CTL1_SELM_3;
-    CS->KEY = 0;                            // Lock CS module from unintended accesses
+    PIN_apply(clock_pins, PIN_COUNT(clock_pins));   // LEDs, MCLK out on P4.3
 
+    delay_init();                           // SysTick delays, follow MCLK
 
     while (1)                               // continuous loop
     {
-        P1->OUT ^= BIT0;                    // XOR P1.0
-        __delay_cycles(CYCLES);             // 3_000_000 cycles ~ 1s at 3 MHz
+        setProfile(BOOST_FREQ);             // burst of work at full speed
+        P1->OUT |= BIT0;
+        delay_ms(BURST_MS);
+
+        setProfile(IDLE_FREQ);              // idle at the lowest clock
+        P1->OUT &= ~BIT0;
+        delay_ms(IDLE_MS);
     }
 }
+
+// Changes MCLK and checks the CS registers give the same frequency
+void setProfile(uint32_t freq) {
+
+    CLOCK_set_profile(freq);
+
+    SystemCoreClockUpdate();                // recalculate MCLK from CS registers
+    if (SystemCoreClock != freq)            // clock is not what the profile set
+        P2->OUT |= BIT0;                    // turn on red LED to flag the error
+}
@@ -0,0 +1,62 @@
+/*
+ * freq.h
+ *
+ *  Frequency / period measurement with TIMER_A0 and TIMER_A1
+ *
+ *  Every TIMER_A0 capture gets a 32-bit timestamp built from the 16-bit
+ *  capture value and a software overflow count. The capture ISR checks
+ *  for a roll over that is still pending, so an edge just after the roll
+ *  over is never counted in the wrong 65536 count period.
+ *
+ *  FREQ_RECIPROCAL - capture every rising edge. A result closes at the
+ *      first edge after the gate time once at least min_edges periods
+ *      have been seen, and gives the time of a whole number of periods.
+ *      Resolution is 1 timer count over the window for any input
+ *      frequency, so this is the mode for low and mid frequencies (1 Hz
+ *      and up). Each edge costs an interrupt, which limits it to tens of
+ *      kHz.
+ *  FREQ_GATED - TIMER_A1 counts input edges on TA1CLK and TIMER_A0 CCR1
+ *      opens and closes a fixed gate. Error is +/-1 edge per gate, so
+ *      this is the mode for high frequencies (100 kHz to several MHz).
+ *      No interrupt per edge is needed.
+ *
+ *  Windows are back to back (the closing edge or gate starts the next)
+ *  so no edges are lost between results. The frequency is only divided
+ *  out in FREQ_read, once per result, not in the ISR.
+ *
+ *  TA0_N and TA1_N must have the same NVIC priority so one can not split
+ *  the other's read of a counter and its overflow count.
+ *
+ *  FREQ_init leaves PRIMASK as it was, main enables interrupts.
+ */
+
+#ifndef FREQ_H_
+#define FREQ_H_
+
+#include <stdint.h>
+
+// TIMER_A0 input, CCI3B = C1.OUT from the comparator
+#define FREQ_CCR        3
+#define FREQ_CCIS       TIMER_A_CCTLN_CCIS_1
+
+#define FREQ_TIMER_ID   TIMER_A_CTL_ID__4
+#define FREQ_TIMER_CLK  3000000     // SMCLK 12 MHz / 4 (24 MHz clock profile)
+#define FREQ_SCALE      100         // results in 0.01 Hz
+#define FREQ_GATE_STEP  30000       // CCR1 step in gated mode, < 65536
+
+typedef enum {
+    FREQ_RECIPROCAL,
+    FREQ_GATED
+} FREQ_Mode;
+
+typedef struct {
+    uint32_t events;                // input periods in the window
+    uint32_t counts;                // TIMER_A0 counts in the window
+} FREQ_Window;
+
+void FREQ_init(FREQ_Mode mode, uint16_t gate_ms, uint16_t min_edges);
+uint8_t FREQ_read(uint32_t* freq);
+uint8_t FREQ_read_window(FREQ_Window* window);
+uint32_t FREQ_missed(void);
+
+#endif /* FREQ_H_ */
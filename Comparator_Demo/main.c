@@ -3,13 +3,25 @@
 // Paul Hummel
 
 #include "msp.h"
+#include "pinmap.h"
 
 #define COLOR_LED (BIT0 | BIT1 | BIT2)
 
+#define COMP_PINS(PIN) \
+    PIN(6, 7, PIN_FUNC3)        /* P6.7 C1.0 input */ \
+    PIN(7, 2, PIN_FUNC1_OUT)    /* P7.2 C1OUT */ \
+    PIN(2, 0, PIN_OUT_LOW)      /* P2.0 - P2.2 RGB LED indicator */ \
+    PIN(2, 1, PIN_OUT_LOW) \
+    PIN(2, 2, PIN_OUT_LOW)
+
+PIN_TABLE(comp_pins, COMP_PINS);
+
 void main(void)
 {
 	WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;		// stop watchdog timer
 
+	PIN_apply(comp_pins, PIN_COUNT(comp_pins));     // C1.0 in, C1OUT, RGB LED off
+
 	COMP_E1->CTL0 = COMP_E_CTL0_IPEN        // enable + input comparator
 	              | COMP_E_CTL0_IPSEL_0;    // select C1.0 P6.7
 
@@ -26,20 +38,11 @@ void main(void)
 
 	COMP_E1->INT = COMP_E_INT_IE;           // enable interrupt for rising edge
 
-	P6->SEL0 |= BIT7;   // select C1.0 for P6.7
-	P6->SEL1 |= BIT7;
-
-	P7->SEL0 |= BIT2;   // select C1 Out on P7.2
-	P7->SEL1 &= ~BIT2;
-	P7->DIR |= BIT2;
-
-	P2->DIR |= COLOR_LED;       // use RGB LED as indicator
-	P2->OUT &= ~(COLOR_LED);
-
 	NVIC->ISER[0] = (1 << (COMP_E1_IRQn & 31));
 	__enable_irq();
 
-	while(1); // do nothing
+	while(1)
+		__sleep();  // all work is in the ISR, sleep in LPM0
 }
 
 // comparator ISR changes the color of the RGB LED on every trigger
@@ -0,0 +1,168 @@
+// DMA waveform generator for the MCP4921 SPI DAC
+//
+// TIMER_A0 CCR0 (SMCLK, up mode) -> DMA channel 0 (source 6 = TA0CCR0)
+// TIMER_A0 CCR2, DAC_LO_DELAY on -> DMA channel 1 (source 6 = TA0CCR2)
+// DMA channel 0, 1 byte/trigger  -> EUSCI_B0->TXBUF high byte, STE = DAC CS
+// DMA channel 1, 1 byte/trigger  -> EUSCI_B0->TXBUF low byte
+// DMA channel 1 done             -> DMA_INT1 ISR re-arms the finished halves
+
+#include "msp.h"
+#include <math.h>
+#include "dac.h"
+#include "dma.h"
+
+#define DAC_TIMER_CLK   3000000         // SMCLK = DCO default 3 MHz
+#define DAC_DMA_HI      0               // DMA channel for the high bytes
+#define DAC_DMA_LO      1               // DMA channel for the low bytes
+#define DAC_DMA_SRC     6               // source 6 = TA0CCR0 on channel 0, TA0CCR2 on 1
+#define DAC_BIT_CYCLES  2               // SMCLK cycles per SCK bit (UCBRx)
+
+// TXBUF holds one byte, so the low byte is written once the high byte is
+// in the shift register and before it is all out, or CS would go high
+// between the bytes. TXBUF moves to the shift register 1 cycle after the
+// CCR0 DMA write and the byte takes 8 * DAC_BIT_CYCLES, so CCR2 fires half
+// way through it.
+#define DAC_LO_DELAY    (4 * DAC_BIT_CYCLES)
+
+#define GAIN BIT5                       // 1x gain
+#define SHDN BIT4                       // output enabled
+
+static uint8_t frames_hi[DAC_MAX_SAMPLES];     // control bits and D11 - D8
+static uint8_t frames_lo[DAC_MAX_SAMPLES];     // D7 - D0
+static uint16_t frame_count = 0;
+
+static void frames_done(void);
+
+// Function to set a descriptor up to send one byte of every frame
+static void frames_arm(DMA_descriptor* descriptor, uint8_t* bytes)
+{
+    DMA_set(descriptor, &bytes[frame_count - 1], &EUSCI_B0->TXBUF,
+            DMA_DST_INC_0 | DMA_DST_SIZE_8 | DMA_SRC_INC_8 | DMA_SRC_SIZE_8 |
+            DMA_ARB_1 | DMA_N_MINUS_1(frame_count) | DMA_PINGPONG);
+}
+
+// Function to re-arm the descriptors of a channel that finished
+static void frames_rearm(uint8_t channel, uint8_t* bytes)
+{
+    if ((DMA_primary(channel)->control & DMA_CYCLE_MASK) == 0)
+        frames_arm(DMA_primary(channel), bytes);
+    if ((DMA_alternate(channel)->control & DMA_CYCLE_MASK) == 0)
+        frames_arm(DMA_alternate(channel), bytes);
+}
+
+// Function to set up eUSCI_B0 as 4-pin SPI master with STE as CS and
+// DMA channels 0 and 1 triggered by TIMER_A0 CCR0 and CCR2
+void DAC_init(void)
+{
+    P1->SEL0 |= BIT4 | BIT5 | BIT6;     // Set P1.4, P1.5, and P1.6 as
+    P1->SEL1 &= ~(BIT4 | BIT5 | BIT6);  // SPI pins functionality
+
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_SWRST; // Put eUSCI state machine in reset
+
+    EUSCI_B0->CTLW0 = EUSCI_B_CTLW0_SWRST    |  // keep eUSCI in reset
+                      EUSCI_B_CTLW0_MST      |  // Set as SPI master
+                      EUSCI_B_CTLW0_SYNC     |  // Set as synchronous mode
+                      EUSCI_B_CTLW0_CKPL     |  // Set clock polarity high
+                      EUSCI_B_CTLW0_MODE_2   |  // 4-pin, STE active low
+                      EUSCI_B_CTLW0_STEM     |  // STE is CS for the DAC
+                      EUSCI_B_CTLW0_UCSSEL_2 |  // SMCLK
+                      EUSCI_B_CTLW0_MSB;        // MSB first
+
+    EUSCI_B0->BRW = DAC_BIT_CYCLES;    // fBitClock = fBRCLK / UCBRx = 1.5 MHz
+
+    EUSCI_B0->CTLW0 &= ~EUSCI_B_CTLW0_SWRST;  // Initialize USCI state machine
+
+    // TIMER_A0 up mode paces the frames, started by DAC_start
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_CLR;
+
+    DMA_init();
+    DMA_channel(DAC_DMA_HI, DAC_DMA_SRC);
+    DMA_channel(DAC_DMA_LO, DAC_DMA_SRC);
+
+    // DMA_INT1 is dedicated to channel 1 completion, the low bytes finish
+    // last so both channels are done when it runs
+    DMA_int1(DAC_DMA_LO, frames_done);
+}
+
+// Function to convert count 12-bit samples into DAC frames. Must be called
+// while the DAC is stopped.
+void DAC_load(const uint16_t* samples, uint16_t count)
+{
+    uint16_t index;
+
+    if (count > DAC_MAX_SAMPLES)
+        count = DAC_MAX_SAMPLES;
+
+    for (index = 0; index < count; index++) {
+        frames_hi[index] = ((samples[index] >> 8) & 0x0F) | GAIN | SHDN;
+        frames_lo[index] = samples[index] & 0xFF;
+    }
+
+    frame_count = count;
+}
+
+// Function to start output at update_rate samples per second. The waveform
+// frequency is update_rate / count. A frame takes 16 * DAC_BIT_CYCLES, so
+// update_rate is at most DAC_MAX_RATE.
+void DAC_start(uint32_t update_rate)
+{
+    if ((frame_count == 0) || (update_rate > DAC_MAX_RATE))
+        return;
+
+    frames_arm(DMA_primary(DAC_DMA_HI), frames_hi);
+    frames_arm(DMA_alternate(DAC_DMA_HI), frames_hi);
+    frames_arm(DMA_primary(DAC_DMA_LO), frames_lo);
+    frames_arm(DMA_alternate(DAC_DMA_LO), frames_lo);
+    DMA_Control->ALTCLR = (1 << DAC_DMA_HI) | (1 << DAC_DMA_LO);   // start with primary
+    DMA_Control->ENASET = (1 << DAC_DMA_HI) | (1 << DAC_DMA_LO);
+
+    TIMER_A0->CCR[0] = (DAC_TIMER_CLK / update_rate) - 1;
+    TIMER_A0->CCR[2] = DAC_LO_DELAY - 1;       // DAC_LO_DELAY after CCR0
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_CLR;
+    TIMER_A0->R = DAC_LO_DELAY;                // first frame starts at CCR0
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__UP;
+}
+
+// Function to stop output, the DAC holds the last value. A frame cut
+// before its 16th bit is dropped by the DAC.
+void DAC_stop(void)
+{
+    TIMER_A0->CTL &= ~TIMER_A_CTL_MC_MASK;
+    DMA_Control->ENACLR = (1 << DAC_DMA_HI) | (1 << DAC_DMA_LO);
+}
+
+// Function to fill table with one period of a sine wave
+void DAC_sine_table(uint16_t* table, uint16_t count, uint16_t amplitude, uint16_t offset)
+{
+    uint16_t index;
+    float value;
+
+    for (index = 0; index < count; index++) {
+        value = offset + amplitude * sinf(2.0f * 3.14159265f * index / count);
+        if (value < 0)
+            value = 0;
+        if (value > DAC_FULL_SCALE)
+            value = DAC_FULL_SCALE;
+        table[index] = (uint16_t)(value + 0.5f);
+    }
+}
+
+// Function to fill table with one full scale ramp
+void DAC_ramp_table(uint16_t* table, uint16_t count)
+{
+    uint16_t index;
+
+    for (index = 0; index < count; index++)
+        table[index] = ((uint32_t)index * DAC_FULL_SCALE) / (count - 1);
+}
+
+// DMA channel 1 done, from the DMA_INT1 ISR in dma.c. One half of the
+// ping-pong finished on both channels and the DMA moved to the other one.
+// The finished descriptors have their cycle control cleared.
+static void frames_done(void)
+{
+    DMA_Channel->INT0_CLRFLG = (1 << DAC_DMA_HI) | (1 << DAC_DMA_LO);
+
+    frames_rearm(DAC_DMA_HI, frames_hi);
+    frames_rearm(DAC_DMA_LO, frames_lo);
+}
@@ -0,0 +1,38 @@
+/*
+ * dac.h
+ *
+ *  DMA waveform generator for the MCP4921 12-bit SPI DAC on eUSCI_B0
+ *
+ *  A table of samples is converted to 2 byte MCP4921 frames. Once per
+ *  update period TIMER_A0 CCR0 triggers DMA channel 0, which moves the
+ *  high byte into TXBUF, and a few SCK bits later CCR2 triggers channel 1
+ *  with the low byte, so it is written while the high byte shifts out
+ *  and never over a full TXBUF. The eUSCI_B0 runs in 4-pin SPI mode with
+ *  STE as the DAC chip select, so CS goes low for each frame and rising
+ *  CS latches the output without any CPU involvement. The DMA runs
+ *  ping-pong on the same table so the waveform repeats with no gaps. The
+ *  update rate comes only from the timer so there is no jitter from the
+ *  CPU.
+ *
+ *  P1.4  UCB0STE   CS
+ *  P1.5  UCB0CLK   SCK
+ *  P1.6  UCB0SIMO  SDI
+ */
+
+#ifndef DAC_H_
+#define DAC_H_
+
+#include <stdint.h>
+
+#define DAC_MAX_SAMPLES 1024    // DMA cycle is at most 1024 transfers
+#define DAC_FULL_SCALE  4095
+#define DAC_MAX_RATE    75000   // 3 MHz SMCLK / 40, a frame is 33 cycles
+
+void DAC_init(void);
+void DAC_load(const uint16_t* samples, uint16_t count);
+void DAC_start(uint32_t update_rate);
+void DAC_stop(void);
+void DAC_sine_table(uint16_t* table, uint16_t count, uint16_t amplitude, uint16_t offset);
+void DAC_ramp_table(uint16_t* table, uint16_t count);
+
+#endif /* DAC_H_ */
@@ -0,0 +1,131 @@
+// PC test of dac.c against a model of the MCP4921 on the SPI model in Host/
+//
+//     gcc -O2 -I. -I../BSP -I../Host dac_host.c dac.c ../BSP/dma.c ../Host/msp_host.c -lm
+//         -Wno-unknown-pragmas -o dac
+//
+// The MCP4921 takes the 16 bits clocked in while CS is low and latches
+// them when CS goes high. Every frame must be 2 bytes with gain 1x and the
+// output on, and the values must follow the loaded table with no frame
+// lost or repeated, across the ping-pong switches. Runs the 100 Hz sine of
+// main.c and a 1024 point ramp at DAC_MAX_RATE, and prints the update
+// rate and the spread of the time between latches (the jitter) for each.
+// Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include "msp.h"
+#include "dac.h"
+
+#define NS          (HOST_PS / 1000000000)
+#define CONTROL     0x3             // BUF 0, GAIN 1x, SHDN 1 in bits 15 - 12
+
+static const uint16_t* expect;
+static uint16_t expect_count;
+static uint32_t frames, bad_frames, bad_values, index_next;
+static uint16_t bits, bytes;
+static uint64_t first_latch, last_latch, min_period, max_period;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static uint8_t dac_byte(uint8_t spi, uint8_t mosi)
+{
+    if (spi == 0) {
+        bits = (bits << 8) | mosi;
+        bytes++;
+    }
+    return 0xFF;
+}
+
+// CS rising latches the frame
+static void dac_cs(uint8_t spi, uint8_t active)
+{
+    uint64_t now = HOST_time(), period;
+
+    if (spi != 0)
+        return;
+    if (active) {
+        bits = bytes = 0;
+        return;
+    }
+
+    if ((bytes != 2) || ((bits >> 12) != CONTROL)) {
+        bad_frames++;
+        return;
+    }
+    if ((bits & 0x0FFF) != expect[index_next % expect_count])
+        bad_values++;
+    index_next++;
+
+    if (frames++ == 0)
+        first_latch = now;
+    else {
+        period = now - last_latch;
+        if (period < min_period)
+            min_period = period;
+        if (period > max_period)
+            max_period = period;
+    }
+    last_latch = now;
+}
+
+static void run(const char* name, const uint16_t* table, uint16_t count, uint32_t rate,
+                uint32_t periods)
+{
+    double seconds, measured;
+
+    expect = table;
+    expect_count = count;
+    frames = bad_frames = bad_values = index_next = 0;
+    min_period = HOST_NEVER;
+    max_period = 0;
+
+    DAC_load(table, count);
+    DAC_start(rate);
+    HOST_run((uint64_t)periods * count * HOST_PS / rate);
+    DAC_stop();
+    HOST_run(HOST_PS / 1000);           // last frame out
+
+    seconds = (double)(last_latch - first_latch) / HOST_PS;
+    measured = (frames - 1) / seconds;
+    printf("%s: %u frames, %.1f updates/s (asked %u), jitter %.1f ns\n", name, frames,
+           measured, rate, (double)(max_period - min_period) / NS);
+
+    check(bad_frames == 0, "every frame is 2 bytes with gain 1x, output on");
+    check(bad_values == 0, "values follow the table across the ping-pong switches");
+    check(frames + 1 >= periods * count, "no frame lost");
+    check((measured > rate * 0.99) && (measured < rate * 1.01), "update rate within 1 %");
+    check(max_period - min_period <= HOST_PS / 3000000, "jitter at most one SMCLK cycle");
+}
+
+int main(void)
+{
+    static uint16_t wave[256], ramp[DAC_MAX_SAMPLES];
+
+    HOST_spi_byte = dac_byte;
+    HOST_spi_ste = dac_cs;
+
+    DAC_init();
+    __enable_irq();
+
+    DAC_sine_table(wave, 256, DAC_FULL_SCALE / 2, DAC_FULL_SCALE / 2);
+    run("sine 256 points 25600/s", wave, 256, 25600, 20);
+
+    DAC_ramp_table(ramp, DAC_MAX_SAMPLES);
+    run("ramp 1024 points at DAC_MAX_RATE", ramp, DAC_MAX_SAMPLES, DAC_MAX_RATE, 10);
+
+    check(HOST_stats.overruns == 0, "no byte written over a full TXBUF");
+    printf("%u DMA transfers, %u interrupts, %.2f %% CPU in the ISR\n",
+           HOST_stats.dma_transfers, HOST_stats.interrupts,
+           100.0 * HOST_stats.isr / HOST_time());
+    return failed;
+}
+
+#endif
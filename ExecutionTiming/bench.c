@@ -0,0 +1,214 @@
+// Table of C operation costs measured with the cycle counter
+
+#include <stdint.h>
+#include <math.h>
+#include "cycles.h"
+#include "bench.h"
+
+#if defined(__arm__) || defined(__TI_ARM__)
+#include "logger.h"
+#define BENCH_printf    LOG_printf
+#else
+#include <stdio.h>
+#define BENCH_printf    printf
+#endif
+
+#define NOINLINE        __attribute__((noinline))
+#define STRIDE          8           // words between reads, 32 bytes
+
+typedef struct {
+    const char* group;
+    const char* name;
+    void (*run)(void);
+    uint8_t base;               // first of the group, taken off the others
+    uint16_t items;             // cost is divided by this
+    CYC_site site;
+} BENCH_entry;
+
+// operands and operations for one type, r = a op b
+#define BENCH_ARITH(T, N, A, B) \
+    static volatile T N##_a = (A), N##_b = (B), N##_r; \
+    static void N##_copy(void) { N##_r = N##_a; } \
+    static void N##_add(void) { N##_r = N##_a + N##_b; } \
+    static void N##_sub(void) { N##_r = N##_a - N##_b; } \
+    static void N##_mul(void) { N##_r = N##_a * N##_b; } \
+    static void N##_div(void) { N##_r = N##_a / N##_b; }
+
+#define BENCH_INTEGER(T, N, A, B) \
+    BENCH_ARITH(T, N, A, B) \
+    static void N##_mod(void) { N##_r = N##_a % N##_b; }
+
+#define BENCH_FLOAT(T, N, A, B, SQRT) \
+    BENCH_ARITH(T, N, A, B) \
+    static void N##_sqrt(void) { N##_r = SQRT(N##_a); }
+
+#define BENCH_OP(N, OP, BASE) \
+    { #N, #OP, N##_##OP, (BASE), 1, CYC_SITE(#N " " #OP) }
+
+#define BENCH_ARITH_OPS(N) \
+    BENCH_OP(N, copy, 1), BENCH_OP(N, add, 0), BENCH_OP(N, sub, 0), \
+    BENCH_OP(N, mul, 0), BENCH_OP(N, div, 0)
+
+#define BENCH_INTEGER_OPS(N) \
+    BENCH_ARITH_OPS(N), BENCH_OP(N, mod, 0)
+
+#define BENCH_FLOAT_OPS(N) \
+    BENCH_ARITH_OPS(N), BENCH_OP(N, sqrt, 0)
+
+// signed a * 7 fits the type, overflow would be undefined. Unsigned
+// rows wrap, which is defined.
+BENCH_INTEGER(int8_t, int8_t, 18, 7)
+BENCH_INTEGER(uint8_t, uint8_t, 200, 7)
+BENCH_INTEGER(int16_t, int16_t, 4000, 7)
+BENCH_INTEGER(uint16_t, uint16_t, 60000, 7)
+BENCH_INTEGER(int32_t, int32_t, 300000000, 7)
+BENCH_INTEGER(uint32_t, uint32_t, 4000000000u, 7)
+BENCH_INTEGER(int64_t, int64_t, 1000000000000000000, 7)
+BENCH_INTEGER(uint64_t, uint64_t, 18000000000000000000u, 7)
+BENCH_INTEGER(int, int, 300000000, 7)
+BENCH_FLOAT(float, float, 3.14159f, 2.71828f, sqrtf)
+BENCH_FLOAT(double, double, 3.14159, 2.71828, sqrt)
+
+// math.h calls, base is a double copy
+static void math_copy(void) { double_r = double_a; }
+static void math_sinf(void) { float_r = sinf(float_a); }
+static void math_sin(void) { double_r = sin(double_a); }
+static void math_expf(void) { float_r = expf(float_b); }
+static void math_exp(void) { double_r = exp(double_b); }
+static void math_logf(void) { float_r = logf(float_a); }
+static void math_log(void) { double_r = log(double_a); }
+static void math_powf(void) { float_r = powf(float_a, float_b); }
+static void math_pow(void) { double_r = pow(double_a, double_b); }
+
+// function calls, base is the same work done inline
+NOINLINE static int32_t call_none(void)
+{
+    return int32_t_a;
+}
+
+NOINLINE static int32_t call_args(int32_t a, int32_t b, int32_t c, int32_t d)
+{
+    return a + b + c + d;
+}
+
+static int32_t (*volatile call_pointer)(void) = call_none;
+
+static void call_inline(void) { int32_t_r = int32_t_a; }
+static void call_0(void) { int32_t_r = call_none(); }
+static void call_4(void) { int32_t_r = call_args(int32_t_a, int32_t_b, 1, 2); }
+static void call_ptr(void) { int32_t_r = call_pointer(); }
+
+// memory reads, const table stays in flash and a copy is made in SRAM
+static const uint32_t flash_table[BENCH_WORDS] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static uint32_t sram_table[BENCH_WORDS];
+
+static void memory_copy(void) { uint32_t_r = uint32_t_a; }
+
+static void memory_sum(const volatile uint32_t* table, uint16_t stride)
+{
+    uint32_t sum = 0;
+    uint16_t start, word;
+
+    for (start = 0; start < stride; start++)    // every word read once
+        for (word = start; word < BENCH_WORDS; word += stride)
+            sum += table[word];
+
+    uint32_t_r = sum;
+}
+
+static void memory_flash(void) { memory_sum(flash_table, 1); }
+static void memory_sram(void) { memory_sum(sram_table, 1); }
+static void memory_flash_stride(void) { memory_sum(flash_table, STRIDE); }
+static void memory_sram_stride(void) { memory_sum(sram_table, STRIDE); }
+
+#define BENCH_ITEMS(N, OP, BASE, ITEMS) \
+    { #N, #OP, N##_##OP, (BASE), (ITEMS), CYC_SITE(#N " " #OP) }
+
+static BENCH_entry table[] = {
+    BENCH_INTEGER_OPS(int8_t),
+    BENCH_INTEGER_OPS(uint8_t),
+    BENCH_INTEGER_OPS(int16_t),
+    BENCH_INTEGER_OPS(uint16_t),
+    BENCH_INTEGER_OPS(int32_t),
+    BENCH_INTEGER_OPS(uint32_t),
+    BENCH_INTEGER_OPS(int64_t),
+    BENCH_INTEGER_OPS(uint64_t),
+    BENCH_INTEGER_OPS(int),
+    BENCH_FLOAT_OPS(float),
+    BENCH_FLOAT_OPS(double),
+
+    BENCH_OP(math, copy, 1),
+    BENCH_OP(math, sinf, 0), BENCH_OP(math, sin, 0),
+    BENCH_OP(math, expf, 0), BENCH_OP(math, exp, 0),
+    BENCH_OP(math, logf, 0), BENCH_OP(math, log, 0),
+    BENCH_OP(math, powf, 0), BENCH_OP(math, pow, 0),
+
+    BENCH_OP(call, inline, 1),
+    BENCH_OP(call, 0, 0), BENCH_OP(call, 4, 0), BENCH_OP(call, ptr, 0),
+
+    BENCH_OP(memory, copy, 1),
+    BENCH_ITEMS(memory, flash, 0, BENCH_WORDS),
+    BENCH_ITEMS(memory, sram, 0, BENCH_WORDS),
+    BENCH_ITEMS(memory, flash_stride, 0, BENCH_WORDS),
+    BENCH_ITEMS(memory, sram_stride, 0, BENCH_WORDS),
+};
+
+#define ENTRIES (sizeof(table) / sizeof(table[0]))
+
+// Function to fill the SRAM copy of the flash table
+void BENCH_init(void)
+{
+    uint16_t word;
+
+    for (word = 0; word < BENCH_WORDS; word++)
+        sram_table[word] = flash_table[word];
+}
+
+// Function to time every entry BENCH_REPEAT times
+void BENCH_run(void)
+{
+    uint16_t entry, repeat;
+
+    for (entry = 0; entry < ENTRIES; entry++) {
+        CYC_reset(&table[entry].site);
+        for (repeat = 0; repeat < BENCH_REPEAT; repeat++) {
+            CYC_TIME(table[entry].site) {
+                table[entry].run();
+            }
+        }
+    }
+}
+
+// Function to print the table, one line per entry. net is per item in
+// tenths of a cycle and in ns at mclk_mhz.
+void BENCH_report(uint32_t mclk_mhz)
+{
+    uint16_t entry;
+    uint32_t base = 0, net, net_ns;
+    const BENCH_entry* bench;
+
+    CYC_wait();
+    BENCH_printf("MCLK %lu MHz, CYC_TIME overhead %lu cycles\n",
+                 (unsigned long)mclk_mhz, (unsigned long)CYC_overhead());
+    CYC_wait();
+    BENCH_printf("   min   mean    max      net  net ns\n");
+
+    for (entry = 0; entry < ENTRIES; entry++) {
+        bench = &table[entry];
+        if (bench->base)
+            base = bench->site.min;
+
+        net = (bench->site.min > base) ? bench->site.min - base : 0;
+        net_ns = (net * 1000 + (mclk_mhz * bench->items) / 2)
+               / (mclk_mhz * bench->items);
+        net = (net * 10 + bench->items / 2) / bench->items;
+
+        CYC_wait();
+        BENCH_printf("%6lu %6lu %6lu %6lu.%lu %7lu  %s %s\n",
+                     (unsigned long)bench->site.min,
+                     (unsigned long)CYC_mean(&bench->site),
+                     (unsigned long)bench->site.max,
+                     (unsigned long)(net / 10), (unsigned long)(net % 10),
+                     (unsigned long)net_ns, bench->group, bench->name);
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * bench.h
+ *
+ *  Cycle cost of C operations, function calls and memory reads
+ *
+ *  Groups of entries:
+ *      int8_t - uint64_t, int   copy add sub mul div mod
+ *      float, double            copy add sub mul div sqrt
+ *      math                     sin exp log pow in float and double
+ *      call                     inline, calls with 0 and 4 arguments,
+ *                               call through a function pointer
+ *      memory                   sum of BENCH_WORDS words read from a
+ *                               const table in flash or a copy in SRAM,
+ *                               in order and 8 words apart
+ *
+ *  Each entry is a small function that works on volatile variables, so
+ *  the compiler can not fold it away and every entry loads its operands
+ *  and stores the result like TestFunction did. The first entry of a
+ *  group is its base (a plain copy) and is taken off the others, so the
+ *  net column is the cost of the operation itself. Memory entries are
+ *  divided by BENCH_WORDS to give the cost per word.
+ *
+ *  All entries are timed in one run, BENCH_REPEAT times each, and the
+ *  minimum is used for the net cost so an interrupt in one sample does
+ *  not show up in the table. BENCH_report prints cycles and ns at the
+ *  MCLK the run was made at.
+ *
+ *  bench.c and cycles.c also build on a PC with bench_host.c. There the
+ *  counter is in ns, so the numbers are only good to compare entries.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+
+#define BENCH_REPEAT    16
+#define BENCH_WORDS     256
+
+void BENCH_init(void);
+void BENCH_run(void);
+void BENCH_report(uint32_t mclk_mhz);
+
+#endif /* BENCH_H_ */
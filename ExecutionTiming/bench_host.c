@@ -0,0 +1,23 @@
+// PC build of the benchmark table for comparing entries
+//
+//     gcc -O2 bench_host.c bench.c cycles.c -lm -o bench
+//
+// The counter is clock_gettime in ns, reported as 1000 "MHz" so the
+// cycle and ns columns are both ns.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include "cycles.h"
+#include "bench.h"
+
+int main(void)
+{
+    CYC_init();
+    BENCH_init();
+    BENCH_run();
+    BENCH_report(1000);
+
+    return 0;
+}
+
+#endif
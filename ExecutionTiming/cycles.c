@@ -0,0 +1,152 @@
+// Execution time measurement with the DWT cycle counter (CYCCNT)
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+#define _POSIX_C_SOURCE 199309L     // clock_gettime on the host
+#endif
+
+#include "cycles.h"
+
+#if defined(__arm__) || defined(__TI_ARM__)
+#include "logger.h"
+#include "uart.h"
+#define CYC_printf  LOG_printf
+#else
+#include <stdio.h>
+#include <time.h>
+#define CYC_printf  printf
+#endif
+
+#define CALIBRATE_RUNS  32
+
+static uint32_t overhead = 0;
+
+#if defined(__arm__) || defined(__TI_ARM__)
+// Function to sleep until the UART TX buffer has room for a whole line,
+// LOG_printf drops lines that do not fit
+void CYC_wait(void)
+{
+    __disable_irq();
+    while (UART_tx_free() < LOG_LINE_SIZE) {
+        __sleep();                  // woken by the TX interrupt
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+}
+#else
+// Host counter in ns in place of CYCCNT
+uint32_t CYC_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000000u + (uint32_t)now.tv_nsec;
+}
+
+void CYC_wait(void)
+{
+}
+#endif
+
+// Function to start the cycle counter and measure the cost of an empty
+// CYC_TIME, the smallest of CALIBRATE_RUNS
+void CYC_init(void)
+{
+    CYC_site empty = CYC_SITE("empty");
+    uint8_t run;
+
+#if defined(__arm__) || defined(__TI_ARM__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;     // enable DWT
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    overhead = 0;
+    for (run = 0; run < CALIBRATE_RUNS; run++) {
+        CYC_TIME(empty) {
+        }
+    }
+    overhead = empty.min;
+}
+
+// Function to end a sample started at start, less the measuring overhead
+void CYC_stop(CYC_site* site, uint32_t start)
+{
+    uint32_t cycles = CYC_now() - start;
+
+    CYC_record(site, (cycles > overhead) ? cycles - overhead : 0);
+}
+
+// Function to add a sample measured some other way
+void CYC_record(CYC_site* site, uint32_t cycles)
+{
+    uint8_t bin = 0;
+
+    while ((cycles >> bin) && (bin < CYC_BINS - 1))
+        bin++;                      // bits needed for cycles
+
+    site->count++;
+    site->total += cycles;
+    if (cycles < site->min)
+        site->min = cycles;
+    if (cycles > site->max)
+        site->max = cycles;
+    site->hist[bin]++;
+}
+
+// Function to clear all samples of a site
+void CYC_reset(CYC_site* site)
+{
+    uint8_t bin;
+
+    site->count = 0;
+    site->total = 0;
+    site->min = 0xFFFFFFFF;
+    site->max = 0;
+    for (bin = 0; bin < CYC_BINS; bin++)
+        site->hist[bin] = 0;
+}
+
+// Returns the average cycles of a site, rounded
+uint32_t CYC_mean(const CYC_site* site)
+{
+    if (site->count == 0)
+        return 0;
+
+    return (site->total + site->count / 2) / site->count;
+}
+
+// Returns the cycles CYC_TIME takes with nothing inside
+uint32_t CYC_overhead(void)
+{
+    return overhead;
+}
+
+// Function to print a site summary and the histogram bins that have
+// samples. Waits for room in the UART buffer so no line is dropped.
+void CYC_report(const CYC_site* site)
+{
+    uint8_t bin;
+
+    CYC_wait();
+    if (site->count == 0) {
+        CYC_printf("%s: no samples\n", site->name);
+        return;
+    }
+
+    CYC_printf("%s: n %lu  min %lu  mean %lu  max %lu\n", site->name,
+               (unsigned long)site->count, (unsigned long)site->min,
+               (unsigned long)CYC_mean(site), (unsigned long)site->max);
+
+    for (bin = 0; bin < CYC_BINS; bin++) {
+        if (site->hist[bin] == 0)
+            continue;
+        CYC_wait();
+        if (bin == CYC_BINS - 1)
+            CYC_printf("  >= %lu: %lu\n", (unsigned long)1 << (bin - 1),
+                       (unsigned long)site->hist[bin]);
+        else
+            CYC_printf("  < %lu: %lu\n", (unsigned long)1 << bin,
+                       (unsigned long)site->hist[bin]);
+    }
+}
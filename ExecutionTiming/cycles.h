@@ -0,0 +1,70 @@
+/*
+ * cycles.h
+ *
+ *  Execution time measurement with the Cortex-M4 DWT cycle counter
+ *
+ *  CYCCNT counts every MCLK cycle, so a start / stop pair gives the exact
+ *  cycles spent in between without a scope. Each measured place in the
+ *  code has a CYC_site that keeps the count, min, max and total of its
+ *  samples and a histogram in powers of 2 (bin n holds 2^(n-1) to
+ *  2^n - 1 cycles, bin 0 holds 0 and the last bin everything larger).
+ *  CYC_init measures the cycles of an empty CYC_TIME and that overhead is
+ *  taken off every sample.
+ *
+ *      static CYC_site filter_site = CYC_SITE("filter");
+ *
+ *      CYC_TIME(filter_site) {
+ *          filter(buffer);
+ *      }
+ *      CYC_report(&filter_site);
+ *
+ *  CYC_report prints with LOG_printf (logger.c) so the results go out the
+ *  backchannel UART. Built for a PC (not __arm__) the counter is
+ *  clock_gettime in ns and the report uses printf.
+ */
+
+#ifndef CYCLES_H_
+#define CYCLES_H_
+
+#include <stdint.h>
+
+#define CYC_BINS    16
+
+typedef struct {
+    const char* name;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[CYC_BINS];
+} CYC_site;
+
+#define CYC_SITE(name)  { (name), 0, 0xFFFFFFFF, 0, 0, {0} }
+
+#if defined(__arm__) || defined(__TI_ARM__)
+#include "msp.h"
+
+// current cycle count, wraps every 2^32 cycles (89 s at 48 MHz)
+static inline uint32_t CYC_now(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+uint32_t CYC_now(void);
+#endif
+
+// time the statement or block that follows and add it to site
+#define CYC_TIME(site) \
+    for (uint32_t cyc_start_ = CYC_now(), cyc_once_ = 1; cyc_once_; \
+         cyc_once_ = 0, CYC_stop(&(site), cyc_start_))
+
+void CYC_init(void);
+void CYC_stop(CYC_site* site, uint32_t start);
+void CYC_record(CYC_site* site, uint32_t cycles);
+void CYC_reset(CYC_site* site);
+uint32_t CYC_mean(const CYC_site* site);
+uint32_t CYC_overhead(void);
+void CYC_report(const CYC_site* site);
+void CYC_wait(void);
+
+#endif /* CYCLES_H_ */
@@ -0,0 +1,154 @@
+// ISR entry to exit cycles from flash and from SRAM
+
+#include "msp.h"
+#include "ramfunc.h"
+#include "irq.h"
+#include "cycles.h"
+#include "clock.h"
+#include "logger.h"
+#include "isrbench.h"
+
+#define FLASH_IRQ   T32_INT1_IRQn
+#define SRAM_IRQ    T32_INT2_IRQn
+#define CTX_IRQ     T32_INTC_IRQn
+#define BUFFERS     (CLOCK_BUFFER_INSTR | CLOCK_BUFFER_DATA)
+#define RING_SIZE   16              // must be a power of 2
+
+typedef struct {
+    const char* name;
+    IRQn_Type irq;
+    uint8_t buffers;                // CLOCK_flash_buffer setting
+    uint8_t sram_table;             // 1 for the IRQ_init table
+    CYC_site entry;
+    CYC_site total;
+} ISRBENCH_entry;
+
+typedef struct {
+    uint8_t data[RING_SIZE];
+    uint8_t head;
+    uint8_t checksum;
+} ISRBENCH_ring;
+
+static ISRBENCH_entry table[] = {
+    { "flash handler", FLASH_IRQ, 0, 0, CYC_SITE("entry"), CYC_SITE("total") },
+    { "flash handler", FLASH_IRQ, BUFFERS, 0,
+      CYC_SITE("entry"), CYC_SITE("total") },
+    { "SRAM handler", SRAM_IRQ, 0, 0, CYC_SITE("entry"), CYC_SITE("total") },
+    { "SRAM handler", SRAM_IRQ, BUFFERS, 0,
+      CYC_SITE("entry"), CYC_SITE("total") },
+    { "SRAM handler", SRAM_IRQ, BUFFERS, 1,
+      CYC_SITE("entry"), CYC_SITE("total") },
+    { "SRAM handler + ctx", CTX_IRQ, BUFFERS, 1,
+      CYC_SITE("entry"), CYC_SITE("total") },
+};
+
+#define ENTRIES (sizeof(table) / sizeof(table[0]))
+
+static volatile uint32_t entered;   // CYCCNT at the start of the handler
+static volatile ISRBENCH_ring ring;
+static uint32_t flash_table;        // SCB->VTOR for the startup table
+static uint32_t sram_table;         // SCB->VTOR after IRQ_init
+
+// Body of all handlers, a ring buffer put and a short loop over the ring
+// like a small driver ISR
+#define ISR_BODY(r) \
+    uint8_t index, sum = 0; \
+    entered = CYC_now(); \
+    (r)->data[(r)->head & (RING_SIZE - 1)] = (uint8_t)entered; \
+    (r)->head++; \
+    for (index = 0; index < RING_SIZE; index++) \
+        sum += (r)->data[index]; \
+    (r)->checksum = sum
+
+void T32_INT1_IRQHandler(void)
+{
+    ISR_BODY(&ring);
+}
+
+RAMFUNC void T32_INT2_IRQHandler(void)
+{
+    ISR_BODY(&ring);
+}
+
+// Same body on the ring passed by IRQ_register
+RAMFUNC static void ctx_handler(void* ctx)
+{
+    ISR_BODY((volatile ISRBENCH_ring*)ctx);
+}
+
+// Function to point SCB->VTOR at a vector table
+static void set_table(uint32_t vtor)
+{
+    SCB->VTOR = vtor;
+    __DSB();
+    __ISB();
+}
+
+// Function to enable the vectors in the NVIC, they are only ever pended
+// by software. The SRAM table gets ctx_handler and the startup table is
+// put back until ISRBENCH_run.
+void ISRBENCH_init(void)
+{
+    flash_table = SCB->VTOR;
+    IRQ_register(CTX_IRQ, ctx_handler, (void*)&ring);
+    sram_table = SCB->VTOR;
+    set_table(flash_table);
+
+    NVIC->ISER[0] = (1 << (FLASH_IRQ & 31)) | (1 << (SRAM_IRQ & 31)) |
+                    (1 << (CTX_IRQ & 31));
+}
+
+// Function to pend irq and time it to the handler and back
+static void isr_time(ISRBENCH_entry* bench)
+{
+    uint32_t start, end;
+
+    start = CYC_now();
+    NVIC->STIR = bench->irq;
+    __DSB();                        // STIR write done
+    __ISB();                        // handler runs before the next line
+    end = CYC_now();
+
+    CYC_record(&bench->entry, entered - start);
+    CYC_record(&bench->total, end - start - CYC_overhead());
+}
+
+// Function to time every entry ISRBENCH_REPEAT times. The flash buffers
+// are left on and the SRAM table in use when done.
+void ISRBENCH_run(void)
+{
+    uint16_t entry, repeat;
+
+    for (entry = 0; entry < ENTRIES; entry++) {
+        CLOCK_flash_buffer(table[entry].buffers);
+        set_table(table[entry].sram_table ? sram_table : flash_table);
+        CYC_reset(&table[entry].entry);
+        CYC_reset(&table[entry].total);
+        for (repeat = 0; repeat < ISRBENCH_REPEAT; repeat++)
+            isr_time(&table[entry]);
+    }
+
+    CLOCK_flash_buffer(BUFFERS);
+}
+
+// Function to print the minimum entry and total cycles of each handler
+void ISRBENCH_report(uint32_t mclk_mhz)
+{
+    uint16_t entry;
+
+    CYC_wait();
+    LOG_printf("ISR at %lu MHz\n", (unsigned long)mclk_mhz);
+    CYC_wait();
+    LOG_printf(" entry  total  total ns\n");
+
+    for (entry = 0; entry < ENTRIES; entry++) {
+        CYC_wait();
+        LOG_printf("%6lu %6lu %9lu  %s, %s table, buffers %s\n",
+                   (unsigned long)table[entry].entry.min,
+                   (unsigned long)table[entry].total.min,
+                   (unsigned long)(table[entry].total.min * 1000 / mclk_mhz),
+                   table[entry].name,
+                   table[entry].sram_table ? "SRAM" : "flash",
+                   table[entry].buffers ? "on" : "off");
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * isrbench.h
+ *
+ *  ISR entry to exit cycles with the handler in flash and in SRAM
+ *
+ *  Two handlers with the same body, one left in flash and one marked
+ *  RAMFUNC (ramfunc.h), are pended by software through NVIC->STIR on the
+ *  Timer32 vectors (T32_INT1 flash, T32_INT2 SRAM), which this program
+ *  does not otherwise use. For each one two times are kept:
+ *
+ *      entry   STIR write to the first line of the handler, the hardware
+ *              stacking and the vector fetch
+ *      total   STIR write to the line after the return in main
+ *
+ *  Both are run with the flash read buffers off and on (CLOCK_flash_buffer)
+ *  ISRBENCH_REPEAT times each and the minimum is reported, at whatever
+ *  clock profile is set when ISRBENCH_run is called.
+ *
+ *  Two more rows, buffers on, use the SRAM vector table of irq.h: the
+ *  SRAM handler through the copied vector, and the same body registered
+ *  with IRQ_register on T32_INTC so it gets its ring buffer as ctx through
+ *  a thunk. Against the SRAM handler row with the flash table they show
+ *  what moving the table and passing a context cost. SCB->VTOR is switched
+ *  between the two tables for each row and left on the SRAM table.
+ *
+ *  Interrupts must be enabled and the UART idle while it runs.
+ */
+
+#ifndef ISRBENCH_H_
+#define ISRBENCH_H_
+
+#include <stdint.h>
+
+#define ISRBENCH_REPEAT 16
+
+void ISRBENCH_init(void);
+void ISRBENCH_run(void);
+void ISRBENCH_report(uint32_t mclk_mhz);
+
+#endif /* ISRBENCH_H_ */
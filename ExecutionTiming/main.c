@@ -1,47 +1,87 @@
 // Program designed to measure the timing for various C operations with
-// different variable types. By toggling a pin before and after function
-// call (P2.0) and toggling a second pin before and after the operation,
-// multiple timing aspects can be measured.
-// P2.0 (1)->Call function->P1.0 (1)->operation->P1.0 (0)->return->P1.0 (0)
+// different variable types. The DWT cycle counter (cycles.c) times the
+// call to TestCall and the operation inside TestFunction in separate
+// loops, so the call is not timed with a site inside it. The table in
+// bench.c times every operation for every type in one run. The whole run
+// is repeated with MCLK at 3, 12, 24 and 48 MHz (clock.c) and the results
+// are sent out the backchannel UART at 115200 baud (P1.3). isrbench.c
+// times an interrupt handler run from flash and from SRAM at each clock,
+// and through the SRAM vector table of irq.c with a context.
 //
 // Paul Hummel
 
 #include "msp.h"
 #include <math.h>
+#include "uart.h"
+#include "logger.h"
+#include "cycles.h"
+#include "bench.h"
+#include "clock.h"
+#include "isrbench.h"
+#include "pinmap.h"
 
 #define var_type uint8_t
+#define RUNS     100
 
-var_type TestFunction(var_type num);
-
-void main(void) {
+#define TIMING_PINS(PIN) \
+    PIN(4, 3, PIN_FUNC1_OUT)    /* P4.3 MCLK out to measure the clock */
 
-    var_type mainVar;
+PIN_TABLE(timing_pins, TIMING_PINS);
 
-    WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;   // Stop watchdog timer
+var_type TestFunction(var_type num);
+var_type TestCall(var_type num);
+void uartClock(uint8_t event, uint32_t mclk, uint32_t smclk);
 
-    CS->KEY = CS_KEY_VAL;
-    CS->CTL0 = CS_CTL0_DCORSEL_3;    // set DCO to 12 MHz
-    CS->CTL1 = (CS_CTL1_DIVM__1 | CS_CTL1_SELS__DCOCLK | CS_CTL1_SELM__DCOCLK);    // MCLK select DCO
-    CS->KEY = 0;
+static CYC_site call_site = CYC_SITE("TestFunction call");
+static CYC_site op_site = CYC_SITE("TestFunction operation");
 
-    P1->SEL1 &= ~BIT0;          //set P1.0 as simple I/O
-    P1->SEL0 &= ~BIT0;
-    P1->DIR |= BIT0;            //set P1.0 as output
+static const uint32_t clocks[] = {3, 12, 24, 48};   // MCLK in MHz
 
-    P2->SEL1 &= ~BIT0;          //set P2.0 as simple I/O
-    P2->SEL0 &= ~BIT0;
-    P2->DIR |= BIT0;            //set P2.0 as output pins
+void main(void) {
 
-    P4->SEL0 |= BIT3;           // set MCLK out for measurement of clock speed
-    P4->SEL1 &= ~BIT3;
-    P4->DIR |= BIT3;
+    var_type mainVar = 0;
+    uint16_t run;
+    uint8_t clock;
 
-    P2->OUT |= BIT0;            // turn on Blue LED
-    mainVar = TestFunction(15); // test function for timing
-    P2->OUT &= ~BIT0;           // turn off Blue LED
+    WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;   // Stop watchdog timer
 
-    while(1)       // infinite loop to do nothing
-        mainVar++; // increment mainVar to eliminate not used warning
+    PIN_apply(timing_pins, PIN_COUNT(timing_pins));     // MCLK out on P4.3
+
+    CLOCK_set_profile(3000000);
+    CLOCK_flash_buffer(CLOCK_BUFFER_INSTR | CLOCK_BUFFER_DATA);
+    UART_init();
+    CLOCK_register(uartClock);  // keep 115200 baud as SMCLK changes
+    LOG_init();
+    BENCH_init();
+    ISRBENCH_init();
+    __enable_irq();             // UART sends in the background
+
+    for (clock = 0; clock < sizeof(clocks) / sizeof(clocks[0]); clock++) {
+        CLOCK_set_profile(clocks[clock] * 1000000);
+        CYC_init();             // start CYCCNT, measure CYC_TIME overhead
+
+        __disable_irq();        // nothing else running while timing
+        CYC_reset(&call_site);
+        CYC_reset(&op_site);
+        for (run = 0; run < RUNS; run++) {
+            CYC_TIME(call_site) {
+                mainVar += TestCall(15);        // call and return only
+            }
+        }
+        for (run = 0; run < RUNS; run++)
+            mainVar += TestFunction(15);        // op_site is inside
+        BENCH_run();
+        __enable_irq();
+        ISRBENCH_run();         // needs interrupts, UART is idle here
+
+        BENCH_report(clocks[clock]);
+        ISRBENCH_report(clocks[clock]);
+        CYC_report(&call_site);
+        CYC_report(&op_site);
+    }
+
+    while(1)       // sleep once the report is sent
+        __sleep();
 }
 
 // Function used to measure the execution time for function call / return
@@ -50,12 +90,32 @@ var_type TestFunction(var_type num) {
 
     var_type testVar;
 
-    P1->OUT |= BIT0;    // turn RED LED on
+    CYC_TIME(op_site) {
+        /* Replace this line with the operation to be measured */
+        testVar = (num);
+        /*******************************************************/
+    }
+
+    return testVar;
+}
+
+// Function with the work of TestFunction and no site inside, the call
+// and return are timed on their own. Not inlined so the call is made.
+__attribute__((noinline)) var_type TestCall(var_type num) {
+
+    var_type testVar;
 
-    /* Replace this line with the operation to be measured */
     testVar = (num);
-    /*******************************************************/
 
-    P1->OUT &= ~BIT0;   // turn RED LED off
     return testVar;
 }
+
+// Clock change notify for the UART, finish sending at the old baud rate
+// and set the dividers for the new SMCLK
+void uartClock(uint8_t event, uint32_t mclk, uint32_t smclk) {
+
+    if (event == CLOCK_BEFORE)
+        while (!UART_tx_idle());
+    else
+        UART_set_clock(smclk);
+}
@@ -3,108 +3,158 @@
 //
 //  Simple Vending Machine Example -
 //    4 states - Idle / Count_Money / Vending / Change
-//    3 events - Input_Money / Make_Selection / Coin_Return
+//    5 events - Input_Money / Make_Selection / Coin_Return /
+//               Dispense_Done / Change_Done
 //
 //  This is not a complete program. It is meant to be used as
 //  an example framework to show a method for creating an FSM
-//  in C using enum types and switch statements. The FSM events
-//  are driven by interrupts.
+//  in C using a const transition table (see fsm_engine.h). The FSM events
+//  are driven by interrupts that post into the FSM event queue,
+//  the main loop runs the queued events and sleeps.
 //
 //  Paul Hummel
 //***************************************************************************************
+
+#include "msp.h"
 #include <stdint.h>
+#include "fsm_engine.h"
 
 enum states {
-  IDLE,
-  COUNT_MONEY,
-  VENDING,
-  CHANGE
-} state_type;
+  IDLE,             // waiting for money
+  COUNT_MONEY,      // money has been input, waiting for a selection
+  VENDING,          // dispensing a selection
+  CHANGE,           // returning money
+  STATE_COUNT
+};
 
 enum events {
-  INPUT_MONEY,
-  MAKE_SELECTION,
-  COIN_RETURN
-} event_type;
+  INPUT_MONEY,      // data is the amount input
+  MAKE_SELECTION,   // data is the selection
+  COIN_RETURN,
+  DISPENSE_DONE,    // dispenser finished
+  CHANGE_DONE,      // change return finished
+  EVENT_COUNT
+};
+
+// hardware interface, not part of this example
+uint32_t read_input(void);
+uint32_t read_selection(void);
+uint32_t price_lookup(uint32_t selection);
+void dispense(uint32_t selection);
+void return_change(uint32_t money);
+void display(uint32_t value);
+
+static uint32_t money = 0;
+
+static uint8_t count_money(uint8_t next, uint32_t data);
+static uint8_t show_price(uint8_t next, uint32_t data);
+static uint8_t vend(uint8_t next, uint32_t data);
+static uint8_t give_change(uint8_t next, uint32_t data);
+static uint8_t dispensed(uint8_t next, uint32_t data);
+
+// every pair that is not listed ignores the event
+static const FSM_transition vending_table[STATE_COUNT][EVENT_COUNT] = {
+  [IDLE][INPUT_MONEY]           = FSM_GO(COUNT_MONEY, count_money),
+  [IDLE][MAKE_SELECTION]        = FSM_GO(IDLE, show_price),
+
+  [COUNT_MONEY][INPUT_MONEY]    = FSM_GO(COUNT_MONEY, count_money),
+  [COUNT_MONEY][MAKE_SELECTION] = FSM_GO(VENDING, vend),
+  [COUNT_MONEY][COIN_RETURN]    = FSM_GO(CHANGE, give_change),
+
+  [VENDING][INPUT_MONEY]        = FSM_GO(VENDING, count_money),
+  [VENDING][DISPENSE_DONE]      = FSM_GO(CHANGE, dispensed),
+
+  [CHANGE][CHANGE_DONE]         = FSM_GO(IDLE, 0),
+};
 
+static FSM_machine vending;
 
 int main(void)
 {
-    state_type state = IDLE;
-    event_type event;
-    
-    uint32_t money;
+    FSM_INIT(vending, vending_table, IDLE);
+
+    __enable_irq();
 
     while (1)
     {
-      switch (state) {
-        case IDLE:                      // initial state
-          if (event = INPUT_MONEY) {    // if money input start counting
-            state = COUNT_MONEY;
-          } else if (event = MAKE_SELECTION) {  // if a selection is made
-            state = VENDING;
-          }
-          break;
-          
-        case COUNT_MONEY:
-          money += input_money;           // keep a total of input money
-          if (event = MAKE_SELECTION) {   // selection is made
-            state = VENDING;
-          } else if (event = COIN_RETURN){  // money return selected
-            state = CHANGE;
-          }
-          state = IDLE;   // after counting money, return to idle
-          break;
-        
-        case VENDING:
-          price = price_lookup(input_selection);  // lookup price
-          
-          if (price < money){
-            dispense(input_selection);  // dispense selection
-            money -= price;             // calculate change
-            state = CHANGE;             // go to dispense change
-          
-            
-          } else if (price = money){    // exact change given
-            dispense(input_selection);  // dispense selection
-            money = 0;                  // no change remaining
-            state = IDLE;
-          
-            
-          } else {              // not enough money
-            display(price);     // display cost
-            state = IDLE;
-          }
-          break;
-        
-        case CHANGE:
-          return_change(money);   // dispense change or money return
-          money = 0;              // reset money total
-          state = IDLE;           // go back to idle
-          break;
-        
-        default:  // failsafe
-          state = IDLE;
-          break;
-      }
-      
+      // check for events with interrupts off so one posted before
+      // __sleep() still wakes the CPU
+      __disable_irq();
+      if (!FSM_pending(&vending))
+        __sleep();
+      __enable_irq();
+
+      FSM_run(&vending);
     }
+}
+
+// keep a total of input money
+static uint8_t count_money(uint8_t next, uint32_t data)
+{
+  money += data;
+  return next;
+}
 
+// selection made without any money, display cost
+static uint8_t show_price(uint8_t next, uint32_t data)
+{
+  display(price_lookup(data));
+  return next;
+}
+
+// selection made, dispense it only if enough money has been input
+static uint8_t vend(uint8_t next, uint32_t data)
+{
+  uint32_t price = price_lookup(data);  // lookup price
+
+  if (price > money) {        // not enough money
+    display(price);           // display cost
+    return COUNT_MONEY;       // keep the money and wait
+  }
+
+  dispense(data);             // dispense selection
+  money -= price;             // calculate change
+  return next;
+}
+
+// dispensing finished, return any change
+static uint8_t dispensed(uint8_t next, uint32_t data)
+{
+  if (money == 0)             // exact change given
+    return IDLE;
+
+  return give_change(next, data);
+}
+
+// dispense change or money return
+static uint8_t give_change(uint8_t next, uint32_t data)
+{
+  return_change(money);
+  money = 0;                  // reset money total
+  return next;
 }
 
 // Interrupt on money interface
 void MoneyIRQ(void) {
-  event = INPUT_MONEY;
-  input_money = read_input();
+  FSM_post(&vending, INPUT_MONEY, read_input());
 }
 
 // Interrupt on selection panel
 void SelectionIRQ(void) {
-  event = MAKE_SELECTION;
-  input_selection = read_selection();
+  FSM_post(&vending, MAKE_SELECTION, read_selection());
 }
 
 // Interrupt for coin return
 void CoinReturnIRQ(void) {
-  event = COIN_RETURN;
+  FSM_post(&vending, COIN_RETURN, 0);
+}
+
+// Interrupt from the dispenser when the selection has dropped
+void DispenseDoneIRQ(void) {
+  FSM_post(&vending, DISPENSE_DONE, 0);
+}
+
+// Interrupt from the coin changer when all change is returned
+void ChangeDoneIRQ(void) {
+  FSM_post(&vending, CHANGE_DONE, 0);
 }
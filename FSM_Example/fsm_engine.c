@@ -0,0 +1,103 @@
+//***************************************************************************************
+//  fsm_engine.c - Table driven Finite State Machine engine
+//
+//  The event queue has one consumer (FSM_run in main code) but any number
+//  of interrupts can post, and a higher priority interrupt can preempt a
+//  lower one in the middle of FSM_post. Claiming the slot is done with
+//  interrupts masked for a few instructions so two producers can not get
+//  the same slot. FSM_run never masks interrupts.
+//
+//  Paul Hummel
+//***************************************************************************************
+
+#include "msp.h"
+#include "fsm_engine.h"
+#include "../BSP/ramfunc.h"    // FSM_Example has no project for an include path
+
+#define QUEUE_MASK (FSM_QUEUE_SIZE - 1)
+
+// Function to set up a machine in its initial state with an empty queue.
+// table is num_states x num_events transitions, use FSM_INIT() to get the
+// sizes from the table.
+void FSM_init(FSM_machine* fsm, const FSM_transition* table,
+              uint8_t num_states, uint8_t num_events, uint8_t initial)
+{
+    fsm->table = table;
+    fsm->num_states = num_states;
+    fsm->num_events = num_events;
+    fsm->state = initial;
+    fsm->head = fsm->tail = 0;
+    fsm->dropped = 0;
+}
+
+// Function to queue an event, safe to call from any interrupt.
+// Returns 0 if the queue is full and the event was dropped.
+uint8_t FSM_post(FSM_machine* fsm, uint8_t event, uint32_t data)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint16_t head;
+
+    __disable_irq();
+
+    head = fsm->head;
+    if (((head + 1) & QUEUE_MASK) == fsm->tail) {   // queue full
+        fsm->dropped++;
+        __set_PRIMASK(primask);
+        return 0;
+    }
+
+    fsm->queue[head].event = event;
+    fsm->queue[head].data = data;
+    fsm->head = (head + 1) & QUEUE_MASK;    // publish after it is written
+
+    __set_PRIMASK(primask);
+
+    return 1;
+}
+
+// Function to run one event through the transition table right away.
+// Returns 1 if the event caused a transition, 0 if it was ignored.
+// FSM_dispatch and FSM_run run from SRAM, they are on every event's path.
+RAMFUNC uint8_t FSM_dispatch(FSM_machine* fsm, uint8_t event, uint32_t data)
+{
+    const FSM_transition* transition;
+    uint8_t next;
+
+    if ((event >= fsm->num_events) || (fsm->state >= fsm->num_states))
+        return 0;
+
+    transition = &fsm->table[fsm->state * fsm->num_events + event];
+    if (transition->target == 0)            // not listed, ignore event
+        return 0;
+
+    next = transition->target - 1;
+    if (transition->action)
+        next = transition->action(next, data);
+
+    fsm->state = next;
+
+    return 1;
+}
+
+// Function to dispatch every queued event, including events posted by the
+// actions while running. Returns the number of events handled.
+RAMFUNC uint16_t FSM_run(FSM_machine* fsm)
+{
+    uint16_t tail = fsm->tail;
+    uint16_t count = 0;
+
+    while (tail != fsm->head) {
+        FSM_dispatch(fsm, fsm->queue[tail].event, fsm->queue[tail].data);
+        tail = (tail + 1) & QUEUE_MASK;
+        fsm->tail = tail;                   // release the slot
+        count++;
+    }
+
+    return count;
+}
+
+// Returns 1 if there are events waiting in the queue
+uint8_t FSM_pending(FSM_machine* fsm)
+{
+    return fsm->tail != fsm->head;
+}
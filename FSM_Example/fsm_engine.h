@@ -0,0 +1,67 @@
+//***************************************************************************************
+//  fsm_engine.h - Table driven Finite State Machine engine
+//
+//  The states and events of a machine are enums ending in a count. The
+//  transitions are a const 2D table [state][event] built at compile time
+//  with designated initializers and FSM_GO(), any pair not listed is
+//  ignored. Dispatching an event is a single table lookup.
+//
+//      static const FSM_transition table[STATE_COUNT][EVENT_COUNT] = {
+//          [IDLE][START] = FSM_GO(RUNNING, start_motor),
+//          [RUNNING][STOP] = FSM_GO(IDLE, 0),
+//      };
+//
+//  The action is called with the event data and the target state and
+//  returns the state to actually move to, so it can also be a guard.
+//
+//  Events are posted into a queue with FSM_post() from any interrupt and
+//  run from main code with FSM_run(), so an event arriving while another
+//  is handled is not lost.
+//
+//  Paul Hummel
+//***************************************************************************************
+
+#ifndef FSM_ENGINE_H_
+#define FSM_ENGINE_H_
+
+#include <stdint.h>
+
+#define FSM_QUEUE_SIZE  16      // must be a power of 2
+
+typedef uint8_t (*FSM_action)(uint8_t next, uint32_t data);
+
+typedef struct {
+    uint8_t target;             // next state + 1, 0 = event ignored
+    FSM_action action;          // 0 for no action
+} FSM_transition;
+
+#define FSM_GO(state, action)   { (state) + 1, (action) }
+
+typedef struct {
+    uint8_t event;
+    uint32_t data;
+} FSM_event;
+
+typedef struct {
+    const FSM_transition* table;    // num_states * num_events entries
+    uint8_t num_states;
+    uint8_t num_events;
+    volatile uint8_t state;
+    FSM_event queue[FSM_QUEUE_SIZE];
+    volatile uint16_t head;         // written by FSM_post
+    volatile uint16_t tail;         // written by FSM_run
+    volatile uint16_t dropped;      // events lost with the queue full
+} FSM_machine;
+
+#define FSM_INIT(fsm, table, initial) \
+    FSM_init(&(fsm), &(table)[0][0], sizeof(table) / sizeof((table)[0]), \
+             sizeof((table)[0]) / sizeof((table)[0][0]), (initial))
+
+void FSM_init(FSM_machine* fsm, const FSM_transition* table,
+              uint8_t num_states, uint8_t num_events, uint8_t initial);
+uint8_t FSM_post(FSM_machine* fsm, uint8_t event, uint32_t data);
+uint8_t FSM_dispatch(FSM_machine* fsm, uint8_t event, uint32_t data);
+uint16_t FSM_run(FSM_machine* fsm);
+uint8_t FSM_pending(FSM_machine* fsm);
+
+#endif /* FSM_ENGINE_H_ */
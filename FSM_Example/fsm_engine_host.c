@@ -0,0 +1,198 @@
+//***************************************************************************************
+//  fsm_engine_host.c - PC test of fsm_engine.c against the model in Host/
+//
+//      gcc -O2 -I. -I../Host fsm_engine_host.c fsm_engine.c ../Host/msp_host.c
+//          -lm -o fsm_engine
+//
+//  Unit tests of the table lookup, ignored and out of range events, actions
+//  as guards, the queue order, events posted by actions, a full queue and
+//  PRIMASK around FSM_post. Then a TIMER_A0 interrupt posts events faster
+//  than main handles them, with main sleeping between FSM_run calls as
+//  FSM.c does, and every event must be handled or counted as dropped.
+//  Prints the events/s of FSM_dispatch and of FSM_post + FSM_run on the PC,
+//  where the PRIMASK calls of FSM_post go through the model. Exits with 1
+//  if a check fails.
+//
+//  Paul Hummel
+//***************************************************************************************
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <time.h>
+#include "msp.h"
+#include "fsm_engine.h"
+
+#define HANDLE_CYCLES   300     // MCLK cycles main takes per event
+#define POST_PERIOD     200     // SMCLK cycles between posts, faster than main
+#define FLOOD_EVENTS    5000
+#define BENCH_EVENTS    10000000
+
+enum states { A, B, C, STATE_COUNT };
+enum events { NEXT, BACK, GUARD, CHAIN, EVENT_COUNT };
+
+static uint32_t actions, last_data;
+static uint8_t last_next;
+static FSM_machine fsm;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static uint8_t record(uint8_t next, uint32_t data)
+{
+    actions++;
+    last_next = next;
+    last_data = data;
+    return next;
+}
+
+// goes to next only if data is set
+static uint8_t guard(uint8_t next, uint32_t data)
+{
+    return data ? next : A;
+}
+
+// posts a NEXT from inside FSM_run
+static uint8_t chain(uint8_t next, uint32_t data)
+{
+    FSM_post(&fsm, NEXT, data + 1);
+    return next;
+}
+
+static const FSM_transition table[STATE_COUNT][EVENT_COUNT] = {
+    [A][NEXT]  = FSM_GO(B, record),
+    [B][NEXT]  = FSM_GO(C, record),
+    [C][NEXT]  = FSM_GO(A, record),
+    [B][BACK]  = FSM_GO(A, 0),
+    [A][GUARD] = FSM_GO(C, guard),
+    [A][CHAIN] = FSM_GO(B, chain),
+};
+
+// the flood: TIMER_A0 posts, main handles
+static volatile uint32_t posts, posted, handled;
+static FSM_machine flood;
+
+static uint8_t slow(uint8_t next, uint32_t data)
+{
+    __delay_cycles(HANDLE_CYCLES);
+    handled++;
+    return next;
+}
+
+static const FSM_transition flood_table[1][1] = {
+    [0][0] = FSM_GO(0, slow),
+};
+
+void TA0_0_IRQHandler(void)
+{
+    TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+    if (posts < FLOOD_EVENTS) {
+        posts++;
+        posted += FSM_post(&flood, 0, posts);
+    }
+}
+
+static double seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+int main(void)
+{
+    uint32_t index, count;
+    volatile uint8_t sink = 0;
+    double start, dispatch_rate, queue_rate;
+
+    FSM_INIT(fsm, table, A);
+    check((fsm.num_states == STATE_COUNT) && (fsm.num_events == EVENT_COUNT), "FSM_INIT sizes");
+    check(fsm.state == A, "initial state");
+
+    // dispatch
+    check(FSM_dispatch(&fsm, NEXT, 7) && (fsm.state == B), "listed transition taken");
+    check((actions == 1) && (last_next == B) && (last_data == 7), "action gets the target and data");
+    check(!FSM_dispatch(&fsm, GUARD, 1) && (fsm.state == B), "unlisted event ignored");
+    check(!FSM_dispatch(&fsm, EVENT_COUNT, 0) && (fsm.state == B), "event out of range ignored");
+    check(FSM_dispatch(&fsm, BACK, 0) && (fsm.state == A), "transition with no action");
+    check(FSM_dispatch(&fsm, GUARD, 0) && (fsm.state == A), "guard keeps the state");
+    check(FSM_dispatch(&fsm, GUARD, 1) && (fsm.state == C), "guard lets the transition through");
+    fsm.state = STATE_COUNT;
+    check(!FSM_dispatch(&fsm, NEXT, 0), "state out of range ignored");
+    fsm.state = A;
+
+    // queue
+    actions = 0;
+    FSM_post(&fsm, NEXT, 1);
+    FSM_post(&fsm, NEXT, 2);
+    FSM_post(&fsm, NEXT, 3);
+    check(FSM_pending(&fsm), "FSM_pending with events queued");
+    check((FSM_run(&fsm) == 3) && (fsm.state == A) && (last_data == 3), "events run in order");
+    check(!FSM_pending(&fsm), "queue empty after FSM_run");
+    FSM_post(&fsm, CHAIN, 10);
+    check((FSM_run(&fsm) == 2) && (fsm.state == C) && (last_data == 11),
+          "event posted by an action runs in the same FSM_run");
+
+    for (count = 0; count < FSM_QUEUE_SIZE; count++)
+        if (!FSM_post(&fsm, BACK, 0))
+            break;
+    check((count == FSM_QUEUE_SIZE - 1) && (fsm.dropped == 1), "full queue drops and counts");
+    FSM_run(&fsm);
+
+    __disable_irq();
+    FSM_post(&fsm, BACK, 0);
+    check(__get_PRIMASK() == 1, "FSM_post leaves interrupts off");
+    __enable_irq();
+    FSM_post(&fsm, BACK, 0);
+    check(__get_PRIMASK() == 0, "FSM_post leaves interrupts on");
+    FSM_run(&fsm);
+
+    // the flood, main as in FSM.c
+    FSM_INIT(flood, flood_table, 0);
+    TIMER_A0->CCR[0] = POST_PERIOD - 1;
+    TIMER_A0->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    TIMER_A0->CTL = TIMER_A_CTL_SSEL__SMCLK | TIMER_A_CTL_MC__UP | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA0_0_IRQn) & 31);
+    while ((posts < FLOOD_EVENTS) || FSM_pending(&flood)) {
+        __disable_irq();
+        if (!FSM_pending(&flood))
+            __sleep();
+        __enable_irq();
+        FSM_run(&flood);
+    }
+    TIMER_A0->CTL = 0;
+    printf("flood: %u posted every %u cycles, %u handled (%u cycles each), %u dropped\n",
+           FLOOD_EVENTS, POST_PERIOD, handled, HANDLE_CYCLES, flood.dropped);
+    check(handled == posted, "every queued event handled");
+    check(posted + flood.dropped == FLOOD_EVENTS, "every event queued or counted as dropped");
+    check(flood.dropped > 0, "the flood fills the queue");
+
+    // events/s on the PC
+    fsm.state = A;
+    start = seconds();
+    for (index = 0; index < BENCH_EVENTS; index++)
+        sink += FSM_dispatch(&fsm, NEXT, index);
+    dispatch_rate = BENCH_EVENTS / (seconds() - start);
+
+    start = seconds();
+    for (index = 0; index < BENCH_EVENTS; index += 8) {
+        for (count = 0; count < 8; count++)
+            FSM_post(&fsm, NEXT, index + count);
+        FSM_run(&fsm);
+    }
+    queue_rate = BENCH_EVENTS / (seconds() - start);
+    printf("PC: FSM_dispatch %.1f M events/s, FSM_post + FSM_run %.1f M events/s\n",
+           dispatch_rate / 1e6, queue_rate / 1e6);
+    (void)sink;
+
+    return failed;
+}
+
+#endif
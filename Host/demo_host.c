@@ -0,0 +1,171 @@
+// Runs a project's main against the model in msp_host.c with the
+// LaunchPad around it: buttons, a capture input, a comparator input, an
+// ADC input, SPI loopback and a terminal on EUSCI_A0. From a project folder
+// with its own .c files and the BSP files from its .project, e.g. UART_Demo:
+//
+//      gcc -O2 -Dmain=app_main -I. -I../BSP -I../Host main.c ../BSP/uart.c
+//          ../BSP/system_msp432p401r.c ../Host/msp_host.c ../Host/demo_host.c
+//          -lm -Wno-unknown-pragmas -o demo && ./demo 2
+//
+// The argument is the simulated time in seconds (2 if not given). What the
+// UART sends goes to stdout, the run summary to stderr.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "msp.h"
+
+#undef main
+
+extern void app_main(void);
+extern void SystemInit(void) __attribute__((weak));
+extern void BOOT_start(void) __attribute__((weak));
+extern void BOOT_clock(void) __attribute__((weak));
+
+#define US          (HOST_PS / 1000000)
+#define MS          (HOST_PS / 1000)
+
+static uint32_t port_writes[12];
+static uint8_t port_last[12];
+static uint32_t uart_bytes;
+
+static void uart_tx(uint8_t uart, uint8_t byte)
+{
+    if (uart == 0) {
+        putchar(byte);
+        uart_bytes++;
+    }
+}
+
+static void port_out(uint8_t port, uint8_t out, uint8_t dir)
+{
+    if ((out & dir) != port_last[port]) {
+        port_last[port] = out & dir;
+        port_writes[port]++;
+    }
+}
+
+static uint8_t spi_loopback(uint8_t spi, uint8_t mosi)
+{
+    return mosi;
+}
+
+static uint16_t adc_sine(uint8_t channel)
+{
+    double t = (double)HOST_time() / HOST_PS;
+
+    return (uint16_t)(0x2000 + 0x1FFF * sin(2 * M_PI * 50 * t));
+}
+
+// S1 (P1.1) and S2 (P1.4) to ground with a pull-up, pressed in turn every
+// second with 3 bounces 50 us apart, held 200 ms
+static void button(void* arg)
+{
+    uintptr_t step = (uintptr_t)arg;
+    uint8_t pin = ((step / 8) & 1) ? 4 : 1;
+    uint64_t now = HOST_time();
+
+    switch (step % 8) {
+        case 0: case 2: case 4: case 6:
+            HOST_pin(1, pin, 0);
+            HOST_at(now + ((step % 8 == 6) ? 200 * MS : 50 * US), button, (void*)(step + 1));
+            break;
+        case 1: case 3: case 5:
+            HOST_pin(1, pin, -1);
+            HOST_at(now + 50 * US, button, (void*)(step + 1));
+            break;
+        default:
+            HOST_pin(1, pin, -1);
+            HOST_at(now + 800 * MS, button, (void*)(step + 1));
+            break;
+    }
+}
+
+// 1 kHz square wave on TA0 CCI2A (P2.5, TimerA_Capture)
+static void capture_input(void* arg)
+{
+    uintptr_t level = (uintptr_t)arg;
+
+    HOST_timer_input(0, 2, 0, (uint8_t)level);
+    HOST_at(HOST_time() + 500 * US, capture_input, (void*)(level ^ 1));
+}
+
+// 9 Hz square wave out of comparator C1 (Comp_Freq, Comparator_Demo)
+static void comparator_input(void* arg)
+{
+    uintptr_t level = (uintptr_t)arg;
+
+    HOST_comp_output(1, (uint8_t)level);
+    HOST_at(HOST_time() + HOST_PS / 18, comparator_input, (void*)(level ^ 1));
+}
+
+// a command typed at the terminal (UART_Demo)
+static void terminal(void* arg)
+{
+    const char* text = arg;
+
+    while (*text)
+        HOST_uart_rx(0, (uint8_t)*text++);
+}
+
+int main(int argc, char** argv)
+{
+    double seconds = (argc > 1) ? atof(argv[1]) : 2.0;
+    double sim, host, total;
+    clock_t start;
+    int code;
+    uint8_t port;
+
+    HOST_uart_tx = uart_tx;
+    HOST_port_out = port_out;
+    HOST_spi_byte = spi_loopback;
+    HOST_adc_input = adc_sine;
+
+    HOST_at(500 * MS, button, (void*)0);
+    HOST_at(0, capture_input, (void*)1);
+    HOST_at(0, comparator_input, (void*)1);
+    HOST_at(100 * MS, terminal, "RGBx\r");
+
+    HOST_end((uint64_t)(seconds * HOST_PS));
+    start = clock();
+
+    code = sigsetjmp(HOST_exit, 1);
+    if (!code) {
+        HOST_watchdog(1);               // a tick can end the run, HOST_exit is set
+        if (BOOT_start)
+            BOOT_start();
+        if (SystemInit)
+            SystemInit();
+        if (BOOT_clock)
+            BOOT_clock();
+        app_main();
+        fprintf(stderr, "host: main returned\n");
+    }
+
+    HOST_watchdog(0);
+    host = (double)(clock() - start) / CLOCKS_PER_SEC;
+    fflush(stdout);
+
+    sim = (double)HOST_time() / HOST_PS;
+    total = (double)(HOST_stats.busy + HOST_stats.isr + HOST_stats.sleep);
+    if (total == 0)
+        total = 1;
+    fprintf(stderr, "\nsimulated %.6f s in %.3f s, %llu MCLK cycles (%.1f M/s)\n",
+            sim, host, (unsigned long long)HOST_cycles(),
+            host > 0 ? HOST_cycles() / host / 1e6 : 0.0);
+    fprintf(stderr, "MCLK %u Hz, SMCLK %u Hz, ACLK %u Hz\n",
+            HOST_mclk(), HOST_smclk(), HOST_aclk());
+    fprintf(stderr, "main %.1f%%, ISRs %.1f%%, asleep %.1f%%\n",
+            100 * HOST_stats.busy / total, 100 * HOST_stats.isr / total,
+            100 * HOST_stats.sleep / total);
+    fprintf(stderr, "%u interrupts, %u DMA transfers, %u UART bytes, "
+            "%u TXBUF overruns, %u flash / VCORE errors\n",
+            HOST_stats.interrupts, HOST_stats.dma_transfers, uart_bytes,
+            HOST_stats.overruns, HOST_stats.flash_errors);
+    for (port = 1; port < 12; port++)
+        if (port_writes[port])
+            fprintf(stderr, "P%u output changes: %u\n", port, port_writes[port]);
+
+    return HOST_stats.flash_errors ? 1 : 0;
+}
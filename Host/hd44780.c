@@ -0,0 +1,196 @@
+// HD44780 LCD controller on the GPIO model in msp_host.c
+
+#include <stdio.h>
+#include <string.h>
+#include "msp.h"
+#include "hd44780.h"
+
+#define RS          BIT5        // P3.5
+#define RW          BIT6        // P3.6
+#define EN          BIT7        // P3.7
+
+#define NS          (HOST_PS / 1000000000)
+#define US          (HOST_PS / 1000000)
+
+#define E_HIGH      (450 * NS)  // PWEH
+#define E_CYCLE     (1000 * NS) // tcycE
+#define ADDR_SETUP  (60 * NS)   // tAS, RS / RW to E rise
+#define DATA_SETUP  (195 * NS)  // tDSW, data to E fall
+#define POWER_UP    (40000 * US)
+#define EXEC_LONG   (1520 * US) // clear display, return home
+#define EXEC        (37 * US)
+
+#define PRINT_ERRORS 10
+
+HD44780_state HD44780;
+
+static void (*next_port_out)(uint8_t port, uint8_t out, uint8_t dir);
+static uint8_t bus_port, bus_four_bit;
+static uint8_t control, data;
+static uint64_t power_time, control_time, data_time, rise_time;
+static uint64_t busy_until;
+static uint8_t upper, have_upper;           // first nibble in 4-bit mode
+static uint8_t ddram[0x80];
+static uint8_t increment, to_cgram;
+static uint32_t printed;
+
+static void error(uint32_t* count, const char* what, uint64_t value)
+{
+    (*count)++;
+    if (printed++ < PRINT_ERRORS)
+        printf("hd44780: %s (%.3f us) at %.6f ms\n", what, (double)value / US,
+               (double)HOST_time() / (1000 * US));
+}
+
+// address counter step with the 2-line wrap 0x27 -> 0x40 -> 0x67 -> 0x00
+static uint8_t step(uint8_t address, uint8_t up)
+{
+    if (!HD44780.two_line)
+        return up ? (address + 1) % 80 : (address + 79) % 80;
+    if (up)
+        return (address == 0x27) ? 0x40 : (address == 0x67) ? 0x00 : address + 1;
+    return (address == 0x40) ? 0x27 : (address == 0x00) ? 0x67 : address - 1;
+}
+
+static void instruction(uint8_t byte)
+{
+    uint64_t run = EXEC;
+
+    HD44780.instructions++;
+    if (byte & 0x80) {                      // set DDRAM address
+        HD44780.address = byte & 0x7F;
+        to_cgram = 0;
+    }
+    else if (byte & 0x40)                   // set CGRAM address
+        to_cgram = 1;
+    else if (byte & 0x20) {                 // function set
+        HD44780.four_bit = !(byte & 0x10);
+        HD44780.two_line = (byte & 0x08) != 0;
+    }
+    else if (byte & 0x10) {                 // cursor or display shift
+        if (!(byte & 0x08))                 // cursor, right if R/L
+            HD44780.address = step(HD44780.address, (byte & 0x04) != 0);
+    }
+    else if (byte & 0x08)                   // display on / off control
+        HD44780.display_on = (byte & 0x04) != 0;
+    else if (byte & 0x04)                   // entry mode set
+        increment = (byte & 0x02) != 0;
+    else if (byte & 0x02) {                 // return home
+        HD44780.address = 0;
+        to_cgram = 0;
+        run = EXEC_LONG;
+    }
+    else if (byte & 0x01) {                 // clear display
+        memset(ddram, ' ', sizeof(ddram));
+        HD44780.address = 0;
+        increment = 1;
+        to_cgram = 0;
+        run = EXEC_LONG;
+    }
+    busy_until = HOST_time() + run;
+}
+
+static void write_data(uint8_t byte)
+{
+    HD44780.characters++;
+    if (!to_cgram) {
+        ddram[HD44780.address] = byte;
+        HD44780.address = step(HD44780.address, increment);
+    }
+    busy_until = HOST_time() + EXEC;
+}
+
+// E fell: latch the bus and run the byte once it is complete
+static void latch(void)
+{
+    uint64_t now = HOST_time();
+    uint8_t bits = bus_four_bit ? (data & 0xF0) : data;
+    uint8_t byte;
+
+    HD44780.transfers++;
+    if (now - data_time < DATA_SETUP)
+        error(&HD44780.timing_errors, "data setup", now - data_time);
+    if (control & RW)
+        return;                             // a read, the drivers never do
+
+    if (HD44780.four_bit && !have_upper) {
+        upper = bits & 0xF0;
+        have_upper = 1;
+        return;
+    }
+    byte = HD44780.four_bit ? (upper | (bits >> 4)) : bits;
+    have_upper = 0;
+
+    if (control & RS)
+        write_data(byte);
+    else
+        instruction(byte);
+}
+
+static void port_out(uint8_t port, uint8_t out, uint8_t dir)
+{
+    uint64_t now = HOST_time();
+    uint8_t old;
+
+    if (port == bus_port) {
+        if (out != data)
+            data_time = now;
+        data = out;
+    }
+    if (port == 3) {
+        old = control;
+        control = out & (RS | RW | EN);
+        if ((old ^ control) & (RS | RW))
+            control_time = now;
+
+        if (!(old & EN) && (control & EN)) {
+            if (now - power_time < POWER_UP)
+                error(&HD44780.timing_errors, "E before the 40 ms power up", now - power_time);
+            if (rise_time && (now - rise_time < E_CYCLE))
+                error(&HD44780.timing_errors, "E cycle", now - rise_time);
+            if (now - control_time < ADDR_SETUP)
+                error(&HD44780.timing_errors, "RS / RW setup", now - control_time);
+            if ((!HD44780.four_bit || !have_upper) && (now < busy_until))
+                error(&HD44780.busy_errors, "byte started while busy", busy_until - now);
+            rise_time = now;
+        }
+        if ((old & EN) && !(control & EN)) {
+            if (now - rise_time < E_HIGH)
+                error(&HD44780.timing_errors, "E high", now - rise_time);
+            latch();
+        }
+    }
+
+    if (next_port_out)
+        next_port_out(port, out, dir);
+}
+
+void HD44780_attach(uint8_t data_port, uint8_t four_bit)
+{
+    if (HOST_port_out != port_out)
+        next_port_out = HOST_port_out;
+    HOST_port_out = port_out;
+
+    bus_port = data_port;
+    bus_four_bit = four_bit;
+    power_time = HOST_time();
+    control_time = data_time = power_time;
+    rise_time = 0;
+    busy_until = 0;
+    have_upper = 0;
+    control = data = 0;
+    printed = 0;
+
+    memset(&HD44780, 0, sizeof(HD44780));   // power on reset: 8-bit, 1 line, off
+    memset(ddram, ' ', sizeof(ddram));
+    increment = 1;
+    to_cgram = 0;
+}
+
+void HD44780_row(uint8_t row, char* text)
+{
+    static const uint8_t start[HD44780_ROWS] = { 0x00, 0x40, 0x14, 0x54 };
+
+    memcpy(text, &ddram[start[row & 3]], HD44780_COLS);
+    text[HD44780_COLS] = 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * hd44780.h
+ *
+ *  HD44780 character LCD on the GPIO model, for the LCD host tests
+ *
+ *  RS, RW and E are P3.5 - P3.7 as on both LCD projects, the data bus is
+ *  the upper 4 bits of a port in 4-bit wiring or all 8 bits. The
+ *  controller starts in 8-bit mode after its power on reset. Each byte
+ *  is latched on the falling edge of E and run as on the chip: DDRAM
+ *  with the 2-line address wrap, the address counter, entry mode,
+ *  display control and function set. CGRAM writes are counted and
+ *  dropped.
+ *
+ *  Timing is checked against the datasheet at 3 V: E high >= 450 ns, E
+ *  cycle >= 1000 ns, RS / RW setup >= 60 ns before E rises, data setup
+ *  >= 195 ns before E falls, nothing sent in the first 40 ms after
+ *  power up, and no byte started while the last one is still running
+ *  (1.52 ms for clear and home, 37 us for everything else). The first
+ *  errors are printed.
+ */
+
+#ifndef HD44780_H_
+#define HD44780_H_
+
+#include <stdint.h>
+
+#define HD44780_ROWS    4
+#define HD44780_COLS    20
+
+typedef struct {
+    uint32_t instructions;      // commands run
+    uint32_t characters;        // data bytes written
+    uint32_t transfers;         // E falling edges, 2 per byte in 4-bit mode
+    uint32_t timing_errors;     // E width, E cycle, setup or power up
+    uint32_t busy_errors;       // byte started before the last one finished
+    uint8_t four_bit;           // DL = 0
+    uint8_t two_line;           // N = 1
+    uint8_t display_on;         // D = 1
+    uint8_t address;            // address counter
+} HD44780_state;
+
+extern HD44780_state HD44780;
+
+// Function to put the LCD on data_port (4-bit wiring on bits 7 - 4 if
+// four_bit) and P3, powered up now. Takes HOST_port_out and passes every
+// write on to the handler that was there.
+void HD44780_attach(uint8_t data_port, uint8_t four_bit);
+
+// Function to read a row of a 4 x 20 display (DDRAM 0x00, 0x40, 0x14,
+// 0x54) into text, COLS characters and a 0
+void HD44780_row(uint8_t row, char* text);
+
+#endif /* HD44780_H_ */
@@ -0,0 +1,1187 @@
+/*
+ * msp.h
+ *
+ *  MSP432P401R register map for PC builds, backed by the model in msp_host.c
+ *
+ *  The projects and BSP/ include "msp.h" and use the TI names (P1->OUT,
+ *  EUSCI_A0->TXBUF, ADC14->MEM[0], ...). Built with gcc with Host/ on the
+ *  include path this file is found in place of the TI header:
+ *
+ *      gcc -O2 -I. -I../BSP -I../Host ... ../Host/msp_host.c
+ *
+ *  The register structs have the TI layout and live in arrays in
+ *  msp_host.c at the same offsets as on the part. Each instance macro
+ *  (P1, TIMER_A0, CS, ...) calls HOST_io, which brings the model up to
+ *  date before the access:
+ *
+ *    - registers written since the last access are passed to the model of
+ *      their peripheral, found by comparing each block with a copy, so a
+ *      write of the value a register already holds is not seen (a second
+ *      Timer32 LOAD of the same count does not restart it)
+ *    - simulated time moves on HOST_ACCESS_CYCLES MCLK cycles, timers
+ *      count, UART bytes go out, DMA moves data
+ *    - a pending interrupt that is enabled and not masked runs its
+ *      *_IRQHandler (or the handler given to IRQ_register) right there
+ *
+ *  So a program runs as it would on the part, with time passing only when
+ *  it touches the hardware, in __delay_cycles and in __sleep. Plain
+ *  computing takes no simulated time, use host timing for that.
+ *
+ *  Side effects of a read are done with the member names RXBUF and CTRL,
+ *  which are 1 element arrays indexed by HOST_read(): RXBUF clears RXIFG
+ *  and SysTick CTRL clears COUNTFLAG. BITBAND_PERI gives a cell that is
+ *  written back to the register bit at the next access.
+ *
+ *  Pointers are 64 bits on the PC, so DMA_Control->CTLBASE is uintptr_t
+ *  here and DMA descriptors hold host pointers.
+ */
+
+#ifndef HOST_MSP_H_
+#define HOST_MSP_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+#define __MSP432P401R__
+#define __FPU_USED          1
+#define __NVIC_PRIO_BITS    3
+
+/******************************************************************************
+* Interrupt numbers                                                           *
+******************************************************************************/
+
+typedef enum IRQn {
+    NonMaskableInt_IRQn   = -14,
+    HardFault_IRQn        = -13,
+    MemoryManagement_IRQn = -12,
+    BusFault_IRQn         = -11,
+    UsageFault_IRQn       = -10,
+    SVCall_IRQn           = -5,
+    DebugMonitor_IRQn     = -4,
+    PendSV_IRQn           = -2,
+    SysTick_IRQn          = -1,
+    PSS_IRQn              = 0,
+    CS_IRQn               = 1,
+    PCM_IRQn              = 2,
+    WDT_A_IRQn            = 3,
+    FPU_IRQn              = 4,
+    FLCTL_IRQn            = 5,
+    COMP_E0_IRQn          = 6,
+    COMP_E1_IRQn          = 7,
+    TA0_0_IRQn            = 8,
+    TA0_N_IRQn            = 9,
+    TA1_0_IRQn            = 10,
+    TA1_N_IRQn            = 11,
+    TA2_0_IRQn            = 12,
+    TA2_N_IRQn            = 13,
+    TA3_0_IRQn            = 14,
+    TA3_N_IRQn            = 15,
+    EUSCIA0_IRQn          = 16,
+    EUSCIA1_IRQn          = 17,
+    EUSCIA2_IRQn          = 18,
+    EUSCIA3_IRQn          = 19,
+    EUSCIB0_IRQn          = 20,
+    EUSCIB1_IRQn          = 21,
+    EUSCIB2_IRQn          = 22,
+    EUSCIB3_IRQn          = 23,
+    ADC14_IRQn            = 24,
+    T32_INT1_IRQn         = 25,
+    T32_INT2_IRQn         = 26,
+    T32_INTC_IRQn         = 27,
+    AES256_IRQn           = 28,
+    RTC_C_IRQn            = 29,
+    DMA_ERR_IRQn          = 30,
+    DMA_INT3_IRQn         = 31,
+    DMA_INT2_IRQn         = 32,
+    DMA_INT1_IRQn         = 33,
+    DMA_INT0_IRQn         = 34,
+    PORT1_IRQn            = 35,
+    PORT2_IRQn            = 36,
+    PORT3_IRQn            = 37,
+    PORT4_IRQn            = 38,
+    PORT5_IRQn            = 39,
+    PORT6_IRQn            = 40
+} IRQn_Type;
+
+/******************************************************************************
+* Register blocks                                                             *
+******************************************************************************/
+
+typedef struct {
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t LO0;
+    __IO uint32_t HI0;
+    __IO uint32_t LO1;
+    __IO uint32_t HI1;
+    __IO uint32_t MCTL[32];
+    __IO uint32_t MEM[32];
+    uint32_t RESERVED0[9];
+    __IO uint32_t IER0;
+    __IO uint32_t IER1;
+    __I  uint32_t IFGR0;
+    __I  uint32_t IFGR1;
+    __O  uint32_t CLRIFGR0;
+    __IO uint32_t CLRIFGR1;
+    __I  uint32_t IV;
+} ADC14_Type;
+
+typedef struct {
+    __IO uint16_t CTL0;
+    __IO uint16_t CTL1;
+    __IO uint16_t CTL2;
+    __IO uint16_t CTL3;
+    uint16_t RESERVED0[2];
+    __IO uint16_t INT;
+    __I  uint16_t IV;
+} COMP_E_Type;
+
+typedef struct {
+    __IO uint32_t KEY;
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t CTL2;
+    __IO uint32_t CTL3;
+    uint32_t RESERVED0[7];
+    __IO uint32_t CLKEN;
+    __I  uint32_t STAT;
+    uint32_t RESERVED1[2];
+    __IO uint32_t IE;
+    uint32_t RESERVED2;
+    __I  uint32_t IFG;
+    uint32_t RESERVED3;
+    __O  uint32_t CLRIFG;
+    uint32_t RESERVED4;
+    __O  uint32_t SETIFG;
+    uint32_t RESERVED5;
+    __IO uint32_t DCOERCAL0;
+    __IO uint32_t DCOERCAL1;
+} CS_Type;
+
+typedef struct {
+    __I  uint16_t IN;
+    __IO uint16_t OUT;
+    __IO uint16_t DIR;
+    __IO uint16_t REN;
+    __IO uint16_t DS;
+    __IO uint16_t SEL0;
+    __IO uint16_t SEL1;
+    __I  uint16_t IV_L;
+    uint16_t RESERVED0[3];
+    __IO uint16_t SELC;
+    __IO uint16_t IES;
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV_H;
+} DIO_PORT_Interruptable_Type;
+
+typedef struct {
+    __I  uint16_t IN;
+    __IO uint16_t OUT;
+    __IO uint16_t DIR;
+    __IO uint16_t REN;
+    __IO uint16_t DS;
+    __IO uint16_t SEL0;
+    __IO uint16_t SEL1;
+    uint16_t RESERVED0[4];
+    __IO uint16_t SELC;
+} DIO_PORT_Not_Interruptable_Type;
+
+typedef struct {
+    __I  uint8_t IN;
+    uint8_t RESERVED0;
+    __IO uint8_t OUT;
+    uint8_t RESERVED1;
+    __IO uint8_t DIR;
+    uint8_t RESERVED2;
+    __IO uint8_t REN;
+    uint8_t RESERVED3;
+    __IO uint8_t DS;
+    uint8_t RESERVED4;
+    __IO uint8_t SEL0;
+    uint8_t RESERVED5;
+    __IO uint8_t SEL1;
+    uint8_t RESERVED6;
+    __I  uint16_t IV;
+    uint8_t RESERVED7[6];
+    __IO uint8_t SELC;
+    uint8_t RESERVED8;
+    __IO uint8_t IES;
+    uint8_t RESERVED9;
+    __IO uint8_t IE;
+    uint8_t RESERVED10;
+    __IO uint8_t IFG;
+    uint8_t RESERVED11;
+} DIO_PORT_Odd_Interruptable_Type;
+
+typedef struct {
+    uint8_t RESERVED0;
+    __I  uint8_t IN;
+    uint8_t RESERVED1;
+    __IO uint8_t OUT;
+    uint8_t RESERVED2;
+    __IO uint8_t DIR;
+    uint8_t RESERVED3;
+    __IO uint8_t REN;
+    uint8_t RESERVED4;
+    __IO uint8_t DS;
+    uint8_t RESERVED5;
+    __IO uint8_t SEL0;
+    uint8_t RESERVED6;
+    __IO uint8_t SEL1;
+    uint8_t RESERVED7[9];
+    __IO uint8_t SELC;
+    uint8_t RESERVED8;
+    __IO uint8_t IES;
+    uint8_t RESERVED9;
+    __IO uint8_t IE;
+    uint8_t RESERVED10;
+    __IO uint8_t IFG;
+    __I  uint16_t IV;
+} DIO_PORT_Even_Interruptable_Type;
+
+// eUSCI_A and eUSCI_B RXBUF is RXBUF_[1] so a read can clear RXIFG
+typedef struct {
+    __IO uint16_t CTLW0;
+    __IO uint16_t CTLW1;
+    uint16_t RESERVED0;
+    __IO uint16_t BRW;
+    __IO uint16_t MCTLW;
+    __IO uint16_t STATW;
+    __I  uint16_t RXBUF_[1];
+    __IO uint16_t TXBUF;
+    __IO uint16_t ABCTL;
+    __IO uint16_t IRCTL;
+    uint16_t RESERVED1[3];
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV;
+} EUSCI_A_Type;
+
+typedef struct {
+    __IO uint16_t CTLW0;
+    __IO uint16_t CTLW1;
+    uint16_t RESERVED0;
+    __IO uint16_t BRW;
+    __IO uint16_t STATW;
+    __IO uint16_t TBCNT;
+    __I  uint16_t RXBUF_[1];
+    __IO uint16_t TXBUF;
+    uint16_t RESERVED1[2];
+    __IO uint16_t I2COA0;
+    __IO uint16_t I2COA1;
+    __IO uint16_t I2COA2;
+    __IO uint16_t I2COA3;
+    __I  uint16_t ADDRX;
+    __IO uint16_t ADDMASK;
+    __IO uint16_t I2CSA;
+    uint16_t RESERVED2[4];
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV;
+} EUSCI_B_Type;
+
+#define RXBUF   RXBUF_[HOST_read(HOST_READ_RXBUF)]
+
+typedef struct {
+    __IO uint32_t POWER_STAT;
+    uint32_t RESERVED0[3];
+    __IO uint32_t BANK0_RDCTL;
+    __IO uint32_t BANK1_RDCTL;
+} FLCTL_Type;
+
+typedef struct {
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t IE;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+} PCM_Type;
+
+typedef struct {
+    __IO uint16_t KEYID;
+    __IO uint16_t CTL;
+} PMAP_COMMON_Type;
+
+typedef struct {
+    __IO uint32_t REBOOT_CTL;
+    __IO uint32_t NMI_CTLSTAT;
+    __IO uint32_t WDTRESET_CTL;
+    __IO uint32_t PERIHALT_CTL;
+    __I  uint32_t SRAM_SIZE;
+    __IO uint32_t SRAM_BANKEN;
+    __IO uint32_t SRAM_BANKRET;
+} SYSCTL_Type;
+
+typedef struct {
+    __IO uint32_t LOAD;
+    __I  uint32_t VALUE;
+    __IO uint32_t CONTROL;
+    __O  uint32_t INTCLR;
+    __I  uint32_t RIS;
+    __I  uint32_t MIS;
+    __IO uint32_t BGLOAD;
+} Timer32_Type;
+
+typedef struct {
+    __IO uint16_t CTL;
+    __IO uint16_t CCTL[7];
+    __IO uint16_t R;
+    __IO uint16_t CCR[7];
+    __IO uint16_t EX0;
+    uint16_t RESERVED0[6];
+    __I  uint16_t IV;
+} Timer_A_Type;
+
+typedef struct {
+    uint16_t RESERVED0[6];
+    __IO uint16_t CTL;
+} WDT_A_Type;
+
+typedef struct {
+    __I  uint32_t DEVICE_CFG;
+    __O  uint32_t SW_CHTRIG;
+    uint32_t RESERVED0[2];
+    __IO uint32_t CH_SRCCFG[32];
+    uint32_t RESERVED1[28];
+    __IO uint32_t INT1_SRCCFG;
+    __IO uint32_t INT2_SRCCFG;
+    __IO uint32_t INT3_SRCCFG;
+    uint32_t RESERVED2;
+    __I  uint32_t INT0_SRCFLG;
+    __O  uint32_t INT0_CLRFLG;
+} DMA_Channel_Type;
+
+typedef struct {
+    __I  uint32_t STAT;
+    __O  uint32_t CFG;
+    __IO uintptr_t CTLBASE;             // uint32_t on the part
+    __I  uintptr_t ALTBASE;
+    __I  uint32_t WAITSTAT;
+    __O  uint32_t SWREQ;
+    __IO uint32_t USEBURSTSET;
+    __O  uint32_t USEBURSTCLR;
+    __IO uint32_t REQMASKSET;
+    __O  uint32_t REQMASKCLR;
+    __IO uint32_t ENASET;
+    __O  uint32_t ENACLR;
+    __IO uint32_t ALTSET;
+    __O  uint32_t ALTCLR;
+    __IO uint32_t PRIOSET;
+    __O  uint32_t PRIOCLR;
+    uint32_t RESERVED4[3];
+    __IO uint32_t ERRCLR;
+} DMA_Control_Type;
+
+// device descriptor table, only the DCO calibration is used
+typedef struct {
+    __I  uint32_t DCOIR_FCAL_RSEL04;
+    __I  uint32_t DCOIR_FCAL_RSEL5;
+    __I  uint32_t DCOIR_CONSTK_RSEL04;
+    __I  uint32_t DCOIR_CONSTK_RSEL5;
+    __I  uint32_t DCOER_FCAL_RSEL04;
+    __I  uint32_t DCOER_FCAL_RSEL5;
+    __I  uint32_t DCOER_CONSTK_RSEL04;
+    __I  uint32_t DCOER_CONSTK_RSEL5;
+} TLV_Type;
+
+// Cortex-M4 core blocks, SysTick and DWT CTRL is CTRL_[1] so a read can
+// clear COUNTFLAG
+typedef struct {
+    __IO uint32_t CTRL_[1];
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+#define CTRL    CTRL_[HOST_read(HOST_READ_CTRL)]
+
+typedef struct {
+    __IO uint32_t ISER[8];
+    uint32_t RESERVED0[24];
+    __IO uint32_t ICER[8];
+    uint32_t RSERVED1[24];
+    __IO uint32_t ISPR[8];
+    uint32_t RESERVED2[24];
+    __IO uint32_t ICPR[8];
+    uint32_t RESERVED3[24];
+    __IO uint32_t IABR[8];
+    uint32_t RESERVED4[56];
+    __IO uint8_t  IP[240];
+    uint32_t RESERVED5[644];
+    __O  uint32_t STIR;
+} NVIC_Type;
+
+typedef struct {
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __IO uint32_t CCR;
+    __IO uint8_t  SHP[12];
+    __IO uint32_t SHCSR;
+    __IO uint32_t CFSR;
+    __IO uint32_t HFSR;
+    __IO uint32_t DFSR;
+    __IO uint32_t MMFAR;
+    __IO uint32_t BFAR;
+    __IO uint32_t AFSR;
+    __I  uint32_t PFR[2];
+    __I  uint32_t DFR;
+    __I  uint32_t ADR;
+    __I  uint32_t MMFR[4];
+    __I  uint32_t ISAR[5];
+    uint32_t RESERVED0[5];
+    __IO uint32_t CPACR;
+} SCB_Type;
+
+typedef struct {
+    __IO uint32_t DHCSR;
+    __O  uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+    __IO uint32_t CTRL_[1];
+    __IO uint32_t CYCCNT;
+    __IO uint32_t CPICNT;
+    __IO uint32_t EXCCNT;
+    __IO uint32_t SLEEPCNT;
+    __IO uint32_t LSUCNT;
+    __IO uint32_t FOLDCNT;
+    __I  uint32_t PCSR;
+} DWT_Type;
+
+/******************************************************************************
+* Memory map, the same offsets as the part in host arrays                     *
+******************************************************************************/
+
+#define HOST_PERIPH_SIZE    0x13000     // 0x40000000 - 0x40012FFF
+#define HOST_SCS_SIZE       0x1000      // 0xE000E000 - 0xE000EFFF
+
+extern uint8_t HOST_periph[HOST_PERIPH_SIZE];
+extern uint8_t HOST_scs[HOST_SCS_SIZE];
+extern uint8_t HOST_dwt[0x100];
+extern uint8_t HOST_sysctl[0x100];
+extern const TLV_Type HOST_tlv;
+
+#define PERIPH_BASE         ((uintptr_t)HOST_periph)
+#define TIMER_A0_BASE       (PERIPH_BASE + 0x00000)
+#define TIMER_A1_BASE       (PERIPH_BASE + 0x00400)
+#define TIMER_A2_BASE       (PERIPH_BASE + 0x00800)
+#define TIMER_A3_BASE       (PERIPH_BASE + 0x00C00)
+#define EUSCI_A0_BASE       (PERIPH_BASE + 0x01000)
+#define EUSCI_A1_BASE       (PERIPH_BASE + 0x01400)
+#define EUSCI_A2_BASE       (PERIPH_BASE + 0x01800)
+#define EUSCI_A3_BASE       (PERIPH_BASE + 0x01C00)
+#define EUSCI_B0_BASE       (PERIPH_BASE + 0x02000)
+#define EUSCI_B1_BASE       (PERIPH_BASE + 0x02400)
+#define EUSCI_B2_BASE       (PERIPH_BASE + 0x02800)
+#define EUSCI_B3_BASE       (PERIPH_BASE + 0x02C00)
+#define COMP_E0_BASE        (PERIPH_BASE + 0x03400)
+#define COMP_E1_BASE        (PERIPH_BASE + 0x03800)
+#define WDT_A_BASE          (PERIPH_BASE + 0x04800)
+#define DIO_BASE            (PERIPH_BASE + 0x04C00)
+#define PMAP_BASE           (PERIPH_BASE + 0x05000)
+#define TIMER32_BASE        (PERIPH_BASE + 0x0C000)
+#define DMA_BASE            (PERIPH_BASE + 0x0E000)
+#define PCM_BASE            (PERIPH_BASE + 0x10000)
+#define CS_BASE             (PERIPH_BASE + 0x10400)
+#define FLCTL_BASE          (PERIPH_BASE + 0x11000)
+#define ADC14_BASE          (PERIPH_BASE + 0x12000)
+
+#define SCS_BASE            ((uintptr_t)HOST_scs)
+#define SysTick_BASE        (SCS_BASE + 0x0010)
+#define NVIC_BASE           (SCS_BASE + 0x0100)
+#define SCB_BASE            (SCS_BASE + 0x0D00)
+#define CoreDebug_BASE      (SCS_BASE + 0x0DF0)
+#define DWT_BASE            ((uintptr_t)HOST_dwt)
+#define SYSCTL_BASE         ((uintptr_t)HOST_sysctl)
+#define TLV_BASE            ((uintptr_t)&HOST_tlv)
+
+void* HOST_io(uintptr_t base);
+
+#define ADC14       ((ADC14_Type*) HOST_io(ADC14_BASE))
+#define COMP_E0     ((COMP_E_Type*) HOST_io(COMP_E0_BASE))
+#define COMP_E1     ((COMP_E_Type*) HOST_io(COMP_E1_BASE))
+#define CS          ((CS_Type*) HOST_io(CS_BASE))
+#define PA          ((DIO_PORT_Interruptable_Type*) HOST_io(DIO_BASE + 0x0000))
+#define PB          ((DIO_PORT_Interruptable_Type*) HOST_io(DIO_BASE + 0x0020))
+#define PC          ((DIO_PORT_Interruptable_Type*) HOST_io(DIO_BASE + 0x0040))
+#define PD          ((DIO_PORT_Interruptable_Type*) HOST_io(DIO_BASE + 0x0060))
+#define PE          ((DIO_PORT_Interruptable_Type*) HOST_io(DIO_BASE + 0x0080))
+#define PJ          ((DIO_PORT_Not_Interruptable_Type*) HOST_io(DIO_BASE + 0x0120))
+#define P1          ((DIO_PORT_Odd_Interruptable_Type*) HOST_io(DIO_BASE + 0x0000))
+#define P2          ((DIO_PORT_Even_Interruptable_Type*) HOST_io(DIO_BASE + 0x0000))
+#define P3          ((DIO_PORT_Odd_Interruptable_Type*) HOST_io(DIO_BASE + 0x0020))
+#define P4          ((DIO_PORT_Even_Interruptable_Type*) HOST_io(DIO_BASE + 0x0020))
+#define P5          ((DIO_PORT_Odd_Interruptable_Type*) HOST_io(DIO_BASE + 0x0040))
+#define P6          ((DIO_PORT_Even_Interruptable_Type*) HOST_io(DIO_BASE + 0x0040))
+#define P7          ((DIO_PORT_Odd_Interruptable_Type*) HOST_io(DIO_BASE + 0x0060))
+#define P8          ((DIO_PORT_Even_Interruptable_Type*) HOST_io(DIO_BASE + 0x0060))
+#define P9          ((DIO_PORT_Odd_Interruptable_Type*) HOST_io(DIO_BASE + 0x0080))
+#define P10         ((DIO_PORT_Even_Interruptable_Type*) HOST_io(DIO_BASE + 0x0080))
+#define DMA_Channel ((DMA_Channel_Type*) HOST_io(DMA_BASE))
+#define DMA_Control ((DMA_Control_Type*) HOST_io(DMA_BASE + 0x1000))
+#define EUSCI_A0    ((EUSCI_A_Type*) HOST_io(EUSCI_A0_BASE))
+#define EUSCI_A1    ((EUSCI_A_Type*) HOST_io(EUSCI_A1_BASE))
+#define EUSCI_A2    ((EUSCI_A_Type*) HOST_io(EUSCI_A2_BASE))
+#define EUSCI_A3    ((EUSCI_A_Type*) HOST_io(EUSCI_A3_BASE))
+#define EUSCI_B0    ((EUSCI_B_Type*) HOST_io(EUSCI_B0_BASE))
+#define EUSCI_B1    ((EUSCI_B_Type*) HOST_io(EUSCI_B1_BASE))
+#define EUSCI_B2    ((EUSCI_B_Type*) HOST_io(EUSCI_B2_BASE))
+#define EUSCI_B3    ((EUSCI_B_Type*) HOST_io(EUSCI_B3_BASE))
+#define FLCTL       ((FLCTL_Type*) HOST_io(FLCTL_BASE))
+#define PCM         ((PCM_Type*) HOST_io(PCM_BASE))
+#define PMAP        ((PMAP_COMMON_Type*) HOST_io(PMAP_BASE))
+#define SYSCTL      ((SYSCTL_Type*) HOST_io(SYSCTL_BASE))
+#define TIMER32_1   ((Timer32_Type*) HOST_io(TIMER32_BASE))
+#define TIMER32_2   ((Timer32_Type*) HOST_io(TIMER32_BASE + 0x0020))
+#define TIMER_A0    ((Timer_A_Type*) HOST_io(TIMER_A0_BASE))
+#define TIMER_A1    ((Timer_A_Type*) HOST_io(TIMER_A1_BASE))
+#define TIMER_A2    ((Timer_A_Type*) HOST_io(TIMER_A2_BASE))
+#define TIMER_A3    ((Timer_A_Type*) HOST_io(TIMER_A3_BASE))
+#define TLV         ((TLV_Type*) TLV_BASE)
+#define WDT_A       ((WDT_A_Type*) HOST_io(WDT_A_BASE))
+#define SysTick     ((SysTick_Type*) HOST_io(SysTick_BASE))
+#define NVIC        ((NVIC_Type*) HOST_io(NVIC_BASE))
+#define SCB         ((SCB_Type*) HOST_io(SCB_BASE))
+#define CoreDebug   ((CoreDebug_Type*) HOST_io(CoreDebug_BASE))
+#define DWT         ((DWT_Type*) HOST_io(DWT_BASE))
+
+volatile uint32_t* HOST_bitband(const volatile void* reg, uint8_t size, uint8_t bit);
+
+#define BITBAND_PERI(x, b)  (*HOST_bitband(&(x), sizeof(x), (b)))
+
+/******************************************************************************
+* Register bits used by the projects                                          *
+******************************************************************************/
+
+#define BIT0    0x0001
+#define BIT1    0x0002
+#define BIT2    0x0004
+#define BIT3    0x0008
+#define BIT4    0x0010
+#define BIT5    0x0020
+#define BIT6    0x0040
+#define BIT7    0x0080
+#define BIT8    0x0100
+#define BIT9    0x0200
+#define BITA    0x0400
+#define BITB    0x0800
+#define BITC    0x1000
+#define BITD    0x2000
+#define BITE    0x4000
+#define BITF    0x8000
+
+// ADC14
+#define ADC14_CTL0_SC               0x00000001
+#define ADC14_CTL0_ENC              0x00000002
+#define ADC14_CTL0_ON               0x00000010
+#define ADC14_CTL0_MSC              0x00000080
+#define ADC14_CTL0_SHT0_OFS         8
+#define ADC14_CTL0_SHT0_MASK        0x00000F00
+#define ADC14_CTL0_SHT0__4          0x00000000
+#define ADC14_CTL0_SHT0__8          0x00000100
+#define ADC14_CTL0_SHT0__16         0x00000200
+#define ADC14_CTL0_SHT0__32         0x00000300
+#define ADC14_CTL0_SHT0__64         0x00000400
+#define ADC14_CTL0_SHT0__96         0x00000500
+#define ADC14_CTL0_SHT0__128        0x00000600
+#define ADC14_CTL0_SHT0__192        0x00000700
+#define ADC14_CTL0_BUSY             0x00010000
+#define ADC14_CTL0_CONSEQ_OFS       17
+#define ADC14_CTL0_CONSEQ_MASK      0x00060000
+#define ADC14_CTL0_CONSEQ_0         0x00000000
+#define ADC14_CTL0_CONSEQ_1         0x00020000
+#define ADC14_CTL0_CONSEQ_2         0x00040000
+#define ADC14_CTL0_CONSEQ_3         0x00060000
+#define ADC14_CTL0_SSEL_OFS         19
+#define ADC14_CTL0_SSEL_MASK        0x00380000
+#define ADC14_CTL0_SSEL__MODCLK     0x00000000
+#define ADC14_CTL0_SSEL__SYSCLK     0x00080000
+#define ADC14_CTL0_SSEL__ACLK       0x00100000
+#define ADC14_CTL0_SSEL__MCLK       0x00180000
+#define ADC14_CTL0_SSEL__SMCLK      0x00200000
+#define ADC14_CTL0_SSEL__HSMCLK     0x00280000
+#define ADC14_CTL0_DIV_OFS          22
+#define ADC14_CTL0_DIV_MASK         0x01C00000
+#define ADC14_CTL0_SHP              0x04000000
+#define ADC14_CTL0_SHS_OFS          27
+#define ADC14_CTL0_SHS_MASK         0x38000000
+#define ADC14_CTL0_SHS_0            0x00000000
+#define ADC14_CTL0_SHS_1            0x08000000
+#define ADC14_CTL0_SHS_2            0x10000000
+#define ADC14_CTL0_SHS_3            0x18000000
+#define ADC14_CTL0_SHS_4            0x20000000
+#define ADC14_CTL0_SHS_5            0x28000000
+#define ADC14_CTL0_SHS_6            0x30000000
+#define ADC14_CTL0_SHS_7            0x38000000
+#define ADC14_CTL0_PDIV_OFS         30
+#define ADC14_CTL0_PDIV_MASK        0xC0000000
+#define ADC14_CTL1_RES_OFS          4
+#define ADC14_CTL1_RES_MASK         0x00000030
+#define ADC14_CTL1_RES_0            0x00000000
+#define ADC14_CTL1_RES_1            0x00000010
+#define ADC14_CTL1_RES_2            0x00000020
+#define ADC14_CTL1_RES_3            0x00000030
+#define ADC14_CTL1_CSTARTADD_OFS    16
+#define ADC14_CTL1_CSTARTADD_MASK   0x001F0000
+#define ADC14_MCTLN_INCH_OFS        0
+#define ADC14_MCTLN_INCH_MASK       0x0000001F
+#define ADC14_MCTLN_INCH_0          0x00000000
+#define ADC14_MCTLN_INCH_1          0x00000001
+#define ADC14_MCTLN_INCH_2          0x00000002
+#define ADC14_MCTLN_INCH_3          0x00000003
+#define ADC14_MCTLN_EOS             0x00000080
+#define ADC14_IER0_IE0              0x00000001
+#define ADC14_IFGR0_IFG0            0x00000001
+#define ADC14_CLRIFGR0_CLRIFG0      0x00000001
+
+// COMP_E
+#define COMP_E_CTL0_IPSEL_OFS       0
+#define COMP_E_CTL0_IPSEL_0         0x0000
+#define COMP_E_CTL0_IPSEL_1         0x0001
+#define COMP_E_CTL0_IPEN            0x0080
+#define COMP_E_CTL0_IMSEL_OFS       8
+#define COMP_E_CTL0_IMEN            0x8000
+#define COMP_E_CTL1_OUT             0x0001
+#define COMP_E_CTL1_OUTPOL          0x0002
+#define COMP_E_CTL1_F               0x0004
+#define COMP_E_CTL1_IES             0x0008
+#define COMP_E_CTL1_SHORT           0x0010
+#define COMP_E_CTL1_EX              0x0020
+#define COMP_E_CTL1_FDLY_0          0x0000
+#define COMP_E_CTL1_FDLY_1          0x0040
+#define COMP_E_CTL1_FDLY_2          0x0080
+#define COMP_E_CTL1_FDLY_3          0x00C0
+#define COMP_E_CTL1_ON              0x0400
+#define COMP_E_CTL2_REF0_OFS        0
+#define COMP_E_CTL2_REF0_MASK       0x001F
+#define COMP_E_CTL2_RSEL            0x0020
+#define COMP_E_CTL2_RS_OFS          6
+#define COMP_E_CTL2_RS_0            0x0000
+#define COMP_E_CTL2_RS_1            0x0040
+#define COMP_E_CTL2_RS_2            0x0080
+#define COMP_E_CTL2_RS_3            0x00C0
+#define COMP_E_CTL2_REF1_OFS        8
+#define COMP_E_CTL2_REF1_MASK       0x1F00
+#define COMP_E_CTL3_PD0             0x0001
+#define COMP_E_CTL3_PD1             0x0002
+#define COMP_E_INT_IFG              0x0001
+#define COMP_E_INT_IIFG             0x0002
+#define COMP_E_INT_IE               0x0100
+#define COMP_E_INT_IIE              0x0200
+
+// CS
+#define CS_KEY_VAL                  0x0000695A
+#define CS_CTL0_DCOTUNE_OFS         0
+#define CS_CTL0_DCOTUNE_MASK        0x000003FF
+#define CS_CTL0_DCORSEL_OFS         16
+#define CS_CTL0_DCORSEL_MASK        0x00070000
+#define CS_CTL0_DCORSEL_0           0x00000000
+#define CS_CTL0_DCORSEL_1           0x00010000
+#define CS_CTL0_DCORSEL_2           0x00020000
+#define CS_CTL0_DCORSEL_3           0x00030000
+#define CS_CTL0_DCORSEL_4           0x00040000
+#define CS_CTL0_DCORSEL_5           0x00050000
+#define CS_CTL0_DCORES_OFS          22
+#define CS_CTL0_DCORES              0x00400000
+#define CS_CTL0_DCOEN               0x00800000
+#define CS_CTL1_SELM_OFS            0
+#define CS_CTL1_SELM_MASK           0x00000007
+#define CS_CTL1_SELM__LFXTCLK       0x00000000
+#define CS_CTL1_SELM__VLOCLK        0x00000001
+#define CS_CTL1_SELM__REFOCLK       0x00000002
+#define CS_CTL1_SELM__DCOCLK        0x00000003
+#define CS_CTL1_SELM__MODOSC        0x00000004
+#define CS_CTL1_SELM__HFXTCLK       0x00000005
+#define CS_CTL1_SELS_OFS            4
+#define CS_CTL1_SELS_MASK           0x00000070
+#define CS_CTL1_SELS__LFXTCLK       0x00000000
+#define CS_CTL1_SELS__VLOCLK        0x00000010
+#define CS_CTL1_SELS__REFOCLK       0x00000020
+#define CS_CTL1_SELS__DCOCLK        0x00000030
+#define CS_CTL1_SELS__MODOSC        0x00000040
+#define CS_CTL1_SELS__HFXTCLK       0x00000050
+#define CS_CTL1_SELA_OFS            8
+#define CS_CTL1_SELA_MASK           0x00000700
+#define CS_CTL1_SELA__LFXTCLK       0x00000000
+#define CS_CTL1_SELA__VLOCLK        0x00000100
+#define CS_CTL1_SELA__REFOCLK       0x00000200
+#define CS_CTL1_DIVM_OFS            16
+#define CS_CTL1_DIVM_MASK           0x00070000
+#define CS_CTL1_DIVM__1             0x00000000
+#define CS_CTL1_DIVM__2             0x00010000
+#define CS_CTL1_DIVM__4             0x00020000
+#define CS_CTL1_DIVM__8             0x00030000
+#define CS_CTL1_DIVM__16            0x00040000
+#define CS_CTL1_DIVM__32            0x00050000
+#define CS_CTL1_DIVM__64            0x00060000
+#define CS_CTL1_DIVM__128           0x00070000
+#define CS_CTL1_DIVHS_OFS           20
+#define CS_CTL1_DIVHS_MASK          0x00700000
+#define CS_CTL1_DIVA_OFS            24
+#define CS_CTL1_DIVA_MASK           0x07000000
+#define CS_CTL1_DIVS_OFS            28
+#define CS_CTL1_DIVS_MASK           0x70000000
+#define CS_CTL1_DIVS__1             0x00000000
+#define CS_CTL1_DIVS__2             0x10000000
+#define CS_CTL1_DIVS__4             0x20000000
+#define CS_CTL1_DIVS__8             0x30000000
+#define CS_CTL1_DIVS__16            0x40000000
+#define CS_CTL1_DIVS__32            0x50000000
+#define CS_CTL1_DIVS__64            0x60000000
+#define CS_CTL1_DIVS__128           0x70000000
+#define CS_CTL2_LFXTDRIVE_MASK      0x00000003
+#define CS_CTL2_LFXT_EN             0x00000100
+#define CS_CTL2_LFXTBYPASS          0x00000200
+#define CS_CTL2_HFXTDRIVE           0x00010000
+#define CS_CTL2_HFXTFREQ_OFS        20
+#define CS_CTL2_HFXTFREQ_MASK       0x00700000
+#define CS_CTL2_HFXTFREQ_6          0x00600000
+#define CS_CTL2_HFXT_EN             0x01000000
+#define CS_CTL2_HFXTBYPASS          0x02000000
+#define CS_CLKEN_ACLK_EN            0x00000001
+#define CS_CLKEN_MCLK_EN            0x00000002
+#define CS_CLKEN_HSMCLK_EN          0x00000004
+#define CS_CLKEN_SMCLK_EN           0x00000008
+#define CS_CLKEN_REFOFSEL_OFS       15
+#define CS_CLKEN_REFOFSEL           0x00008000
+#define CS_IFG_LFXTIFG_OFS          0
+#define CS_IFG_LFXTIFG              0x00000001
+#define CS_IFG_HFXTIFG_OFS          1
+#define CS_IFG_HFXTIFG              0x00000002
+#define CS_CLRIFG_CLR_LFXTIFG       0x00000001
+#define CS_CLRIFG_CLR_HFXTIFG       0x00000002
+
+// DIO
+#define DIO_PORT_IV_IFG0            0x0002
+
+// DMA
+#define DMA_CFG_MASTEN              0x00000001
+#define DMA_INT1_SRCCFG_INT_SRC_MASK 0x0000001F
+#define DMA_INT1_SRCCFG_EN          0x00000020
+#define DMA_INT2_SRCCFG_EN          0x00000020
+#define DMA_INT3_SRCCFG_EN          0x00000020
+
+// eUSCI_A
+#define EUSCI_A_CTLW0_SWRST         0x0001
+#define EUSCI_A_CTLW0_TXBRK         0x0002
+#define EUSCI_A_CTLW0_SSEL_MASK     0x00C0
+#define EUSCI_A_CTLW0_SSEL__UCLK    0x0000
+#define EUSCI_A_CTLW0_SSEL__ACLK    0x0040
+#define EUSCI_A_CTLW0_SSEL__SMCLK   0x0080
+#define EUSCI_A_CTLW0_UCSSEL_2      0x0080
+#define EUSCI_A_CTLW0_SYNC          0x0100
+#define EUSCI_A_CTLW0_MODE_MASK     0x0600
+#define EUSCI_A_CTLW0_SPB           0x0800
+#define EUSCI_A_CTLW0_SEVENBIT      0x1000
+#define EUSCI_A_CTLW0_MSB           0x2000
+#define EUSCI_A_CTLW0_PAR           0x4000
+#define EUSCI_A_CTLW0_PEN           0x8000
+#define EUSCI_A_MCTLW_OS16          0x0001
+#define EUSCI_A_MCTLW_BRF_OFS       4
+#define EUSCI_A_MCTLW_BRF_MASK      0x00F0
+#define EUSCI_A_MCTLW_BRS_OFS       8
+#define EUSCI_A_MCTLW_BRS_MASK      0xFF00
+#define EUSCI_A_STATW_BUSY          0x0001
+#define EUSCI_A_STATW_OE            0x0020
+#define EUSCI_A_IE_RXIE             0x0001
+#define EUSCI_A_IE_RXIE_OFS         0
+#define EUSCI_A_IE_TXIE             0x0002
+#define EUSCI_A_IE_TXIE_OFS         1
+#define EUSCI_A_IFG_RXIFG           0x0001
+#define EUSCI_A_IFG_RXIFG_OFS       0
+#define EUSCI_A_IFG_TXIFG           0x0002
+#define EUSCI_A_IFG_TXIFG_OFS       1
+
+// eUSCI_B
+#define EUSCI_B_CTLW0_SWRST         0x0001
+#define EUSCI_B_CTLW0_STEM          0x0002
+#define EUSCI_B_CTLW0_TXSTT         0x0002
+#define EUSCI_B_CTLW0_TXSTP         0x0004
+#define EUSCI_B_CTLW0_TXNACK        0x0008
+#define EUSCI_B_CTLW0_TR            0x0010
+#define EUSCI_B_CTLW0_TXACK         0x0020
+#define EUSCI_B_CTLW0_SSEL_MASK     0x00C0
+#define EUSCI_B_CTLW0_SSEL__UCLKI   0x0000
+#define EUSCI_B_CTLW0_SSEL__ACLK    0x0040
+#define EUSCI_B_CTLW0_SSEL__SMCLK   0x0080
+#define EUSCI_B_CTLW0_UCSSEL_2      0x0080
+#define EUSCI_B_CTLW0_SYNC          0x0100
+#define EUSCI_B_CTLW0_MODE_MASK     0x0600
+#define EUSCI_B_CTLW0_MODE_0        0x0000
+#define EUSCI_B_CTLW0_MODE_1        0x0200
+#define EUSCI_B_CTLW0_MODE_2        0x0400
+#define EUSCI_B_CTLW0_MODE_3        0x0600
+#define EUSCI_B_CTLW0_MST           0x0800
+#define EUSCI_B_CTLW0_SEVENBIT      0x1000
+#define EUSCI_B_CTLW0_MSB           0x2000
+#define EUSCI_B_CTLW0_CKPL          0x4000
+#define EUSCI_B_CTLW0_CKPH          0x8000
+#define EUSCI_B_STATW_SPI_BUSY      0x0001
+#define EUSCI_B_STATW_BBUSY         0x0010
+#define EUSCI_B_STATW_OE            0x0020
+#define EUSCI_B_IE_RXIE             0x0001
+#define EUSCI_B_IE_TXIE             0x0002
+#define EUSCI_B_IE_RXIE0            0x0001
+#define EUSCI_B_IE_TXIE0            0x0002
+#define EUSCI_B_IE_STTIE            0x0004
+#define EUSCI_B_IE_STPIE            0x0008
+#define EUSCI_B_IE_ALIE             0x0010
+#define EUSCI_B_IE_NACKIE           0x0020
+#define EUSCI_B_IFG_RXIFG           0x0001
+#define EUSCI_B_IFG_TXIFG           0x0002
+#define EUSCI_B_IFG_RXIFG0          0x0001
+#define EUSCI_B_IFG_TXIFG0          0x0002
+#define EUSCI_B_IFG_STTIFG          0x0004
+#define EUSCI_B_IFG_STPIFG          0x0008
+#define EUSCI_B_IFG_ALIFG           0x0010
+#define EUSCI_B_IFG_NACKIFG         0x0020
+
+// FLCTL
+#define FLCTL_BANK0_RDCTL_BUFI      0x00000010
+#define FLCTL_BANK0_RDCTL_BUFD      0x00000020
+#define FLCTL_BANK0_RDCTL_WAIT_OFS  12
+#define FLCTL_BANK0_RDCTL_WAIT_MASK 0x0000F000
+#define FLCTL_BANK0_RDCTL_WAIT_0    0x00000000
+#define FLCTL_BANK0_RDCTL_WAIT_1    0x00001000
+#define FLCTL_BANK0_RDCTL_WAIT_2    0x00002000
+#define FLCTL_BANK1_RDCTL_BUFI      0x00000010
+#define FLCTL_BANK1_RDCTL_BUFD      0x00000020
+#define FLCTL_BANK1_RDCTL_WAIT_OFS  12
+#define FLCTL_BANK1_RDCTL_WAIT_MASK 0x0000F000
+#define FLCTL_BANK1_RDCTL_WAIT_0    0x00000000
+#define FLCTL_BANK1_RDCTL_WAIT_1    0x00001000
+#define FLCTL_BANK1_RDCTL_WAIT_2    0x00002000
+
+// PCM
+#define PCM_CTL0_KEY_VAL            0x695A0000
+#define PCM_CTL0_AMR_OFS            0
+#define PCM_CTL0_AMR_MASK           0x0000000F
+#define PCM_CTL0_AMR_0              0x00000000
+#define PCM_CTL0_AMR_1              0x00000001
+#define PCM_CTL0_AMR_4              0x00000004
+#define PCM_CTL0_AMR_5              0x00000005
+#define PCM_CTL0_CPM_OFS            8
+#define PCM_CTL0_CPM_MASK           0x00003F00
+#define PCM_CTL1_PMR_BUSY           0x00000100
+
+// PMAP
+#define PMAP_KEYID_VAL              0x2D52
+#define PM_NONE                     0
+#define PM_UCB2SDA                  17
+#define PM_UCB2SCL                  18
+#define PM_TA0CCR0A                 19
+#define PM_TA0CCR1A                 20
+#define PM_TA0CCR2A                 21
+#define PM_TA0CCR3A                 22
+#define PM_TA0CCR4A                 23
+
+// SYSCTL
+#define SYSCTL_SRAM_BANKEN_BNK7_EN  0x00000080
+
+// Timer32
+#define TIMER32_CONTROL_ONESHOT     0x00000001
+#define TIMER32_CONTROL_SIZE        0x00000002
+#define TIMER32_CONTROL_PRESCALE_OFS 2
+#define TIMER32_CONTROL_PRESCALE_MASK 0x0000000C
+#define TIMER32_CONTROL_PRESCALE_0  0x00000000
+#define TIMER32_CONTROL_PRESCALE_1  0x00000004
+#define TIMER32_CONTROL_PRESCALE_2  0x00000008
+#define TIMER32_CONTROL_IE          0x00000020
+#define TIMER32_CONTROL_MODE        0x00000040
+#define TIMER32_CONTROL_ENABLE      0x00000080
+#define TIMER32_RIS_RAW_IFG         0x00000001
+#define TIMER32_MIS_IFG             0x00000001
+
+// Timer_A
+#define TIMER_A_CTL_IFG             0x0001
+#define TIMER_A_CTL_IE              0x0002
+#define TIMER_A_CTL_CLR             0x0004
+#define TIMER_A_CTL_MC_OFS          4
+#define TIMER_A_CTL_MC_MASK         0x0030
+#define TIMER_A_CTL_MC_0            0x0000
+#define TIMER_A_CTL_MC_1            0x0010
+#define TIMER_A_CTL_MC_2            0x0020
+#define TIMER_A_CTL_MC_3            0x0030
+#define TIMER_A_CTL_MC__STOP        0x0000
+#define TIMER_A_CTL_MC__UP          0x0010
+#define TIMER_A_CTL_MC__CONTINUOUS  0x0020
+#define TIMER_A_CTL_MC__UPDOWN      0x0030
+#define TIMER_A_CTL_ID_OFS          6
+#define TIMER_A_CTL_ID_MASK         0x00C0
+#define TIMER_A_CTL_ID_0            0x0000
+#define TIMER_A_CTL_ID_1            0x0040
+#define TIMER_A_CTL_ID_2            0x0080
+#define TIMER_A_CTL_ID_3            0x00C0
+#define TIMER_A_CTL_ID__1           0x0000
+#define TIMER_A_CTL_ID__2           0x0040
+#define TIMER_A_CTL_ID__4           0x0080
+#define TIMER_A_CTL_ID__8           0x00C0
+#define TIMER_A_CTL_SSEL_OFS        8
+#define TIMER_A_CTL_SSEL_MASK       0x0300
+#define TIMER_A_CTL_TASSEL_0        0x0000
+#define TIMER_A_CTL_TASSEL_1        0x0100
+#define TIMER_A_CTL_TASSEL_2        0x0200
+#define TIMER_A_CTL_TASSEL_3        0x0300
+#define TIMER_A_CTL_SSEL__TACLK     0x0000
+#define TIMER_A_CTL_SSEL__ACLK      0x0100
+#define TIMER_A_CTL_SSEL__SMCLK     0x0200
+#define TIMER_A_CTL_SSEL__INCLK     0x0300
+#define TIMER_A_CCTLN_CCIFG         0x0001
+#define TIMER_A_CCTLN_COV           0x0002
+#define TIMER_A_CCTLN_OUT           0x0004
+#define TIMER_A_CCTLN_CCI           0x0008
+#define TIMER_A_CCTLN_CCIE          0x0010
+#define TIMER_A_CCTLN_OUTMOD_OFS    5
+#define TIMER_A_CCTLN_OUTMOD_MASK   0x00E0
+#define TIMER_A_CCTLN_OUTMOD_0      0x0000
+#define TIMER_A_CCTLN_OUTMOD_1      0x0020
+#define TIMER_A_CCTLN_OUTMOD_2      0x0040
+#define TIMER_A_CCTLN_OUTMOD_3      0x0060
+#define TIMER_A_CCTLN_OUTMOD_4      0x0080
+#define TIMER_A_CCTLN_OUTMOD_5      0x00A0
+#define TIMER_A_CCTLN_OUTMOD_6      0x00C0
+#define TIMER_A_CCTLN_OUTMOD_7      0x00E0
+#define TIMER_A_CCTLN_CAP           0x0100
+#define TIMER_A_CCTLN_SCCI          0x0400
+#define TIMER_A_CCTLN_SCS           0x0800
+#define TIMER_A_CCTLN_CCIS_OFS      12
+#define TIMER_A_CCTLN_CCIS_MASK     0x3000
+#define TIMER_A_CCTLN_CCIS_0        0x0000
+#define TIMER_A_CCTLN_CCIS_1        0x1000
+#define TIMER_A_CCTLN_CCIS_2        0x2000
+#define TIMER_A_CCTLN_CCIS_3        0x3000
+#define TIMER_A_CCTLN_CM_OFS        14
+#define TIMER_A_CCTLN_CM_MASK       0xC000
+#define TIMER_A_CCTLN_CM_0          0x0000
+#define TIMER_A_CCTLN_CM_1          0x4000
+#define TIMER_A_CCTLN_CM_2          0x8000
+#define TIMER_A_CCTLN_CM_3          0xC000
+#define TIMER_A_CCTLN_CM__NONE      0x0000
+#define TIMER_A_CCTLN_CM__RISING    0x4000
+#define TIMER_A_CCTLN_CM__FALLING   0x8000
+#define TIMER_A_CCTLN_CM__BOTH      0xC000
+#define TIMER_A_EX0_IDEX_MASK       0x0007
+#define TIMER_A_EX0_IDEX__1         0x0000
+#define TIMER_A_EX0_IDEX__2         0x0001
+#define TIMER_A_EX0_IDEX__3         0x0002
+#define TIMER_A_EX0_IDEX__4         0x0003
+#define TIMER_A_EX0_IDEX__5         0x0004
+#define TIMER_A_EX0_IDEX__6         0x0005
+#define TIMER_A_EX0_IDEX__7         0x0006
+#define TIMER_A_EX0_IDEX__8         0x0007
+
+// WDT_A
+#define WDT_A_CTL_PW                0x5A00
+#define WDT_A_CTL_HOLD              0x0080
+
+// Cortex-M4 core
+#define SysTick_CTRL_ENABLE_Pos     0
+#define SysTick_CTRL_ENABLE_Msk     (1UL << 0)
+#define SysTick_CTRL_TICKINT_Pos    1
+#define SysTick_CTRL_TICKINT_Msk    (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Pos  2
+#define SysTick_CTRL_CLKSOURCE_Msk  (1UL << 2)
+#define SysTick_CTRL_COUNTFLAG_Pos  16
+#define SysTick_CTRL_COUNTFLAG_Msk  (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk     0x00FFFFFFUL
+#define SCB_SCR_SLEEPONEXIT_Msk     (1UL << 1)
+#define SCB_SCR_SLEEPDEEP_Msk       (1UL << 2)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+
+/******************************************************************************
+* system_msp432p401r.h                                                        *
+******************************************************************************/
+
+extern uint32_t SystemCoreClock;
+void SystemInit(void);
+void SystemCoreClockUpdate(void);
+
+/******************************************************************************
+* Compiler intrinsics                                                         *
+******************************************************************************/
+
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __delay_cycles(uint32_t cycles);
+void HOST_sleep(void);
+
+#define _delay_cycles(n)    __delay_cycles(n)
+#define __sleep()           HOST_sleep()
+#define __wfi()             HOST_sleep()
+#define __WFI()             HOST_sleep()
+#define __DSB()             ((void)0)
+#define __ISB()             ((void)0)
+#define __DMB()             ((void)0)
+#define __NOP()             ((void)0)
+#define __no_operation()    ((void)0)
+
+// Cortex-M4 DSP instructions, lane by lane in C
+static inline uint32_t __UADD16(uint32_t a, uint32_t b)
+{
+    return ((a + b) & 0xFFFF) | (((a >> 16) + (b >> 16)) << 16);
+}
+
+static inline uint32_t __USUB16(uint32_t a, uint32_t b)
+{
+    return ((a - b) & 0xFFFF) | (((a >> 16) - (b >> 16)) << 16);
+}
+
+static inline uint32_t __UQSUB16(uint32_t a, uint32_t b)
+{
+    uint32_t lo = ((a & 0xFFFF) > (b & 0xFFFF)) ? (a & 0xFFFF) - (b & 0xFFFF) : 0;
+    uint32_t hi = ((a >> 16) > (b >> 16)) ? (a >> 16) - (b >> 16) : 0;
+
+    return lo | (hi << 16);
+}
+
+static inline uint32_t __SMLAD(uint32_t a, uint32_t b, uint32_t acc)
+{
+    return acc + (int32_t)(int16_t)a * (int16_t)b
+               + (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+
+static inline uint64_t __SMLALD(uint32_t a, uint32_t b, uint64_t acc)
+{
+    return acc + (int64_t)((int32_t)(int16_t)a * (int16_t)b)
+               + (int64_t)((int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16));
+}
+
+/******************************************************************************
+* CMSIS NVIC functions                                                        *
+******************************************************************************/
+
+static inline void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    NVIC->ISER[irqn >> 5] = 1UL << (irqn & 31);
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    NVIC->ICER[irqn >> 5] = 1UL << (irqn & 31);
+}
+
+static inline void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority)
+{
+    if (irqn < 0)
+        SCB->SHP[(irqn & 0xF) - 4] = (uint8_t)(priority << (8 - __NVIC_PRIO_BITS));
+    else
+        NVIC->IP[irqn] = (uint8_t)(priority << (8 - __NVIC_PRIO_BITS));
+}
+
+/******************************************************************************
+* Host side of the model, for tests                                           *
+******************************************************************************/
+
+#define HOST_PS             1000000000000ULL    // picoseconds per second
+#define HOST_NEVER          UINT64_MAX
+#define HOST_ACCESS_CYCLES  4                   // MCLK cycles per access
+
+#define HOST_READ_RXBUF     0
+#define HOST_READ_CTRL      1
+
+unsigned HOST_read(uint8_t reg);
+
+// simulated time in ps since reset, and MCLK cycles the CPU ran
+uint64_t HOST_time(void);
+uint64_t HOST_cycles(void);
+uint32_t HOST_mclk(void);
+uint32_t HOST_smclk(void);
+uint32_t HOST_aclk(void);
+
+// time spent running main, in ISRs and asleep, in ps, and other counts
+typedef struct {
+    uint64_t busy;
+    uint64_t isr;
+    uint64_t sleep;
+    uint32_t interrupts;
+    uint32_t dma_transfers;
+    uint32_t flash_errors;      // MCLK / SMCLK above the VCORE or wait limit
+    uint32_t overruns;          // eUSCI TXBUF written before it moved on
+} HOST_stats_t;
+
+extern HOST_stats_t HOST_stats;
+
+// Function to run fn(arg) from the model at time (ps), e.g. to change an
+// input pin. Runs in the model, it may only call the HOST_ inputs below.
+void HOST_at(uint64_t time, void (*fn)(void* arg), void* arg);
+
+// Function to let time pass (ps) with interrupts running, like a sleep
+// that does not end early
+void HOST_run(uint64_t time);
+
+// Function to stop the program with siglongjmp(HOST_exit, 1) once the
+// simulated time reaches time (ps, 0 for no limit). The jump is taken at
+// the next register access, delay or sleep of the program. A program
+// that can never wake jumps with 2.
+#include <setjmp.h>
+extern sigjmp_buf HOST_exit;
+void HOST_end(uint64_t time);
+
+// Function to run the model from a timer signal when the program spins on
+// a RAM variable with no register access (SPI_busy() loops)
+void HOST_watchdog(uint8_t enable);
+
+// Function to give a handler and context for irqn, for BSP/irq.c
+void HOST_register(IRQn_Type irqn, void (*handler)(void* ctx), void* ctx);
+void HOST_vector(IRQn_Type irqn, void (*isr)(void));
+
+// GPIO: drive an input from outside (level 0 / 1, -1 to let it go) and
+// see every write to OUT / DIR. port 1 - 10, 11 = PJ.
+void HOST_pin(uint8_t port, uint8_t pin, int8_t level);
+extern void (*HOST_port_out)(uint8_t port, uint8_t out, uint8_t dir);
+
+// Timer_A: level on CCIxA (input 0) or CCIxB (input 1), edges on TAxCLK
+// and every change of a TAx.n output
+void HOST_timer_input(uint8_t timer, uint8_t ccr, uint8_t input, uint8_t level);
+void HOST_timer_clock(uint8_t timer, uint32_t edges);
+extern void (*HOST_timer_output)(uint8_t timer, uint8_t ccr, uint8_t level);
+
+// eUSCI_A UART: each byte sent (at the end of its stop bit) and bytes in
+void HOST_uart_rx(uint8_t uart, uint8_t byte);
+extern void (*HOST_uart_tx)(uint8_t uart, uint8_t byte);
+
+// eUSCI_B SPI: each byte out returns the byte in, and STE changes
+extern uint8_t (*HOST_spi_byte)(uint8_t spi, uint8_t mosi);
+extern void (*HOST_spi_ste)(uint8_t spi, uint8_t active);
+
+// eUSCI_B I2C: a target on the bus. start returns 1 to ACK its address,
+// write returns 1 to ACK a byte.
+typedef struct {
+    uint8_t (*start)(void* ctx, uint8_t read);
+    uint8_t (*write)(void* ctx, uint8_t byte);
+    uint8_t (*read)(void* ctx);
+    void (*stop)(void* ctx);
+    void* ctx;
+} HOST_i2c_target;
+
+void HOST_i2c_attach(uint8_t bus, uint8_t address, const HOST_i2c_target* target);
+
+// ADC14 input, called for each conversion with the INCH channel, returns
+// the 14 bit result
+extern uint16_t (*HOST_adc_input)(uint8_t channel);
+
+// COMP_E output before OUTPOL and the filter
+void HOST_comp_output(uint8_t comp, uint8_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_MSP_H_ */
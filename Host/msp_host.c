@@ -0,0 +1,2631 @@
+// MSP432P401R model for PC builds of the projects
+//
+// program access  -> HOST_io -> writes since the last access go to the
+//                    peripheral models, time moves on, interrupts run
+// model time      -> clock domains (MCLK, SMCLK, HSMCLK, ACLK) in edges,
+//                    counters step by edges, other events at a time
+// interrupts      -> NVIC pending / enable / priority from the registers,
+//                    the *_IRQHandler of the program or IRQ_register
+//
+// See msp.h for what the model does and does not do.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "msp.h"
+
+#define MHZ(f)          ((uint64_t)((f) * 1000000))
+#define BIT(n)          (1UL << (n))
+
+#define ENTRY_CYCLES    12              // exception entry, stacking
+#define EXIT_CYCLES     12              // exception return, unstacking
+#define PCM_SETTLE      50000000ULL     // ps, 50 us for a VCORE change
+#define HFXT_START      1000000000ULL   // ps, 1 ms crystal start up
+#define TXBUF_EMPTY     0xFFFF          // TXBUF value once moved on
+#define T32_INTCLR_IDLE 0xFFFFFFFF      // INTCLR value between writes
+
+_Static_assert(offsetof(Timer_A_Type, EX0) == 0x20, "Timer_A layout");
+_Static_assert(offsetof(EUSCI_A_Type, IFG) == 0x1C, "EUSCI_A layout");
+_Static_assert(offsetof(EUSCI_B_Type, IFG) == 0x2C, "EUSCI_B layout");
+_Static_assert(offsetof(ADC14_Type, IER0) == 0x13C, "ADC14 layout");
+_Static_assert(offsetof(CS_Type, CLRIFG) == 0x50, "CS layout");
+_Static_assert(offsetof(DMA_Channel_Type, INT0_CLRFLG) == 0x114, "DMA layout");
+_Static_assert(offsetof(NVIC_Type, STIR) == 0xE00, "NVIC layout");
+_Static_assert(offsetof(SCB_Type, CPACR) == 0x88, "SCB layout");
+_Static_assert(offsetof(DIO_PORT_Even_Interruptable_Type, IFG) == 0x1D, "DIO layout");
+
+uint8_t HOST_periph[HOST_PERIPH_SIZE] __attribute__((aligned(4096)));
+uint8_t HOST_scs[HOST_SCS_SIZE] __attribute__((aligned(4096)));
+uint8_t HOST_dwt[0x100] __attribute__((aligned(256)));
+uint8_t HOST_sysctl[0x100] __attribute__((aligned(256)));
+const TLV_Type HOST_tlv = { 0 };
+
+HOST_stats_t HOST_stats;
+sigjmp_buf HOST_exit;
+
+void (*HOST_port_out)(uint8_t port, uint8_t out, uint8_t dir);
+void (*HOST_timer_output)(uint8_t timer, uint8_t ccr, uint8_t level);
+void (*HOST_uart_tx)(uint8_t uart, uint8_t byte);
+uint8_t (*HOST_spi_byte)(uint8_t spi, uint8_t mosi);
+void (*HOST_spi_ste)(uint8_t spi, uint8_t active);
+uint16_t (*HOST_adc_input)(uint8_t channel);
+
+// copies of the register arrays as the model last left them
+static uint8_t periph_shadow[HOST_PERIPH_SIZE];
+static uint8_t scs_shadow[HOST_SCS_SIZE];
+static uint8_t dwt_shadow[sizeof(HOST_dwt)];
+
+#define TA(n)       ((Timer_A_Type*)(HOST_periph + 0x0000 + 0x400 * (n)))
+#define UCA(n)      ((EUSCI_A_Type*)(HOST_periph + 0x1000 + 0x400 * (n)))
+#define UCB(n)      ((EUSCI_B_Type*)(HOST_periph + 0x2000 + 0x400 * (n)))
+#define COMP(n)     ((COMP_E_Type*)(HOST_periph + 0x3400 + 0x400 * (n)))
+#define DIO         (HOST_periph + 0x4C00)
+#define T32(n)      ((Timer32_Type*)(HOST_periph + 0xC000 + 0x20 * (n)))
+#define DMACH       ((DMA_Channel_Type*)(HOST_periph + 0xE000))
+#define DMACTL      ((DMA_Control_Type*)(HOST_periph + 0xF000))
+#define PCMR        ((PCM_Type*)(HOST_periph + 0x10000))
+#define CSR         ((CS_Type*)(HOST_periph + 0x10400))
+#define FLCTLR      ((FLCTL_Type*)(HOST_periph + 0x11000))
+#define ADC         ((ADC14_Type*)(HOST_periph + 0x12000))
+#define STK         ((SysTick_Type*)(HOST_scs + 0x0010))
+#define NVICR       ((NVIC_Type*)(HOST_scs + 0x0100))
+#define SCBR        ((SCB_Type*)(HOST_scs + 0x0D00))
+#define DWTR        ((DWT_Type*)HOST_dwt)
+
+/******************************************************************************
+* Register writes from the model, kept out of the program write check         *
+******************************************************************************/
+
+static uint8_t* shadow_of(const volatile void* reg)
+{
+    uintptr_t at = (uintptr_t)reg;
+
+    if (at - (uintptr_t)HOST_periph < sizeof(HOST_periph))
+        return periph_shadow + (at - (uintptr_t)HOST_periph);
+    if (at - (uintptr_t)HOST_scs < sizeof(HOST_scs))
+        return scs_shadow + (at - (uintptr_t)HOST_scs);
+    if (at - (uintptr_t)HOST_dwt < sizeof(HOST_dwt))
+        return dwt_shadow + (at - (uintptr_t)HOST_dwt);
+    return 0;
+}
+
+static void put8(const volatile uint8_t* reg, uint8_t value)
+{
+    *(volatile uint8_t*)reg = value;
+    *shadow_of(reg) = value;
+}
+
+static void put16(const volatile uint16_t* reg, uint16_t value)
+{
+    *(volatile uint16_t*)reg = value;
+    memcpy(shadow_of(reg), &value, 2);
+}
+
+static void put32(const volatile uint32_t* reg, uint32_t value)
+{
+    *(volatile uint32_t*)reg = value;
+    memcpy(shadow_of(reg), &value, 4);
+}
+
+/******************************************************************************
+* Clock domains and time                                                      *
+******************************************************************************/
+
+enum { D_MCLK, D_SMCLK, D_HSMCLK, D_ACLK, DOMAINS };
+
+typedef struct {
+    uint64_t hz;
+    uint64_t time;                      // ps at the last rate change
+    uint64_t edges;                     // edges before that time
+} Domain;
+
+static Domain domain[DOMAINS];
+static uint64_t now;                    // ps since reset
+static uint64_t cpu_cycles;             // MCLK cycles the CPU has run
+static uint64_t end_time;               // HOST_end, 0 for none
+static volatile uint8_t ended;
+
+static uint64_t edges_at(const Domain* d, uint64_t time)
+{
+    if (!d->hz || (time <= d->time))
+        return d->edges;
+    return d->edges + (uint64_t)(((unsigned __int128)(time - d->time) * d->hz) / HOST_PS);
+}
+
+// time of edge number edge, the first time edges_at reaches it
+static uint64_t edge_time(const Domain* d, uint64_t edge)
+{
+    if (edge <= d->edges)
+        return d->time;
+    if (!d->hz)
+        return HOST_NEVER;
+    return d->time + (uint64_t)(((unsigned __int128)(edge - d->edges) * HOST_PS
+                                 + d->hz - 1) / d->hz);
+}
+
+static void set_rate(Domain* d, uint64_t hz)
+{
+    if (d->hz == hz)
+        return;
+    d->edges = edges_at(d, now);
+    d->time = now;
+    d->hz = hz;
+}
+
+// ps for cycles of a clock, for events that are not counted in edges
+static uint64_t cycles_time(uint64_t hz, uint64_t cycles)
+{
+    if (!hz)
+        return HOST_NEVER;
+    return (uint64_t)(((unsigned __int128)cycles * HOST_PS + hz - 1) / hz);
+}
+
+/******************************************************************************
+* State of the models                                                         *
+******************************************************************************/
+
+typedef struct {
+    uint64_t edges;                     // source edges seen
+    uint32_t prescale;                  // edges into ID * IDEX so far
+    uint32_t phase;                     // count position, up / down as 0 - 2 top
+    uint8_t out[7];
+    uint8_t input[7][2];                // CCIxA / CCIxB levels
+} Timer;
+
+typedef struct {
+    uint64_t tx_load;                   // TXBUF to shifter
+    uint64_t tx_done;                   // shifter empty
+    uint64_t rx_next;                   // next byte from rx_queue
+    uint16_t txbuf;
+    uint8_t tx_full;
+    uint8_t shift;
+    uint8_t rx_queue[256];
+    uint8_t rx_head, rx_tail;
+} Uart;
+
+enum { I2C_IDLE, I2C_ADDR, I2C_TX_WAIT, I2C_TX_BYTE, I2C_RX_BYTE,
+       I2C_RX_HOLD, I2C_NACK_HOLD, I2C_STOP };
+
+typedef struct {
+    uint64_t tx_load, tx_done;          // SPI
+    uint16_t txbuf;
+    uint8_t tx_full;
+    uint8_t shift;
+    uint8_t ste;
+    uint8_t state;                      // I2C
+    uint64_t i2c_time;                  // end of the I2C step
+    const HOST_i2c_target* target;
+    const HOST_i2c_target* targets[128];
+} Usci;
+
+static Timer timer[4];
+static Uart uart[4];
+static Usci usci[4];
+
+static uint64_t systick_edges;
+static uint64_t t32_edges[2];
+static uint32_t t32_prescale[2];
+
+static uint64_t adc_done = HOST_NEVER;  // end of the conversion running
+static uint8_t adc_index;               // MEM / MCTL of the conversion
+static uint8_t adc_sequence;            // a sequence is part way done
+
+static uint8_t cs_unlocked;
+static uint8_t hfxt_running;
+static uint64_t hfxt_ready = HOST_NEVER;
+static uint64_t pcm_done = HOST_NEVER;
+static uint8_t pcm_cpm;                 // active mode, bit 0 = VCORE1
+static uint8_t pcm_target;
+static uint8_t limits_bad;
+
+static uint8_t port_ext[12], port_drive[12];    // HOST_pin levels, ports 1 - 11
+static uint8_t comp_raw[2];
+
+static uint32_t dma_enabled, dma_alt, dma_mask, dma_burst, dma_prio;
+static uint32_t dma_request;
+static uint8_t dma_busy;
+
+static uint32_t primask;
+static uint8_t isr_depth;
+static uint8_t active_prio[64];
+static uint8_t systick_pending;
+static volatile uint32_t in_host;
+static volatile uint32_t hooks;
+static uint8_t exit_armed;
+static uint64_t cyccnt_base;
+
+typedef struct {
+    void (*handler)(void* ctx);
+    void (*isr)(void);
+    void* ctx;
+} Vector;
+
+static Vector vectors[1 + PORT6_IRQn + 1];  // [0] SysTick
+
+typedef struct {
+    uint64_t time;
+    void (*fn)(void* arg);
+    void* arg;
+} Timed;
+
+#define TIMED_MAX   64
+static Timed timed[TIMED_MAX];
+static uint8_t timed_count;
+
+static void dma_trigger(uint8_t channel, uint8_t source);
+static void adc_trigger(void);
+static void nvic_pend(int irqn);
+static void host_stop(const char* why);
+static void flush(void);
+
+/******************************************************************************
+* Clock system, power and flash limits                                        *
+******************************************************************************/
+
+static uint64_t source_hz(uint8_t select)
+{
+    static const uint64_t dco[8] = {
+        MHZ(1.5), MHZ(3), MHZ(6), MHZ(12), MHZ(24), MHZ(48), MHZ(48), MHZ(48)
+    };
+    uint64_t refo = (CSR->CLKEN & CS_CLKEN_REFOFSEL) ? 128000 : 32768;
+
+    switch (select) {
+        case 1:  return 9400;                           // VLO
+        case 3:  return dco[(CSR->CTL0 & CS_CTL0_DCORSEL_MASK) >> CS_CTL0_DCORSEL_OFS];
+        case 4:  return MHZ(24);                        // MODOSC
+        case 5:  return hfxt_running ? MHZ(48) : refo;  // fault falls back
+        default: return refo;                           // LFXT not fitted
+    }
+}
+
+static void check_limits(void)
+{
+    uint8_t vcore = pcm_cpm & 1;
+    uint32_t wait = (FLCTLR->BANK0_RDCTL & FLCTL_BANK0_RDCTL_WAIT_MASK) >> FLCTL_BANK0_RDCTL_WAIT_OFS;
+    uint32_t wait1 = (FLCTLR->BANK1_RDCTL & FLCTL_BANK1_RDCTL_WAIT_MASK) >> FLCTL_BANK1_RDCTL_WAIT_OFS;
+    uint64_t mclk = domain[D_MCLK].hz, smclk = domain[D_SMCLK].hz;
+    uint8_t bad;
+
+    if ((pcm_done != HOST_NEVER) && !(pcm_target & 1))
+        vcore = 0;                      // lower VCORE from the change start
+
+    if (wait1 < wait)
+        wait = wait1;
+
+    bad = (mclk > (vcore ? MHZ(48) : MHZ(24)))
+       || (smclk > (vcore ? MHZ(24) : MHZ(12)))
+       || (domain[D_HSMCLK].hz > (vcore ? MHZ(48) : MHZ(24)))
+       || (!wait && (mclk > (vcore ? MHZ(16) : MHZ(12))));
+
+    if (bad && !limits_bad)
+        HOST_stats.flash_errors++;
+    limits_bad = bad;
+}
+
+static uint8_t deep_sleep;
+
+static void cs_update(void)
+{
+    uint32_t ctl1 = CSR->CTL1;
+    uint64_t source = source_hz((ctl1 & CS_CTL1_SELS_MASK) >> CS_CTL1_SELS_OFS);
+
+    if (deep_sleep) {
+        set_rate(&domain[D_MCLK], 0);
+        set_rate(&domain[D_SMCLK], 0);
+        set_rate(&domain[D_HSMCLK], 0);
+    } else {
+        set_rate(&domain[D_MCLK], source_hz(ctl1 & CS_CTL1_SELM_MASK)
+                 >> ((ctl1 & CS_CTL1_DIVM_MASK) >> CS_CTL1_DIVM_OFS));
+        set_rate(&domain[D_SMCLK], source >> ((ctl1 & CS_CTL1_DIVS_MASK) >> CS_CTL1_DIVS_OFS));
+        set_rate(&domain[D_HSMCLK], source >> ((ctl1 & CS_CTL1_DIVHS_MASK) >> CS_CTL1_DIVHS_OFS));
+    }
+    set_rate(&domain[D_ACLK], source_hz((ctl1 & CS_CTL1_SELA_MASK) >> CS_CTL1_SELA_OFS)
+             >> ((ctl1 & CS_CTL1_DIVA_MASK) >> CS_CTL1_DIVA_OFS));
+    check_limits();
+}
+
+static void cs_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    uint32_t ifg;
+
+    if (offset == offsetof(CS_Type, KEY)) {
+        cs_unlocked = ((value & 0xFFFF) == CS_KEY_VAL);
+        put32(&CSR->KEY, 0xA596);       // always reads A596h
+        return;
+    }
+
+    if (offset == offsetof(CS_Type, STAT) || offset == offsetof(CS_Type, IFG)) {
+        put32((volatile uint32_t*)((uint8_t*)CSR + offset), old);   // read only
+        return;
+    }
+
+    if (!cs_unlocked) {
+        put32((volatile uint32_t*)((uint8_t*)CSR + offset), old);   // locked
+        return;
+    }
+
+    if (offset == offsetof(CS_Type, CLRIFG) || offset == offsetof(CS_Type, SETIFG)) {
+        ifg = CSR->IFG;
+        if (offset == offsetof(CS_Type, SETIFG))
+            ifg |= value;
+        else
+            ifg &= ~(value & ~(hfxt_running ? 0 : CS_IFG_HFXTIFG) & ~CS_IFG_LFXTIFG);
+        put32((volatile uint32_t*)&CSR->IFG, ifg);
+        put32((volatile uint32_t*)((uint8_t*)CSR + offset), 0);
+        return;
+    }
+
+    if ((offset == offsetof(CS_Type, CTL2)) && (value & CS_CTL2_HFXT_EN) &&
+        !(old & CS_CTL2_HFXT_EN)) {
+        // the crystal only starts with HFXIN / HFXOUT on PJ.2 / PJ.3
+        if (((*(DIO + 0x120 + 0x0A)) & (BIT2 | BIT3)) == (BIT2 | BIT3))
+            hfxt_ready = now + HFXT_START;
+    }
+    if ((offset == offsetof(CS_Type, CTL2)) && !(value & CS_CTL2_HFXT_EN)) {
+        hfxt_running = 0;
+        hfxt_ready = HOST_NEVER;
+    }
+
+    cs_update();
+}
+
+static void pcm_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset != offsetof(PCM_Type, CTL0)) {
+        if (offset == offsetof(PCM_Type, CTL1))
+            put32(&PCMR->CTL1, (value & ~PCM_CTL1_PMR_BUSY) | (old & PCM_CTL1_PMR_BUSY));
+        return;
+    }
+
+    if (((value & 0xFFFF0000) != PCM_CTL0_KEY_VAL) || (PCMR->CTL1 & PCM_CTL1_PMR_BUSY)) {
+        put32(&PCMR->CTL0, old);        // no key or a change is running
+        return;
+    }
+
+    pcm_target = value & PCM_CTL0_AMR_MASK;
+    put32(&PCMR->CTL0, (old & PCM_CTL0_CPM_MASK) | pcm_target);
+    if (pcm_target != pcm_cpm) {
+        put32(&PCMR->CTL1, PCMR->CTL1 | PCM_CTL1_PMR_BUSY);
+        pcm_done = now + PCM_SETTLE;
+    }
+    check_limits();
+}
+
+static void flctl_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    check_limits();
+}
+
+/******************************************************************************
+* Interrupt controller                                                        *
+******************************************************************************/
+
+// interrupt lines from flags and enables, 1 = asserted
+static void irq_lines(uint32_t line[2])
+{
+    uint8_t n;
+
+    line[0] = line[1] = 0;
+
+#define LINE(irqn, on)  do { if (on) line[(irqn) >> 5] |= BIT((irqn) & 31); } while (0)
+
+    for (n = 0; n < 2; n++)
+        LINE(COMP_E0_IRQn + n,
+             ((COMP(n)->INT & COMP_E_INT_IE) && (COMP(n)->INT & COMP_E_INT_IFG)) ||
+             ((COMP(n)->INT & COMP_E_INT_IIE) && (COMP(n)->INT & COMP_E_INT_IIFG)));
+
+    for (n = 0; n < 4; n++) {
+        uint16_t ccie = 0, ccifg = 0;
+        uint8_t ccr;
+
+        for (ccr = 1; ccr < 7; ccr++) {
+            ccie |= TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CCIE;
+            ccifg |= TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CCIE && TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CCIFG;
+        }
+        LINE(TA0_0_IRQn + 2 * n, (TA(n)->CCTL[0] & TIMER_A_CCTLN_CCIE) &&
+                                 (TA(n)->CCTL[0] & TIMER_A_CCTLN_CCIFG));
+        LINE(TA0_N_IRQn + 2 * n, ccifg ||
+             ((TA(n)->CTL & TIMER_A_CTL_IE) && (TA(n)->CTL & TIMER_A_CTL_IFG)));
+        (void)ccie;
+
+        LINE(EUSCIA0_IRQn + n, UCA(n)->IE & UCA(n)->IFG & 0x0F);
+        LINE(EUSCIB0_IRQn + n, UCB(n)->IE & UCB(n)->IFG & 0x7FFF);
+    }
+
+    LINE(ADC14_IRQn, (ADC->IER0 & ADC->IFGR0) || (ADC->IER1 & ADC->IFGR1));
+
+    for (n = 0; n < 2; n++)
+        LINE(T32_INT1_IRQn + n, T32(n)->MIS);
+    LINE(T32_INTC_IRQn, T32(0)->MIS || T32(1)->MIS);
+
+    {
+        uint32_t routed = 0;
+
+        for (n = 0; n < 3; n++) {
+            uint32_t cfg = (&DMACH->INT1_SRCCFG)[n];
+
+            if (cfg & DMA_INT1_SRCCFG_EN)
+                routed |= BIT(cfg & DMA_INT1_SRCCFG_INT_SRC_MASK);
+        }
+        LINE(DMA_INT0_IRQn, DMACH->INT0_SRCFLG & ~routed);
+    }
+
+    for (n = 0; n < 6; n++) {
+        const uint8_t* pair = DIO + (n / 2) * 0x20 + (n & 1);
+
+        LINE(PORT1_IRQn + n, pair[0x1A] & pair[0x1C]);
+    }
+
+#undef LINE
+}
+
+static uint8_t irq_priority(int irqn)
+{
+    if (irqn < 0)
+        return SCBR->SHP[11] >> 5;
+    return NVICR->IP[irqn] >> 5;
+}
+
+static uint8_t exec_priority(void)
+{
+    return isr_depth ? active_prio[isr_depth - 1] : 8;
+}
+
+#define NO_IRQ  (-100)
+
+// highest priority interrupt that is pending and enabled, NO_IRQ if none.
+// Level lines are latched into ISPR unless the interrupt is active.
+static int irq_best(void)
+{
+    uint32_t line[2];
+    int best = NO_IRQ, irqn;
+    uint8_t best_prio = 8, word;
+
+    irq_lines(line);
+    for (word = 0; word < 2; word++) {
+        uint32_t pend = NVICR->ISPR[word] | (line[word] & ~NVICR->IABR[word]);
+
+        if (pend != NVICR->ISPR[word])
+            put32(&NVICR->ISPR[word], pend);
+    }
+
+    if (systick_pending) {
+        best = -1;
+        best_prio = irq_priority(-1);
+    }
+
+    for (irqn = 0; irqn <= PORT6_IRQn; irqn++) {
+        uint32_t bit = BIT(irqn & 31);
+
+        if ((NVICR->ISPR[irqn >> 5] & bit) && (NVICR->ISER[irqn >> 5] & bit) &&
+            (irq_priority(irqn) < best_prio) ) {
+            best = irqn;
+            best_prio = irq_priority(irqn);
+        }
+    }
+
+    return best;
+}
+
+// an interrupt that would run now with PRIMASK clear, wakes from sleep
+static uint8_t irq_ready(void)
+{
+    int irqn = irq_best();
+
+    return (irqn != NO_IRQ) && (irq_priority(irqn) < exec_priority());
+}
+
+static void nvic_pend(int irqn)
+{
+    if (irqn < 0)
+        systick_pending = 1;
+    else
+        put32(&NVICR->ISPR[irqn >> 5], NVICR->ISPR[irqn >> 5] | BIT(irqn & 31));
+}
+
+static void nvic_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    uint8_t word = (offset & 0x7F) >> 2;
+
+    switch (offset & ~0x7F) {
+        case 0x000:                     // ISER, reads the enables
+            put32(&NVICR->ISER[word], old | value);
+            break;
+        case 0x080:                     // ICER
+            put32(&NVICR->ISER[word], NVICR->ISER[word] & ~value);
+            put32(&NVICR->ICER[word], 0);
+            break;
+        case 0x100:                     // ISPR, reads the pending bits
+            put32(&NVICR->ISPR[word], old | value);
+            break;
+        case 0x180:                     // ICPR
+            put32(&NVICR->ISPR[word], NVICR->ISPR[word] & ~value);
+            put32(&NVICR->ICPR[word], 0);
+            break;
+        case 0x200:                     // IABR is read only
+            put32(&NVICR->IABR[word], old);
+            break;
+    }
+}
+
+static void stir_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (value <= PORT6_IRQn)
+        nvic_pend(value);
+    put32(&NVICR->STIR, 0);
+}
+
+static void scb_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == offsetof(SCB_Type, ICSR)) {
+        if (value & BIT(26))            // PENDSTSET
+            systick_pending = 1;
+        if (value & BIT(25))            // PENDSTCLR
+            systick_pending = 0;
+        put32(&SCBR->ICSR, 0);
+    }
+}
+
+/******************************************************************************
+* Timer_A                                                                     *
+******************************************************************************/
+
+static uint32_t ta_divider(uint8_t n)
+{
+    return (1u << ((TA(n)->CTL & TIMER_A_CTL_ID_MASK) >> TIMER_A_CTL_ID_OFS)) *
+           ((TA(n)->EX0 & TIMER_A_EX0_IDEX_MASK) + 1);
+}
+
+static uint8_t ta_mode(uint8_t n)
+{
+    return (TA(n)->CTL & TIMER_A_CTL_MC_MASK) >> TIMER_A_CTL_MC_OFS;
+}
+
+static uint32_t ta_top(uint8_t n)
+{
+    return (ta_mode(n) == 2) ? 0xFFFF : TA(n)->CCR[0];
+}
+
+// counts in one period of the phase, 0 when not counting
+static uint32_t ta_period(uint8_t n)
+{
+    switch (ta_mode(n)) {
+        case 1:  return ta_top(n) + 1;
+        case 2:  return 0x10000;
+        case 3:  return 2 * ta_top(n);
+        default: return 0;
+    }
+}
+
+static uint16_t ta_count_of(uint8_t n, uint32_t phase)
+{
+    uint32_t top = ta_top(n);
+
+    if ((ta_mode(n) == 3) && (phase > top))
+        return 2 * top - phase;
+    return phase;
+}
+
+static Domain* ta_domain(uint8_t n)
+{
+    switch (TA(n)->CTL & TIMER_A_CTL_SSEL_MASK) {
+        case TIMER_A_CTL_SSEL__ACLK:  return &domain[D_ACLK];
+        case TIMER_A_CTL_SSEL__SMCLK: return &domain[D_SMCLK];
+        default:                      return 0;     // TACLK / INCLK edges
+    }
+}
+
+static void ta_set_output(uint8_t n, uint8_t ccr, uint8_t level)
+{
+    uint32_t shs;
+
+    if (timer[n].out[ccr] == level)
+        return;
+    timer[n].out[ccr] = level;
+
+    if (HOST_timer_output)
+        HOST_timer_output(n, ccr, level);
+
+    // ADC14 SHS 1 - 7 = TA0.1, TA0.2, TA1.1, TA1.2, TA2.1, TA2.2, TA3.1
+    shs = (ADC->CTL0 & ADC14_CTL0_SHS_MASK) >> ADC14_CTL0_SHS_OFS;
+    if (level && shs && ((shs - 1) / 2 == n) && ((shs - 1) % 2 + 1 == ccr))
+        adc_trigger();
+}
+
+static void ta_flag(uint8_t n, uint8_t ccr)
+{
+    put16(&TA(n)->CCTL[ccr], TA(n)->CCTL[ccr] | TIMER_A_CCTLN_CCIFG);
+    if (ccr == 0)
+        dma_trigger(2 * n, 6);
+    else if (ccr == 2)
+        dma_trigger(2 * n + 1, 6);
+}
+
+// output unit action for EQUn (equ0 = 0) or EQU0 (equ0 = 1)
+static void ta_output_event(uint8_t n, uint8_t ccr, uint8_t equ0)
+{
+    uint8_t mode = (TA(n)->CCTL[ccr] & TIMER_A_CCTLN_OUTMOD_MASK) >> TIMER_A_CCTLN_OUTMOD_OFS;
+    uint8_t out = timer[n].out[ccr];
+
+    if (!equ0) {
+        switch (mode) {
+            case 1: case 3: out = 1; break;
+            case 2: case 4: case 6: out = !out; break;
+            case 5: case 7: out = 0; break;
+        }
+    } else {
+        switch (mode) {
+            case 2: case 3: out = 0; break;
+            case 6: case 7: out = 1; break;
+        }
+    }
+    ta_set_output(n, ccr, out);
+}
+
+// count reached the phase in timer[n].phase
+static void ta_events(uint8_t n)
+{
+    uint16_t count = ta_count_of(n, timer[n].phase);
+    uint8_t ccr, equ0 = (count == TA(n)->CCR[0]);
+
+    for (ccr = 0; ccr < 7; ccr++) {
+        if (TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CAP)
+            continue;
+        if (count == TA(n)->CCR[ccr]) {
+            ta_flag(n, ccr);
+            ta_output_event(n, ccr, 0);
+        }
+        if (equ0 && ccr)
+            ta_output_event(n, ccr, 1);
+    }
+
+    if (timer[n].phase == 0)
+        put16(&TA(n)->CTL, TA(n)->CTL | TIMER_A_CTL_IFG);
+}
+
+// counts from the current phase to the next one with something to do
+static uint32_t ta_distance(uint8_t n)
+{
+    uint32_t period = ta_period(n), top = ta_top(n);
+    uint32_t phase = timer[n].phase, best = period, target[2], d;
+    uint8_t ccr, k;
+
+    for (ccr = 0; ccr < 8; ccr++) {
+        if (ccr < 7) {
+            if (TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CAP)
+                continue;
+            target[0] = TA(n)->CCR[ccr];
+            target[1] = (ta_mode(n) == 3) ? 2 * top - target[0] : target[0];
+        } else {
+            target[0] = target[1] = 0;  // roll over
+        }
+        for (k = 0; k < 2; k++) {
+            if (target[k] >= period)
+                continue;
+            d = (target[k] + period - phase - 1) % period + 1;
+            if (d < best)
+                best = d;
+        }
+    }
+    return best;
+}
+
+static void ta_count(uint8_t n, uint64_t counts)
+{
+    uint32_t period, d;
+
+    while (counts) {
+        period = ta_period(n);
+        if (!period)
+            break;
+        if (timer[n].phase >= period)   // period made shorter than the count
+            timer[n].phase = period - 1;
+        d = ta_distance(n);
+        if (counts < d) {
+            timer[n].phase = (uint32_t)((timer[n].phase + counts) % period);
+            break;
+        }
+        timer[n].phase = (timer[n].phase + d) % period;
+        counts -= d;
+        ta_events(n);
+    }
+    put16(&TA(n)->R, ta_count_of(n, timer[n].phase));
+}
+
+static void ta_edges(uint8_t n, uint64_t edges)
+{
+    uint64_t total = timer[n].prescale + edges;
+    uint32_t div = ta_divider(n);
+
+    timer[n].prescale = total % div;
+    ta_count(n, total / div);
+}
+
+static void ta_step(uint8_t n, uint64_t time)
+{
+    Domain* d = ta_domain(n);
+    uint64_t edges;
+
+    if (!d)
+        return;
+    edges = edges_at(d, time);
+    if (ta_period(n))
+        ta_edges(n, edges - timer[n].edges);
+    timer[n].edges = edges;
+}
+
+static uint64_t ta_next(uint8_t n)
+{
+    Domain* d = ta_domain(n);
+
+    if (!d || !d->hz || !ta_period(n))
+        return HOST_NEVER;
+    return edge_time(d, timer[n].edges + (uint64_t)ta_distance(n) * ta_divider(n)
+                        - timer[n].prescale);
+}
+
+static uint8_t ta_input_level(uint8_t n, uint8_t ccr)
+{
+    switch ((TA(n)->CCTL[ccr] & TIMER_A_CCTLN_CCIS_MASK) >> TIMER_A_CCTLN_CCIS_OFS) {
+        case 0:  return timer[n].input[ccr][0];
+        case 1:  return timer[n].input[ccr][1];
+        case 2:  return 0;
+        default: return 1;
+    }
+}
+
+// selected capture input went from old to level
+static void ta_capture(uint8_t n, uint8_t ccr, uint8_t old, uint8_t level)
+{
+    uint16_t cctl = TA(n)->CCTL[ccr];
+    uint16_t cm = (cctl & TIMER_A_CCTLN_CM_MASK) >> TIMER_A_CCTLN_CM_OFS;
+
+    cctl = level ? (cctl | TIMER_A_CCTLN_CCI) : (cctl & ~TIMER_A_CCTLN_CCI);
+    put16(&TA(n)->CCTL[ccr], cctl);
+
+    if (!(cctl & TIMER_A_CCTLN_CAP) || (old == level))
+        return;
+    if (!((level && (cm & 1)) || (!level && (cm & 2))))
+        return;
+
+    if (cctl & TIMER_A_CCTLN_CCIFG)
+        put16(&TA(n)->CCTL[ccr], TA(n)->CCTL[ccr] | TIMER_A_CCTLN_COV);
+    put16(&TA(n)->CCR[ccr], TA(n)->R);
+    ta_flag(n, ccr);
+}
+
+static void ta_write(uint8_t n, uint16_t offset, uint32_t old, uint32_t value)
+{
+    uint8_t ccr;
+
+    if (offset == offsetof(Timer_A_Type, CTL)) {
+        if ((old ^ value) & TIMER_A_CTL_SSEL_MASK) {
+            Domain* d = ta_domain(n);
+
+            timer[n].edges = d ? edges_at(d, now) : 0;
+        }
+        if (value & TIMER_A_CTL_CLR) {
+            timer[n].phase = 0;
+            timer[n].prescale = 0;
+            put16(&TA(n)->R, 0);
+            put16(&TA(n)->CTL, value & ~TIMER_A_CTL_CLR);
+        }
+    }
+    else if (offset < offsetof(Timer_A_Type, R)) {
+        ccr = (offset - 2) / 2;
+        if (!((value & TIMER_A_CCTLN_OUTMOD_MASK)))
+            ta_set_output(n, ccr, (value & TIMER_A_CCTLN_OUT) != 0);
+        if ((old ^ value) & TIMER_A_CCTLN_CCIS_MASK) {
+            // CCIS GND <-> VCC is a capture by software
+            uint16_t saved = value;
+
+            put16(&TA(n)->CCTL[ccr], (value & ~TIMER_A_CCTLN_CCIS_MASK) | (old & TIMER_A_CCTLN_CCIS_MASK));
+            uint8_t before = ta_input_level(n, ccr);
+            put16(&TA(n)->CCTL[ccr], saved);
+            ta_capture(n, ccr, before, ta_input_level(n, ccr));
+        }
+    }
+    else if (offset == offsetof(Timer_A_Type, R)) {
+        timer[n].phase = value;
+    }
+    else if (offset == offsetof(Timer_A_Type, EX0)) {
+        timer[n].prescale = 0;
+    }
+    else if (offset == offsetof(Timer_A_Type, IV)) {
+        put16(&TA(n)->IV, old);
+    }
+}
+
+/******************************************************************************
+* SysTick, Timer32 and the cycle counter                                      *
+******************************************************************************/
+
+static void systick_step(uint64_t time)
+{
+    uint64_t edges = edges_at(&domain[D_MCLK], time), k = edges - systick_edges;
+    uint32_t value = STK->VAL, load = STK->LOAD & SysTick_LOAD_RELOAD_Msk;
+
+    systick_edges = edges;
+    if (!(STK->CTRL_[0] & SysTick_CTRL_ENABLE_Msk))
+        return;
+
+    while (k) {
+        if (value == 0) {
+            if (!load)
+                break;
+            value = load;               // reload takes an edge
+            k--;
+            continue;
+        }
+        if (k < value) {
+            value -= (uint32_t)k;
+            break;
+        }
+        k -= value;
+        value = 0;
+        put32(&STK->CTRL_[0], STK->CTRL_[0] | SysTick_CTRL_COUNTFLAG_Msk);
+        if (STK->CTRL_[0] & SysTick_CTRL_TICKINT_Msk)
+            systick_pending = 1;
+    }
+    put32(&STK->VAL, value);
+}
+
+static uint64_t systick_next(void)
+{
+    uint32_t value = STK->VAL, load = STK->LOAD & SysTick_LOAD_RELOAD_Msk;
+
+    if (!(STK->CTRL_[0] & SysTick_CTRL_ENABLE_Msk) || (!value && !load))
+        return HOST_NEVER;
+    return edge_time(&domain[D_MCLK], systick_edges + (value ? value : load + 1));
+}
+
+static void systick_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == 0x08) {               // VAL, any write clears it
+        put32(&STK->VAL, 0);
+        put32(&STK->CTRL_[0], STK->CTRL_[0] & ~SysTick_CTRL_COUNTFLAG_Msk);
+    }
+    else if (offset == 0x00) {          // COUNTFLAG is read only
+        put32(&STK->CTRL_[0], (value & ~SysTick_CTRL_COUNTFLAG_Msk) |
+                              (old & SysTick_CTRL_COUNTFLAG_Msk));
+    }
+}
+
+static uint32_t t32_max(uint8_t n)
+{
+    return (T32(n)->CONTROL & TIMER32_CONTROL_SIZE) ? 0xFFFFFFFF : 0xFFFF;
+}
+
+static uint32_t t32_divider(uint8_t n)
+{
+    return 1u << (4 * ((T32(n)->CONTROL & TIMER32_CONTROL_PRESCALE_MASK) >> TIMER32_CONTROL_PRESCALE_OFS));
+}
+
+static void t32_zero(uint8_t n)
+{
+    put32((volatile uint32_t*)&T32(n)->RIS, 1);
+    put32((volatile uint32_t*)&T32(n)->MIS, (T32(n)->CONTROL & TIMER32_CONTROL_IE) ? 1 : 0);
+}
+
+static void t32_step(uint8_t n, uint64_t time)
+{
+    uint64_t edges = edges_at(&domain[D_MCLK], time), total, k;
+    uint32_t value = T32(n)->VALUE, control = T32(n)->CONTROL;
+
+    total = t32_prescale[n] + (edges - t32_edges[n]);
+    t32_edges[n] = edges;
+    if (!(control & TIMER32_CONTROL_ENABLE))
+        return;
+    t32_prescale[n] = total % t32_divider(n);
+    k = total / t32_divider(n);
+
+    while (k) {
+        if (value == 0) {
+            if (control & TIMER32_CONTROL_ONESHOT)
+                break;
+            value = (control & TIMER32_CONTROL_MODE) ? T32(n)->LOAD : t32_max(n);
+            k--;
+            continue;
+        }
+        if (k < value) {
+            value -= (uint32_t)k;
+            break;
+        }
+        k -= value;
+        value = 0;
+        t32_zero(n);
+    }
+    put32((volatile uint32_t*)&T32(n)->VALUE, value);
+}
+
+static uint64_t t32_next(uint8_t n)
+{
+    uint32_t value = T32(n)->VALUE, control = T32(n)->CONTROL;
+    uint64_t counts;
+
+    if (!(control & TIMER32_CONTROL_ENABLE))
+        return HOST_NEVER;
+    if (value)
+        counts = value;
+    else if (control & TIMER32_CONTROL_ONESHOT)
+        return HOST_NEVER;
+    else
+        counts = 1 + ((control & TIMER32_CONTROL_MODE) ? T32(n)->LOAD : t32_max(n));
+    if (counts == 1 && !value && !(control & TIMER32_CONTROL_MODE) && !t32_max(n))
+        return HOST_NEVER;
+    return edge_time(&domain[D_MCLK], t32_edges[n] + counts * t32_divider(n) - t32_prescale[n]);
+}
+
+static void t32_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    uint8_t n = offset / 0x20;
+
+    switch (offset % 0x20) {
+        case 0x00:                      // LOAD also loads the count
+            put32((volatile uint32_t*)&T32(n)->VALUE, value & t32_max(n));
+            put32(&T32(n)->BGLOAD, value);
+            break;
+        case 0x04: case 0x10: case 0x14:    // read only
+            put32((volatile uint32_t*)((uint8_t*)T32(n) + offset % 0x20), old);
+            break;
+        case 0x08:
+            if ((value ^ old) & TIMER32_CONTROL_ENABLE)
+                t32_prescale[n] = 0;
+            put32((volatile uint32_t*)&T32(n)->MIS, (T32(n)->RIS && (value & TIMER32_CONTROL_IE)) ? 1 : 0);
+            break;
+        case 0x0C:                      // INTCLR, any value
+            put32((volatile uint32_t*)&T32(n)->RIS, 0);
+            put32((volatile uint32_t*)&T32(n)->MIS, 0);
+            put32((volatile uint32_t*)&T32(n)->INTCLR, T32_INTCLR_IDLE);
+            break;
+        case 0x18:                      // BGLOAD, used at the next reload
+            put32(&T32(n)->LOAD, value);
+            break;
+    }
+}
+
+static uint32_t cyccnt(void)
+{
+    return (uint32_t)(cpu_cycles - cyccnt_base);
+}
+
+static void dwt_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == offsetof(DWT_Type, CYCCNT))
+        cyccnt_base = cpu_cycles - value;
+    else if ((offset == 0) && ((old ^ value) & DWT_CTRL_CYCCNTENA_Msk) && (value & DWT_CTRL_CYCCNTENA_Msk))
+        cyccnt_base = cpu_cycles - DWTR->CYCCNT;   // carry on from the stopped count
+}
+
+static void dwt_update(void)
+{
+    if ((DWTR->CTRL_[0] & DWT_CTRL_CYCCNTENA_Msk) &&
+        (((CoreDebug_Type*)(HOST_scs + 0xDF0))->DEMCR & CoreDebug_DEMCR_TRCENA_Msk))
+        put32(&DWTR->CYCCNT, cyccnt());
+}
+
+/******************************************************************************
+* GPIO                                                                        *
+******************************************************************************/
+
+#define DIO_IN      0x00
+#define DIO_OUT     0x02
+#define DIO_DIR     0x04
+#define DIO_REN     0x06
+#define DIO_IES     0x18
+#define DIO_IFG     0x1C
+
+// byte register reg of port 1 - 10, 11 = PJ
+static volatile uint8_t* dio_reg(uint8_t port, uint8_t reg)
+{
+    if (port == 11)
+        return DIO + 0x120 + reg;
+    return DIO + ((port - 1) / 2) * 0x20 + ((port - 1) & 1) + reg;
+}
+
+static void pin_update(uint8_t port)
+{
+    uint8_t dir = *dio_reg(port, DIO_DIR), out = *dio_reg(port, DIO_OUT);
+    uint8_t ren = *dio_reg(port, DIO_REN), old = *dio_reg(port, DIO_IN);
+    uint8_t in, rise, fall, ies;
+
+    in = (dir & out) | (~dir & port_drive[port] & port_ext[port])
+       | (~dir & ~port_drive[port] & ren & out);
+    if (in == old)
+        return;
+    put8(dio_reg(port, DIO_IN), in);
+
+    if (port > 6)
+        return;                         // P7 - P10 and PJ have no interrupts
+    ies = *dio_reg(port, DIO_IES);
+    rise = in & ~old & ~ies;
+    fall = ~in & old & ies;
+    if (rise | fall)
+        put8(dio_reg(port, DIO_IFG), *dio_reg(port, DIO_IFG) | rise | fall);
+}
+
+static void dio_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    uint8_t port, reg;
+
+    if (offset >= 0x120) {
+        port = 11;
+        reg = (offset - 0x120) & ~1;
+    } else {
+        port = (offset / 0x20) * 2 + 1 + (offset & 1);
+        reg = (offset % 0x20) & ~1;
+    }
+
+    if (reg == DIO_IN) {
+        put8(DIO + offset, old);        // read only
+        return;
+    }
+    if ((reg == DIO_OUT) || (reg == DIO_DIR) || (reg == DIO_REN))
+        pin_update(port);
+    if (((reg == DIO_OUT) || (reg == DIO_DIR)) && HOST_port_out)
+        HOST_port_out(port, *dio_reg(port, DIO_OUT), *dio_reg(port, DIO_DIR));
+}
+
+/******************************************************************************
+* eUSCI_A UART                                                                *
+******************************************************************************/
+
+static Domain* usci_domain(uint16_t ctlw0)
+{
+    switch (ctlw0 & EUSCI_A_CTLW0_SSEL_MASK) {
+        case EUSCI_A_CTLW0_SSEL__ACLK:  return &domain[D_ACLK];
+        case EUSCI_A_CTLW0_SSEL__UCLK:  return 0;
+        default:                        return &domain[D_SMCLK];
+    }
+}
+
+// time after cycles BRCLK edges from now
+static uint64_t usci_after(uint16_t ctlw0, uint64_t cycles)
+{
+    Domain* d = usci_domain(ctlw0);
+
+    if (!d || !d->hz)
+        return HOST_NEVER;
+    return edge_time(d, edges_at(d, now) + cycles);
+}
+
+static uint64_t uart_byte_cycles(uint8_t n)
+{
+    uint16_t ctl = UCA(n)->CTLW0, brw = UCA(n)->BRW ? UCA(n)->BRW : 1;
+    uint16_t mctlw = UCA(n)->MCTLW;
+    uint64_t bits = 10, bit;
+
+    if (ctl & EUSCI_A_CTLW0_PEN)      bits++;
+    if (ctl & EUSCI_A_CTLW0_SPB)      bits++;
+    if (ctl & EUSCI_A_CTLW0_SEVENBIT) bits--;
+
+    if (mctlw & EUSCI_A_MCTLW_OS16)
+        bit = 16 * brw + ((mctlw & EUSCI_A_MCTLW_BRF_MASK) >> EUSCI_A_MCTLW_BRF_OFS);
+    else
+        bit = brw;
+    return bits * bit;
+}
+
+static void uart_status(uint8_t n)
+{
+    uint16_t statw = UCA(n)->STATW & ~EUSCI_A_STATW_BUSY;
+
+    if (uart[n].tx_full || (uart[n].tx_done != HOST_NEVER) || (uart[n].rx_next != HOST_NEVER))
+        statw |= EUSCI_A_STATW_BUSY;
+    put16(&UCA(n)->STATW, statw);
+}
+
+static void uart_set_ifg(uint8_t n, uint16_t bits)
+{
+    uint16_t ifg = UCA(n)->IFG;
+
+    put16(&UCA(n)->IFG, ifg | bits);
+    if ((bits & EUSCI_A_IFG_TXIFG) && !(ifg & EUSCI_A_IFG_TXIFG))
+        dma_trigger(2 * n, 1);
+    if ((bits & EUSCI_A_IFG_RXIFG) && !(ifg & EUSCI_A_IFG_RXIFG))
+        dma_trigger(2 * n + 1, 1);
+}
+
+static void uart_reset(uint8_t n)
+{
+    put16(&UCA(n)->IE, 0);
+    put16(&UCA(n)->IFG, EUSCI_A_IFG_TXIFG);
+    put16(&UCA(n)->STATW, 0);
+    put16(&UCA(n)->TXBUF, TXBUF_EMPTY);
+    uart[n].tx_full = 0;
+    uart[n].tx_load = uart[n].tx_done = HOST_NEVER;
+    uart[n].rx_next = HOST_NEVER;
+    uart[n].rx_head = uart[n].rx_tail = 0;
+}
+
+static void uart_txbuf(uint8_t n, uint16_t value)
+{
+    put16(&UCA(n)->TXBUF, TXBUF_EMPTY);
+    if (UCA(n)->CTLW0 & EUSCI_A_CTLW0_SWRST)
+        return;
+
+    if (!(UCA(n)->IFG & EUSCI_A_IFG_TXIFG))
+        HOST_stats.overruns++;          // written before the last one moved
+    put16(&UCA(n)->IFG, UCA(n)->IFG & ~EUSCI_A_IFG_TXIFG);
+    uart[n].txbuf = value & 0xFF;
+    uart[n].tx_full = 1;
+    if (uart[n].tx_done == HOST_NEVER)
+        uart[n].tx_load = usci_after(UCA(n)->CTLW0, 1);
+    uart_status(n);
+}
+
+static void uca_write(uint8_t n, uint16_t offset, uint32_t old, uint32_t value)
+{
+    switch (offset) {
+        case offsetof(EUSCI_A_Type, CTLW0):
+            if (value & EUSCI_A_CTLW0_SWRST)
+                uart_reset(n);
+            break;
+        case offsetof(EUSCI_A_Type, TXBUF):
+            if (value != TXBUF_EMPTY)
+                uart_txbuf(n, value);
+            break;
+        case offsetof(EUSCI_A_Type, IFG):
+            if ((value & ~old) & EUSCI_A_IFG_TXIFG)
+                dma_trigger(2 * n, 1);
+            if ((value & ~old) & EUSCI_A_IFG_RXIFG)
+                dma_trigger(2 * n + 1, 1);
+            break;
+        case offsetof(EUSCI_A_Type, RXBUF_):
+        case offsetof(EUSCI_A_Type, STATW):
+        case offsetof(EUSCI_A_Type, IV):
+            put16((volatile uint16_t*)((uint8_t*)UCA(n) + offset), old);    // read only
+            break;
+    }
+}
+
+static void uart_rx_read(uint8_t n)
+{
+    put16(&UCA(n)->IFG, UCA(n)->IFG & ~EUSCI_A_IFG_RXIFG);
+    put16(&UCA(n)->STATW, UCA(n)->STATW & ~EUSCI_A_STATW_OE);
+}
+
+static void uart_run(uint8_t n)
+{
+    Uart* u = &uart[n];
+
+    if (u->tx_done <= now) {
+        u->tx_done = HOST_NEVER;
+        if (HOST_uart_tx)
+            HOST_uart_tx(n, u->shift);
+        if (u->tx_full)
+            u->tx_load = now;
+    }
+
+    if ((u->tx_load <= now) && u->tx_full) {
+        u->shift = (uint8_t)u->txbuf;
+        u->tx_full = 0;
+        u->tx_load = HOST_NEVER;
+        u->tx_done = usci_after(UCA(n)->CTLW0, uart_byte_cycles(n));
+        uart_set_ifg(n, EUSCI_A_IFG_TXIFG);
+    }
+
+    if (u->rx_next <= now) {
+        if (UCA(n)->IFG & EUSCI_A_IFG_RXIFG)
+            put16(&UCA(n)->STATW, UCA(n)->STATW | EUSCI_A_STATW_OE);
+        put16(&UCA(n)->RXBUF_[0], u->rx_queue[u->rx_tail++]);
+        uart_set_ifg(n, EUSCI_A_IFG_RXIFG);
+        u->rx_next = (u->rx_tail != u->rx_head)
+                   ? usci_after(UCA(n)->CTLW0, uart_byte_cycles(n)) : HOST_NEVER;
+    }
+
+    uart_status(n);
+}
+
+static uint64_t uart_next(uint8_t n)
+{
+    uint64_t next = uart[n].tx_done;
+
+    if (uart[n].tx_full && (uart[n].tx_load < next))
+        next = uart[n].tx_load;
+    if (uart[n].rx_next < next)
+        next = uart[n].rx_next;
+    return next;
+}
+
+void HOST_uart_rx(uint8_t n, uint8_t byte)
+{
+    Uart* u = &uart[n];
+
+    if ((uint8_t)(u->rx_head + 1) == u->rx_tail)
+        return;                         // host queue full
+    u->rx_queue[u->rx_head++] = byte;
+    if (u->rx_next == HOST_NEVER)
+        u->rx_next = usci_after(UCA(n)->CTLW0, uart_byte_cycles(n));
+}
+
+/******************************************************************************
+* eUSCI_B SPI and I2C                                                         *
+******************************************************************************/
+
+static uint8_t ucb_i2c(uint8_t n)
+{
+    return (UCB(n)->CTLW0 & EUSCI_B_CTLW0_MODE_MASK) == EUSCI_B_CTLW0_MODE_3;
+}
+
+static void ucb_set_ifg(uint8_t n, uint16_t bits)
+{
+    uint16_t ifg = UCB(n)->IFG;
+
+    put16(&UCB(n)->IFG, ifg | bits);
+    if ((bits & EUSCI_B_IFG_TXIFG0) && !(ifg & EUSCI_B_IFG_TXIFG0))
+        dma_trigger(2 * n, 2);
+    if ((bits & EUSCI_B_IFG_RXIFG0) && !(ifg & EUSCI_B_IFG_RXIFG0))
+        dma_trigger(2 * n + 1, 2);
+}
+
+static void ucb_ctl_clear(uint8_t n, uint16_t bits)
+{
+    put16(&UCB(n)->CTLW0, UCB(n)->CTLW0 & ~bits);
+}
+
+static void spi_ste(uint8_t n)
+{
+    uint8_t active = usci[n].tx_full || (usci[n].tx_done != HOST_NEVER);
+    uint16_t statw = UCB(n)->STATW & ~EUSCI_B_STATW_SPI_BUSY;
+
+    put16(&UCB(n)->STATW, statw | (active ? EUSCI_B_STATW_SPI_BUSY : 0));
+
+    if (!(UCB(n)->CTLW0 & EUSCI_B_CTLW0_STEM) ||
+        !(UCB(n)->CTLW0 & EUSCI_B_CTLW0_MODE_MASK))
+        active = 0;                     // 3-pin, chip select by GPIO
+    if (active != usci[n].ste) {
+        usci[n].ste = active;
+        if (HOST_spi_ste)
+            HOST_spi_ste(n, active);
+    }
+}
+
+static uint64_t ucb_bit_cycles(uint8_t n)
+{
+    return UCB(n)->BRW ? UCB(n)->BRW : 1;
+}
+
+static uint64_t ucb_after(uint8_t n, uint64_t bits)
+{
+    return usci_after(UCB(n)->CTLW0, bits * ucb_bit_cycles(n));
+}
+
+static void i2c_start(uint8_t n)
+{
+    usci[n].state = I2C_ADDR;
+    usci[n].target = usci[n].targets[UCB(n)->I2CSA & 0x7F];
+    if (UCB(n)->CTLW0 & EUSCI_B_CTLW0_TR)
+        ucb_set_ifg(n, EUSCI_B_IFG_TXIFG0);     // first byte can be written
+    usci[n].i2c_time = ucb_after(n, 10);        // start and address + R/W + ACK
+    put16(&UCB(n)->STATW, UCB(n)->STATW | EUSCI_B_STATW_BBUSY);
+}
+
+static void i2c_stop(uint8_t n)
+{
+    usci[n].state = I2C_STOP;
+    usci[n].i2c_time = ucb_after(n, 1);
+}
+
+static void i2c_tx_byte(uint8_t n)
+{
+    usci[n].shift = (uint8_t)usci[n].txbuf;
+    usci[n].tx_full = 0;
+    usci[n].state = I2C_TX_BYTE;
+    usci[n].i2c_time = ucb_after(n, 9);
+    ucb_set_ifg(n, EUSCI_B_IFG_TXIFG0);
+}
+
+static void i2c_rx_byte(uint8_t n)
+{
+    usci[n].state = I2C_RX_BYTE;
+    usci[n].i2c_time = ucb_after(n, 9);
+}
+
+// a byte or address ended, stop and restart requests go first
+static void i2c_next(uint8_t n, uint8_t tx)
+{
+    uint16_t ctl = UCB(n)->CTLW0;
+
+    if (ctl & EUSCI_B_CTLW0_TXSTP)
+        i2c_stop(n);
+    else if (ctl & EUSCI_B_CTLW0_TXSTT)
+        i2c_start(n);
+    else if (!tx)
+        usci[n].state = I2C_RX_HOLD;
+    else if (usci[n].tx_full)
+        i2c_tx_byte(n);
+    else
+        usci[n].state = I2C_TX_WAIT;
+}
+
+static void i2c_run(uint8_t n)
+{
+    Usci* u = &usci[n];
+    const HOST_i2c_target* t = u->target;
+    uint8_t ack, read;
+
+    if (u->i2c_time > now)
+        return;
+    u->i2c_time = HOST_NEVER;
+
+    switch (u->state) {
+        case I2C_ADDR:
+            read = !(UCB(n)->CTLW0 & EUSCI_B_CTLW0_TR);
+            ack = t && t->start(t->ctx, read);
+            ucb_ctl_clear(n, EUSCI_B_CTLW0_TXSTT);
+            if (!ack) {
+                ucb_set_ifg(n, EUSCI_B_IFG_NACKIFG);
+                u->state = I2C_NACK_HOLD;
+                if (UCB(n)->CTLW0 & EUSCI_B_CTLW0_TXSTP)
+                    i2c_stop(n);
+            } else if (read) {
+                i2c_rx_byte(n);         // a stop set now ends after this byte
+            } else {
+                i2c_next(n, 1);
+            }
+            break;
+
+        case I2C_TX_BYTE:
+            ack = t && t->write(t->ctx, u->shift);
+            if (!ack) {
+                ucb_set_ifg(n, EUSCI_B_IFG_NACKIFG);
+                u->state = I2C_NACK_HOLD;
+                if (UCB(n)->CTLW0 & EUSCI_B_CTLW0_TXSTP)
+                    i2c_stop(n);
+            } else {
+                i2c_next(n, 1);
+            }
+            break;
+
+        case I2C_RX_BYTE:
+            put16(&UCB(n)->RXBUF_[0], t ? t->read(t->ctx) : 0xFF);
+            ucb_set_ifg(n, EUSCI_B_IFG_RXIFG0);
+            i2c_next(n, 0);
+            break;
+
+        case I2C_STOP:
+            if (t && t->stop)
+                t->stop(t->ctx);
+            u->target = 0;
+            u->state = I2C_IDLE;
+            ucb_ctl_clear(n, EUSCI_B_CTLW0_TXSTP);
+            ucb_set_ifg(n, EUSCI_B_IFG_STPIFG);
+            put16(&UCB(n)->STATW, UCB(n)->STATW & ~EUSCI_B_STATW_BBUSY);
+            break;
+    }
+}
+
+// CTLW0 start / stop requests that act while the bus is held
+static void i2c_control(uint8_t n, uint16_t old, uint16_t value)
+{
+    Usci* u = &usci[n];
+    uint8_t held = (u->state == I2C_TX_WAIT) || (u->state == I2C_NACK_HOLD);
+
+    if ((value & ~old & EUSCI_B_CTLW0_TXSTT) && ((u->state == I2C_IDLE) || held))
+        i2c_start(n);
+    else if ((value & ~old & EUSCI_B_CTLW0_TXSTP) && held)
+        i2c_stop(n);
+}
+
+static void ucb_reset(uint8_t n)
+{
+    put16(&UCB(n)->IE, 0);
+    put16(&UCB(n)->IFG, EUSCI_B_IFG_TXIFG0);
+    put16(&UCB(n)->STATW, 0);
+    put16(&UCB(n)->TXBUF, TXBUF_EMPTY);
+    usci[n].tx_full = 0;
+    usci[n].tx_load = usci[n].tx_done = HOST_NEVER;
+    usci[n].state = I2C_IDLE;
+    usci[n].i2c_time = HOST_NEVER;
+    usci[n].target = 0;
+    spi_ste(n);
+}
+
+static void ucb_txbuf(uint8_t n, uint16_t value)
+{
+    put16(&UCB(n)->TXBUF, TXBUF_EMPTY);
+    if (UCB(n)->CTLW0 & EUSCI_B_CTLW0_SWRST)
+        return;
+
+    if (!(UCB(n)->IFG & EUSCI_B_IFG_TXIFG0))
+        HOST_stats.overruns++;
+    put16(&UCB(n)->IFG, UCB(n)->IFG & ~EUSCI_B_IFG_TXIFG0);
+    usci[n].txbuf = value & 0xFF;
+    usci[n].tx_full = 1;
+
+    if (ucb_i2c(n)) {
+        if (usci[n].state == I2C_TX_WAIT)
+            i2c_tx_byte(n);
+        return;
+    }
+    if (usci[n].tx_done == HOST_NEVER)
+        usci[n].tx_load = usci_after(UCB(n)->CTLW0, 1);
+    spi_ste(n);
+}
+
+static void ucb_write(uint8_t n, uint16_t offset, uint32_t old, uint32_t value)
+{
+    switch (offset) {
+        case offsetof(EUSCI_B_Type, CTLW0):
+            if (value & EUSCI_B_CTLW0_SWRST)
+                ucb_reset(n);
+            else if (ucb_i2c(n))
+                i2c_control(n, old, value);
+            break;
+        case offsetof(EUSCI_B_Type, TXBUF):
+            if (value != TXBUF_EMPTY)
+                ucb_txbuf(n, value);
+            break;
+        case offsetof(EUSCI_B_Type, IFG):
+            if ((value & ~old) & EUSCI_B_IFG_TXIFG0)
+                dma_trigger(2 * n, 2);
+            if ((value & ~old) & EUSCI_B_IFG_RXIFG0)
+                dma_trigger(2 * n + 1, 2);
+            break;
+        case offsetof(EUSCI_B_Type, RXBUF_):
+        case offsetof(EUSCI_B_Type, STATW):
+        case offsetof(EUSCI_B_Type, IV):
+            put16((volatile uint16_t*)((uint8_t*)UCB(n) + offset), old);
+            break;
+    }
+}
+
+static void ucb_rx_read(uint8_t n)
+{
+    put16(&UCB(n)->IFG, UCB(n)->IFG & ~EUSCI_B_IFG_RXIFG0);
+    put16(&UCB(n)->STATW, UCB(n)->STATW & ~EUSCI_B_STATW_OE);
+    if (ucb_i2c(n) && (usci[n].state == I2C_RX_HOLD))
+        i2c_rx_byte(n);                 // SCL was held until the read
+}
+
+static void spi_run(uint8_t n)
+{
+    Usci* u = &usci[n];
+    uint8_t miso;
+
+    if (u->tx_done <= now) {
+        u->tx_done = HOST_NEVER;
+        miso = HOST_spi_byte ? HOST_spi_byte(n, u->shift) : 0xFF;
+        if (UCB(n)->IFG & EUSCI_B_IFG_RXIFG0)
+            put16(&UCB(n)->STATW, UCB(n)->STATW | EUSCI_B_STATW_OE);
+        put16(&UCB(n)->RXBUF_[0], miso);
+        ucb_set_ifg(n, EUSCI_B_IFG_RXIFG0);
+        if (u->tx_full)
+            u->tx_load = now;
+    }
+
+    if ((u->tx_load <= now) && u->tx_full) {
+        u->shift = (uint8_t)u->txbuf;
+        u->tx_full = 0;
+        u->tx_load = HOST_NEVER;
+        u->tx_done = ucb_after(n, 8);
+        ucb_set_ifg(n, EUSCI_B_IFG_TXIFG0);
+    }
+    spi_ste(n);
+}
+
+static uint64_t ucb_next(uint8_t n)
+{
+    uint64_t next = usci[n].i2c_time;
+
+    if (usci[n].tx_done < next)
+        next = usci[n].tx_done;
+    if (usci[n].tx_full && (usci[n].tx_load < next))
+        next = usci[n].tx_load;
+    return next;
+}
+
+void HOST_i2c_attach(uint8_t bus, uint8_t address, const HOST_i2c_target* target)
+{
+    usci[bus].targets[address & 0x7F] = target;
+}
+
+/******************************************************************************
+* uDMA                                                                        *
+******************************************************************************/
+
+typedef struct {
+    volatile void* src_end;
+    volatile void* dst_end;
+    uint32_t control;
+    uint32_t spare;
+} Descriptor;
+
+#define DMA_CHANNELS    8
+
+static void block_write_at(uintptr_t address, uint8_t bytes);
+
+static void dma_read_effect(uintptr_t address)
+{
+    uintptr_t offset = address - (uintptr_t)HOST_periph;
+    uint8_t n;
+
+    if (offset >= sizeof(HOST_periph))
+        return;
+    for (n = 0; n < 4; n++) {
+        if (offset == 0x1000 + 0x400 * n + offsetof(EUSCI_A_Type, RXBUF_))
+            uart_rx_read(n);
+        if (offset == 0x2000 + 0x400 * n + offsetof(EUSCI_B_Type, RXBUF_))
+            ucb_rx_read(n);
+    }
+    if ((offset >= 0x12000 + offsetof(ADC14_Type, MEM)) &&
+        (offset < 0x12000 + offsetof(ADC14_Type, MEM) + 32 * 4)) {
+        n = (offset - 0x12000 - offsetof(ADC14_Type, MEM)) / 4;
+        put32((volatile uint32_t*)&ADC->IFGR0, ADC->IFGR0 & ~BIT(n));
+    }
+}
+
+static void dma_done(uint8_t ch)
+{
+    uint8_t n;
+
+    put32((volatile uint32_t*)&DMACH->INT0_SRCFLG, DMACH->INT0_SRCFLG | BIT(ch));
+    for (n = 0; n < 3; n++) {
+        uint32_t cfg = (&DMACH->INT1_SRCCFG)[n];
+
+        if ((cfg & DMA_INT1_SRCCFG_EN) && ((cfg & DMA_INT1_SRCCFG_INT_SRC_MASK) == ch))
+            nvic_pend(DMA_INT1_IRQn - n);
+    }
+}
+
+static void dma_disable(uint8_t ch)
+{
+    dma_enabled &= ~BIT(ch);
+    put32(&DMACTL->ENASET, dma_enabled);
+}
+
+static void dma_transfer(uint8_t ch)
+{
+    Descriptor* table = (Descriptor*)DMACTL->CTLBASE;
+    Descriptor* d = &table[((dma_alt >> ch) & 1) * DMA_CHANNELS + ch];
+    uint32_t control = d->control, cycle = control & 7;
+    uint32_t left = ((control >> 4) & 0x3FF) + 1, count, item;
+    uint8_t src_inc = (control >> 26) & 3, dst_inc = (control >> 30) & 3;
+    uint8_t size = (control >> 24) & 3;
+    uintptr_t src, dst;
+
+    if (!table || (cycle == 0) || (cycle > 3)) {
+        dma_disable(ch);                // no valid descriptor, an error
+        return;
+    }
+
+    count = (cycle == 2) ? left : (1u << ((control >> 14) & 0xF));
+    if (count > left)
+        count = left;
+
+    for (item = 0; item < count; item++) {
+        uint32_t back = left - 1 - item;
+
+        src = (uintptr_t)d->src_end - ((src_inc == 3) ? 0 : ((uintptr_t)back << src_inc));
+        dst = (uintptr_t)d->dst_end - ((dst_inc == 3) ? 0 : ((uintptr_t)back << dst_inc));
+        switch (size) {
+            case 0:  *(volatile uint8_t*)dst = *(volatile uint8_t*)src; break;
+            case 1:  *(volatile uint16_t*)dst = *(volatile uint16_t*)src; break;
+            default: *(volatile uint32_t*)dst = *(volatile uint32_t*)src; break;
+        }
+        dma_read_effect(src);
+        block_write_at(dst, 1 << size); // a register write like the CPU's
+    }
+    HOST_stats.dma_transfers += count;
+
+    left -= count;
+    if (left) {
+        d->control = (control & ~(0x3FFu << 4)) | ((left - 1) << 4);
+        return;
+    }
+
+    d->control = control & ~(0x3FFu << 4 | 7);     // cycle done, n - 1 = 0
+    if (cycle == 3) {
+        Descriptor* next;
+
+        dma_alt ^= BIT(ch);
+        put32(&DMACTL->ALTSET, dma_alt);
+        next = &table[((dma_alt >> ch) & 1) * DMA_CHANNELS + ch];
+        if ((next->control & 7) == 0)
+            dma_disable(ch);
+    } else {
+        dma_disable(ch);
+    }
+    dma_done(ch);
+}
+
+static void dma_service(void)
+{
+    uint8_t ch, pass;
+
+    if (dma_busy)
+        return;                         // the outer call picks these up
+    dma_busy = 1;
+    while (dma_request) {
+        for (pass = 0; pass < 2; pass++)    // high priority channels first
+            for (ch = 0; ch < DMA_CHANNELS; ch++) {
+                if (!(dma_request & BIT(ch)) || (((dma_prio >> ch) & 1) != !pass))
+                    continue;
+                dma_request &= ~BIT(ch);
+                if ((DMACTL->STAT & DMA_CFG_MASTEN) && (dma_enabled & BIT(ch)) &&
+                    !(dma_mask & BIT(ch)))
+                    dma_transfer(ch);
+            }
+    }
+    dma_busy = 0;
+}
+
+static void dma_trigger(uint8_t channel, uint8_t source)
+{
+    if ((channel >= DMA_CHANNELS) || ((DMACH->CH_SRCCFG[channel] & 0xFF) != source))
+        return;
+    dma_request |= BIT(channel);
+    dma_service();
+}
+
+static void dmach_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == offsetof(DMA_Channel_Type, SW_CHTRIG)) {
+        dma_request |= value & (BIT(DMA_CHANNELS) - 1);
+        put32(&DMACH->SW_CHTRIG, 0);
+        dma_service();
+    }
+    else if (offset == offsetof(DMA_Channel_Type, INT0_CLRFLG)) {
+        put32((volatile uint32_t*)&DMACH->INT0_SRCFLG, DMACH->INT0_SRCFLG & ~value);
+        put32(&DMACH->INT0_CLRFLG, 0);
+    }
+    else if ((offset == offsetof(DMA_Channel_Type, INT0_SRCFLG)) ||
+             (offset == offsetof(DMA_Channel_Type, DEVICE_CFG))) {
+        put32((volatile uint32_t*)((uint8_t*)DMACH + offset), old);
+    }
+}
+
+// a set / clear register pair, value written to the set or clear side
+static void dma_bits(uint32_t* bits, volatile uint32_t* set, volatile uint32_t* clear,
+                     uint16_t offset, uint16_t set_offset, uint32_t value)
+{
+    if (offset == set_offset)
+        *bits |= value;
+    else
+        *bits &= ~value;
+    put32(set, *bits);
+    put32(clear, 0);
+}
+
+static void dmactl_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    DMA_Control_Type* c = DMACTL;
+    uint32_t mem;
+
+    memcpy(&mem, (uint8_t*)c + offset, 4);
+
+#define PAIR(bits, set, clr) \
+    if ((offset == offsetof(DMA_Control_Type, set)) || (offset == offsetof(DMA_Control_Type, clr))) { \
+        dma_bits(&bits, &c->set, &c->clr, offset, offsetof(DMA_Control_Type, set), mem); \
+        return; \
+    }
+
+    PAIR(dma_enabled, ENASET, ENACLR);
+    PAIR(dma_alt, ALTSET, ALTCLR);
+    PAIR(dma_mask, REQMASKSET, REQMASKCLR);
+    PAIR(dma_burst, USEBURSTSET, USEBURSTCLR);
+    PAIR(dma_prio, PRIOSET, PRIOCLR);
+#undef PAIR
+
+    if (offset == offsetof(DMA_Control_Type, CFG)) {
+        put32((volatile uint32_t*)&c->STAT, (c->STAT & ~DMA_CFG_MASTEN) | (mem & DMA_CFG_MASTEN) |
+                                            ((DMA_CHANNELS - 1) << 16));
+        put32(&c->CFG, 0);
+    }
+    else if (offset == offsetof(DMA_Control_Type, SWREQ)) {
+        dma_request |= mem & (BIT(DMA_CHANNELS) - 1);
+        put32(&c->SWREQ, 0);
+        dma_service();
+    }
+    else if ((offset >= offsetof(DMA_Control_Type, CTLBASE)) &&
+             (offset < offsetof(DMA_Control_Type, ALTBASE))) {
+        *(volatile uintptr_t*)&c->ALTBASE = c->CTLBASE + DMA_CHANNELS * sizeof(Descriptor);
+        memcpy(shadow_of(&c->ALTBASE), (const void*)&c->ALTBASE, sizeof(uintptr_t));
+    }
+}
+
+/******************************************************************************
+* ADC14                                                                       *
+******************************************************************************/
+
+// time after cycles ADCCLK from now, on the edges of the source clock
+// so a conversion lines up with the timer that triggers it
+static uint64_t adc_after(uint64_t cycles)
+{
+    static const uint8_t pdiv[4] = { 1, 4, 32, 64 };
+    uint32_t ctl0 = ADC->CTL0;
+    uint64_t divider = pdiv[(ctl0 & ADC14_CTL0_PDIV_MASK) >> ADC14_CTL0_PDIV_OFS]
+                     * (((ctl0 & ADC14_CTL0_DIV_MASK) >> ADC14_CTL0_DIV_OFS) + 1);
+    Domain* d;
+
+    switch ((ctl0 & ADC14_CTL0_SSEL_MASK) >> ADC14_CTL0_SSEL_OFS) {
+        case 0:  return now + cycles_time(MHZ(25), cycles * divider);  // MODCLK
+        case 1:  return now + cycles_time(MHZ(5), cycles * divider);   // SYSCLK
+        case 2:  d = &domain[D_ACLK]; break;
+        case 3:  d = &domain[D_MCLK]; break;
+        case 4:  d = &domain[D_SMCLK]; break;
+        default: d = &domain[D_HSMCLK]; break;
+    }
+    if (!d->hz)
+        return HOST_NEVER;
+    return edge_time(d, edges_at(d, now) + cycles * divider);
+}
+
+static void adc_busy(uint8_t busy)
+{
+    uint32_t ctl0 = ADC->CTL0 & ~ADC14_CTL0_BUSY;
+
+    put32(&ADC->CTL0, ctl0 | (busy ? ADC14_CTL0_BUSY : 0));
+}
+
+static void adc_convert(void)
+{
+    static const uint16_t sample[8] = { 4, 8, 16, 32, 64, 96, 128, 192 };
+    static const uint8_t convert[4] = { 9, 11, 14, 16 };
+    uint32_t ctl0 = ADC->CTL0;
+    uint8_t sht = ((adc_index >= 8) && (adc_index < 24)) ? ((ctl0 >> 12) & 0xF) : ((ctl0 >> 8) & 0xF);
+
+    adc_done = adc_after(sample[sht & 7] +
+                         convert[(ADC->CTL1 & ADC14_CTL1_RES_MASK) >> ADC14_CTL1_RES_OFS]);
+    adc_busy(1);
+}
+
+static void adc_trigger(void)
+{
+    uint32_t ctl0 = ADC->CTL0;
+
+    if (!(ctl0 & ADC14_CTL0_ON) || !(ctl0 & ADC14_CTL0_ENC) || (adc_done != HOST_NEVER))
+        return;
+    if (!adc_sequence)
+        adc_index = (ADC->CTL1 & ADC14_CTL1_CSTARTADD_MASK) >> ADC14_CTL1_CSTARTADD_OFS;
+    adc_convert();
+}
+
+static void adc_run(void)
+{
+    uint32_t ctl0 = ADC->CTL0, mctl = ADC->MCTL[adc_index];
+    uint8_t conseq = (ctl0 & ADC14_CTL0_CONSEQ_MASK) >> ADC14_CTL0_CONSEQ_OFS;
+    uint8_t res = (ADC->CTL1 & ADC14_CTL1_RES_MASK) >> ADC14_CTL1_RES_OFS;
+    uint16_t value;
+    uint8_t last, again;
+
+    if (adc_done > now)
+        return;
+    adc_done = HOST_NEVER;
+    value = HOST_adc_input ? HOST_adc_input(mctl & ADC14_MCTLN_INCH_MASK) : 0x2000;
+    adc_busy(0);
+
+    put32(&ADC->MEM[adc_index], (value & 0x3FFF) >> (2 * (3 - res)));
+    put32((volatile uint32_t*)&ADC->IFGR0, ADC->IFGR0 | BIT(adc_index));
+    dma_trigger(7, 7);
+
+    last = (conseq & 1) ? ((mctl & ADC14_MCTLN_EOS) != 0) : 1;
+    if ((conseq & 1) && !last) {
+        adc_index = (adc_index + 1) & 31;
+        adc_sequence = 1;
+    } else {
+        adc_sequence = 0;
+        adc_index = (ADC->CTL1 & ADC14_CTL1_CSTARTADD_MASK) >> ADC14_CTL1_CSTARTADD_OFS;
+    }
+
+    // next conversion straight away: rest of a sequence or MSC repeats
+    again = (ctl0 & ADC14_CTL0_ENC) && (ctl0 & ADC14_CTL0_MSC) &&
+            (adc_sequence || ((conseq & 2) && !(ctl0 & ADC14_CTL0_SHS_MASK)));
+    if (!again && adc_sequence && !(ctl0 & ADC14_CTL0_SHS_MASK) && (ctl0 & ADC14_CTL0_MSC))
+        again = 1;
+    if (again)
+        adc_convert();
+}
+
+static void adc_write(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == offsetof(ADC14_Type, CTL0)) {
+        if (!(value & ADC14_CTL0_ON) || !(value & ADC14_CTL0_ENC)) {
+            if (!(value & ADC14_CTL0_ON)) {
+                adc_done = HOST_NEVER;
+                adc_busy(0);
+            }
+            adc_sequence = 0;
+        }
+        if ((value & ADC14_CTL0_SC) && (value & ADC14_CTL0_ENC) &&
+            !(value & ADC14_CTL0_SHS_MASK)) {
+            put32(&ADC->CTL0, ADC->CTL0 & ~ADC14_CTL0_SC);
+            adc_trigger();
+        }
+    }
+    else if (offset == offsetof(ADC14_Type, CLRIFGR0)) {
+        put32((volatile uint32_t*)&ADC->IFGR0, ADC->IFGR0 & ~value);
+        put32(&ADC->CLRIFGR0, 0);
+    }
+    else if (offset == offsetof(ADC14_Type, CLRIFGR1)) {
+        put32((volatile uint32_t*)&ADC->IFGR1, ADC->IFGR1 & ~value);
+        put32(&ADC->CLRIFGR1, 0);
+    }
+}
+
+/******************************************************************************
+* COMP_E                                                                      *
+******************************************************************************/
+
+static void comp_update(uint8_t n)
+{
+    uint16_t ctl1 = COMP(n)->CTL1, out_old = (ctl1 & COMP_E_CTL1_OUT) != 0;
+    uint16_t out = (ctl1 & COMP_E_CTL1_ON) ? (comp_raw[n] ^ ((ctl1 & COMP_E_CTL1_OUTPOL) != 0)) : 0;
+    uint16_t flags = 0;
+
+    if (out == out_old)
+        return;
+    put16(&COMP(n)->CTL1, out ? (ctl1 | COMP_E_CTL1_OUT) : (ctl1 & ~COMP_E_CTL1_OUT));
+
+    if (out != !!(ctl1 & COMP_E_CTL1_IES))
+        flags = COMP_E_INT_IFG;         // rising, or falling with IES
+    else
+        flags = COMP_E_INT_IIFG;
+    put16(&COMP(n)->INT, COMP(n)->INT | flags);
+
+    if (n == 1) {                       // C1.OUT is TA0 CCI3B
+        uint8_t before = ta_input_level(0, 3);
+
+        timer[0].input[3][1] = out;
+        ta_capture(0, 3, before, ta_input_level(0, 3));
+    }
+}
+
+static void comp_write(uint8_t n, uint16_t offset, uint32_t old, uint32_t value)
+{
+    if (offset == offsetof(COMP_E_Type, CTL1)) {
+        put16(&COMP(n)->CTL1, (value & ~COMP_E_CTL1_OUT) | (old & COMP_E_CTL1_OUT));
+        comp_update(n);
+    }
+}
+
+void HOST_comp_output(uint8_t n, uint8_t level)
+{
+    in_host++;
+    comp_raw[n] = level != 0;
+    comp_update(n);
+    in_host--;
+}
+
+/******************************************************************************
+* Register blocks the program writes                                          *
+******************************************************************************/
+
+enum { K_OTHER, K_UCA, K_UCB, K_CTRL };
+
+typedef struct {
+    uint8_t* mem;
+    uint8_t* shadow;
+    uint16_t size;
+    uint8_t width;
+    uint8_t unit;
+    uint8_t kind;
+    void (*write)(uint8_t unit, uint16_t offset, uint32_t old, uint32_t value);
+} Block;
+
+#define BLOCKS_MAX  32
+static Block blocks[BLOCKS_MAX];
+static uint8_t block_count;
+static Block* last_usci;
+static Block* last_ctrl;
+
+static void block_add(uint8_t* mem, uint16_t size, uint8_t width, uint8_t unit,
+                      uint8_t kind, void (*write)(uint8_t, uint16_t, uint32_t, uint32_t))
+{
+    Block* b = &blocks[block_count++];
+
+    b->mem = mem;
+    b->shadow = shadow_of(mem);
+    b->size = size;
+    b->width = width;
+    b->unit = unit;
+    b->kind = kind;
+    b->write = write;
+}
+
+static void block_diff(Block* b)
+{
+    uint32_t old, value;
+    uint16_t offset;
+
+    if (!memcmp(b->mem, b->shadow, b->size))
+        return;
+
+    for (offset = 0; offset < b->size; offset += b->width) {
+        old = value = 0;
+        memcpy(&old, b->shadow + offset, b->width);
+        memcpy(&value, b->mem + offset, b->width);
+        if (old == value)
+            continue;
+        memcpy(b->shadow + offset, &value, b->width);
+        b->write(b->unit, offset, old, value);
+    }
+}
+
+static Block* block_of(uintptr_t address)
+{
+    uint8_t index;
+
+    for (index = 0; index < block_count; index++)
+        if (address - (uintptr_t)blocks[index].mem < blocks[index].size)
+            return &blocks[index];
+    return 0;
+}
+
+// a DMA write of bytes at address: the register sees it even if the value
+// does not change, and a byte to a 16-bit register clears the upper byte
+// (reserved, reads 0 on TXBUF) so a 0xFF is not taken for TXBUF_EMPTY
+static void block_write_at(uintptr_t address, uint8_t bytes)
+{
+    Block* b = block_of(address);
+    uint32_t old = 0, value = 0;
+    uint16_t at, offset;
+
+    if (!b)
+        return;
+    at = address - (uintptr_t)b->mem;
+    offset = at & ~(b->width - 1);
+    if ((at == offset) && (bytes < b->width))
+        memset(b->mem + offset + bytes, 0, b->width - bytes);
+
+    memcpy(&old, b->shadow + offset, b->width);
+    memcpy(&value, b->mem + offset, b->width);
+    memcpy(b->shadow + offset, &value, b->width);
+    b->write(b->unit, offset, old, value);
+}
+
+/******************************************************************************
+* Reads and bit-band writes with side effects                                 *
+******************************************************************************/
+
+static uint8_t read_pending;
+static Block* read_block[2];
+
+unsigned HOST_read(uint8_t reg)
+{
+    Block* b = (reg == HOST_READ_RXBUF) ? last_usci : last_ctrl;
+
+    if (b) {
+        read_pending |= 1 << reg;
+        read_block[reg] = b;
+    }
+    return 0;
+}
+
+#define BITBAND_CELLS   16
+
+static struct {
+    const volatile void* reg;
+    uint32_t cell;
+    uint32_t initial;
+    uint8_t size;
+    uint8_t bit;
+} bitband[BITBAND_CELLS];
+static uint8_t bitband_count;
+
+static void apply_reads(void)
+{
+    uint8_t index;
+
+    if (read_pending & (1 << HOST_READ_RXBUF)) {
+        Block* b = read_block[HOST_READ_RXBUF];
+
+        if (b->kind == K_UCA)
+            uart_rx_read(b->unit);
+        else
+            ucb_rx_read(b->unit);
+    }
+    if ((read_pending & (1 << HOST_READ_CTRL)) && (read_block[HOST_READ_CTRL]->mem == (uint8_t*)STK))
+        put32(&STK->CTRL_[0], STK->CTRL_[0] & ~SysTick_CTRL_COUNTFLAG_Msk);
+    read_pending = 0;
+
+    // bit-band cells written by the program, a write of the bit only
+    for (index = 0; index < bitband_count; index++) {
+        uint32_t value = 0, bit = BIT(bitband[index].bit);
+
+        if (bitband[index].cell == bitband[index].initial)
+            continue;
+        memcpy(&value, (const void*)bitband[index].reg, bitband[index].size);
+        value = (bitband[index].cell & 1) ? (value | bit) : (value & ~bit);
+        memcpy((void*)bitband[index].reg, &value, bitband[index].size);
+    }
+    bitband_count = 0;
+}
+
+volatile uint32_t* HOST_bitband(const volatile void* reg, uint8_t size, uint8_t bit)
+{
+    uint32_t value = 0;
+    uint8_t index;
+
+    in_host++;
+    if (bitband_count == BITBAND_CELLS)
+        apply_reads();
+    index = bitband_count++;
+    memcpy(&value, (const void*)reg, size);
+    bitband[index].reg = reg;
+    bitband[index].size = size;
+    bitband[index].bit = bit;
+    bitband[index].initial = bitband[index].cell = (value >> bit) & 1;
+    in_host--;
+    return &bitband[index].cell;
+}
+
+/******************************************************************************
+* Time                                                                        *
+******************************************************************************/
+
+static void timed_run(void)
+{
+    uint8_t index;
+
+    for (index = 0; index < timed_count; ) {
+        if (timed[index].time > now) {
+            index++;
+            continue;
+        }
+        Timed t = timed[index];
+
+        timed[index] = timed[--timed_count];
+        t.fn(t.arg);
+        index = 0;                      // fn may have added more
+    }
+}
+
+void HOST_at(uint64_t time, void (*fn)(void* arg), void* arg)
+{
+    if (timed_count == TIMED_MAX)
+        host_stop("HOST_at: too many timed events");
+    timed[timed_count].time = (time < now) ? now : time;
+    timed[timed_count].fn = fn;
+    timed[timed_count].arg = arg;
+    timed_count++;
+}
+
+static uint64_t next_event(void)
+{
+    uint64_t next = HOST_NEVER, t;
+    uint8_t n;
+
+#define EARLIER(x)  do { t = (x); if (t < next) next = t; } while (0)
+    for (n = 0; n < timed_count; n++)
+        EARLIER(timed[n].time);
+    for (n = 0; n < 4; n++) {
+        EARLIER(ta_next(n));
+        EARLIER(uart_next(n));
+        EARLIER(ucb_next(n));
+    }
+    EARLIER(systick_next());
+    EARLIER(t32_next(0));
+    EARLIER(t32_next(1));
+    EARLIER(adc_done);
+    EARLIER(pcm_done);
+    EARLIER(hfxt_ready);
+    if (end_time)
+        EARLIER(end_time);
+#undef EARLIER
+    return next;
+}
+
+static void step_counters(uint64_t time)
+{
+    uint8_t n;
+
+    for (n = 0; n < 4; n++)
+        ta_step(n, time);
+    systick_step(time);
+    t32_step(0, time);
+    t32_step(1, time);
+}
+
+static void run_events(void)
+{
+    uint8_t n;
+
+    timed_run();
+    for (n = 0; n < 4; n++) {
+        uart_run(n);
+        if (ucb_i2c(n))
+            i2c_run(n);
+        else
+            spi_run(n);
+    }
+    adc_run();
+    if (pcm_done <= now) {
+        pcm_done = HOST_NEVER;
+        pcm_cpm = pcm_target;
+        put32(&PCMR->CTL0, (PCMR->CTL0 & ~PCM_CTL0_CPM_MASK) | ((uint32_t)pcm_cpm << PCM_CTL0_CPM_OFS));
+        put32(&PCMR->CTL1, PCMR->CTL1 & ~PCM_CTL1_PMR_BUSY);
+        check_limits();
+    }
+    if (hfxt_ready <= now) {
+        hfxt_ready = HOST_NEVER;
+        hfxt_running = 1;
+        cs_update();
+    }
+}
+
+// model up to time, with wake set it stops early once an interrupt would
+// run. Returns 1 if it stopped early.
+static uint8_t advance_to(uint64_t time, uint8_t wake)
+{
+    uint64_t next;
+
+    while (now < time) {
+        next = next_event();
+        if (next > time)
+            next = time;
+        if (next < now)
+            next = now;
+        now = next;                     // callbacks and triggers see the event time
+        adc_run();                      // a conversion ending on a trigger is done first
+        step_counters(next);
+        run_events();
+        dwt_update();
+        if (end_time && (now >= end_time)) {
+            ended = 1;
+            return 1;
+        }
+        if (wake && irq_ready())
+            return 1;
+    }
+    return 0;
+}
+
+static void account(uint64_t ps)
+{
+    if (isr_depth)
+        HOST_stats.isr += ps;
+    else
+        HOST_stats.busy += ps;
+}
+
+// CPU runs cycles MCLK cycles, stops early for an interrupt if wake is
+// set. Returns the cycles run.
+static uint64_t cpu_run(uint64_t cycles, uint8_t wake)
+{
+    Domain* m = &domain[D_MCLK];
+    uint64_t start = edges_at(m, now), begin = now, ran;
+
+    if (!cycles)
+        return 0;
+    if (!m->hz)
+        host_stop("CPU running with MCLK stopped");
+    advance_to(edge_time(m, start + cycles), wake);
+    ran = edges_at(m, now) - start;
+    if (ran > cycles)
+        ran = cycles;
+    cpu_cycles += ran;
+    account(now - begin);
+    dwt_update();
+    return ran;
+}
+
+/******************************************************************************
+* Interrupt entry                                                             *
+******************************************************************************/
+
+static void irq_take(int irqn)
+{
+    Vector* v = &vectors[irqn + 1];
+    uint8_t prio = irq_priority(irqn);
+
+    if (irqn < 0)
+        systick_pending = 0;
+    else {
+        put32(&NVICR->ISPR[irqn >> 5], NVICR->ISPR[irqn >> 5] & ~BIT(irqn & 31));
+        put32(&NVICR->IABR[irqn >> 5], NVICR->IABR[irqn >> 5] | BIT(irqn & 31));
+    }
+    active_prio[isr_depth++] = prio;
+    HOST_stats.interrupts++;
+    cpu_run(ENTRY_CYCLES, 0);
+
+    in_host--;
+    if (v->handler)
+        v->handler(v->ctx);
+    else if (v->isr)
+        v->isr();
+    else {
+        fprintf(stderr, "host: interrupt %d has no handler\n", irqn);
+        abort();
+    }
+    in_host++;
+    flush();                            // writes after its last access
+
+    cpu_run(EXIT_CYCLES, 0);
+    isr_depth--;
+    if (irqn >= 0)
+        put32(&NVICR->IABR[irqn >> 5], NVICR->IABR[irqn >> 5] & ~BIT(irqn & 31));
+}
+
+static void check_end(void);
+
+// run interrupts that are due, called with in_host counted
+static void dispatch(void)
+{
+    int irqn;
+
+    while (!primask && !ended) {
+        irqn = irq_best();
+        if ((irqn == NO_IRQ) || (irq_priority(irqn) >= exec_priority()))
+            break;
+        irq_take(irqn);
+    }
+}
+
+/******************************************************************************
+* Program side                                                                *
+******************************************************************************/
+
+// registers the program changed since the model last ran
+static void flush(void)
+{
+    uint8_t index;
+
+    apply_reads();
+    for (index = 0; index < block_count; index++)
+        block_diff(&blocks[index]);
+}
+
+static void sync(uint32_t cycles)
+{
+    in_host++;
+    hooks++;
+    flush();
+    cpu_run(cycles, 0);
+    dispatch();
+    in_host--;
+    check_end();
+}
+
+void* HOST_io(uintptr_t base)
+{
+    Block* b = block_of(base);
+
+    if (b && ((b->kind == K_UCA) || (b->kind == K_UCB)))
+        last_usci = b;
+    if (b && (b->kind == K_CTRL))
+        last_ctrl = b;
+    sync(HOST_ACCESS_CYCLES);
+    return (void*)base;
+}
+
+void __enable_irq(void)
+{
+    primask = 0;
+    sync(1);
+}
+
+void __disable_irq(void)
+{
+    sync(1);
+    primask = 1;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return primask;
+}
+
+void __set_PRIMASK(uint32_t value)
+{
+    if (value)
+        __disable_irq();
+    else
+        __enable_irq();
+}
+
+void __delay_cycles(uint32_t cycles)
+{
+    uint64_t left = cycles;
+
+    sync(0);
+    in_host++;
+    while (left && !ended) {
+        left -= cpu_run(left, 1);
+        dispatch();                     // ISR time is not part of the delay
+    }
+    in_host--;
+    check_end();
+}
+
+void HOST_sleep(void)
+{
+    uint64_t start, limit;
+
+    sync(1);
+    in_host++;
+    deep_sleep = (SCBR->SCR & SCB_SCR_SLEEPDEEP_Msk) != 0;
+    if (deep_sleep)
+        cs_update();                    // LPM3, only ACLK runs
+
+    start = now;
+    limit = now + 3600 * HOST_PS;
+    while (!ended && !irq_ready()) {
+        if (next_event() == HOST_NEVER)
+            host_stop("sleep with nothing left to wake the CPU");
+        if (!end_time && (now > limit))
+            host_stop("asleep for an hour with no interrupt");
+        advance_to(HOST_NEVER, 1);
+    }
+    HOST_stats.sleep += now - start;
+
+    if (deep_sleep) {
+        deep_sleep = 0;
+        cs_update();
+    }
+    cpu_run(1, 0);
+    dispatch();
+    in_host--;
+    check_end();
+}
+
+void HOST_run(uint64_t time)
+{
+    uint64_t target = now + time, start;
+
+    sync(0);
+    in_host++;
+    while ((now < target) && !ended) {
+        start = now;
+        advance_to(target, 1);
+        HOST_stats.sleep += now - start;
+        dispatch();
+    }
+    in_host--;
+    check_end();
+}
+
+uint64_t HOST_time(void)
+{
+    return now;
+}
+
+uint64_t HOST_cycles(void)
+{
+    return cpu_cycles;
+}
+
+uint32_t HOST_mclk(void)
+{
+    return (uint32_t)domain[D_MCLK].hz;
+}
+
+uint32_t HOST_smclk(void)
+{
+    return (uint32_t)domain[D_SMCLK].hz;
+}
+
+uint32_t HOST_aclk(void)
+{
+    return (uint32_t)domain[D_ACLK].hz;
+}
+
+void HOST_register(IRQn_Type irqn, void (*handler)(void* ctx), void* ctx)
+{
+    vectors[irqn + 1].handler = handler;
+    vectors[irqn + 1].ctx = ctx;
+}
+
+void HOST_vector(IRQn_Type irqn, void (*isr)(void))
+{
+    vectors[irqn + 1].handler = 0;
+    vectors[irqn + 1].isr = isr;
+}
+
+void HOST_pin(uint8_t port, uint8_t pin, int8_t level)
+{
+    in_host++;
+    if (level < 0)
+        port_drive[port] &= ~BIT(pin);
+    else {
+        port_drive[port] |= BIT(pin);
+        port_ext[port] = level ? (port_ext[port] | BIT(pin)) : (port_ext[port] & ~BIT(pin));
+    }
+    pin_update(port);
+    in_host--;
+}
+
+void HOST_timer_input(uint8_t n, uint8_t ccr, uint8_t input, uint8_t level)
+{
+    uint8_t before;
+
+    in_host++;
+    before = ta_input_level(n, ccr);
+    timer[n].input[ccr][input] = level != 0;
+    ta_capture(n, ccr, before, ta_input_level(n, ccr));
+    in_host--;
+}
+
+void HOST_timer_clock(uint8_t n, uint32_t edges)
+{
+    in_host++;
+    if (!ta_domain(n) && ta_period(n))
+        ta_edges(n, edges);
+    in_host--;
+}
+
+/******************************************************************************
+* Ending a run                                                                *
+******************************************************************************/
+
+static void check_end(void)
+{
+    if (!ended || in_host || !exit_armed)
+        return;
+    exit_armed = 0;
+    isr_depth = 0;
+    primask = 0;
+    siglongjmp(HOST_exit, 1);
+}
+
+static void host_stop(const char* why)
+{
+    fprintf(stderr, "host: %s at %.6f s\n", why, (double)now / HOST_PS);
+    if (exit_armed) {
+        exit_armed = 0;
+        in_host = 0;
+        isr_depth = 0;
+        siglongjmp(HOST_exit, 2);
+    }
+    exit(1);
+}
+
+void HOST_end(uint64_t time)
+{
+    end_time = time;
+    ended = 0;
+    exit_armed = 1;
+}
+
+// timer signal: a program spinning on RAM with no register access has not
+// called into the model since the last tick, run it to the next interrupt
+static void watchdog_tick(int signal)
+{
+    static uint32_t last_hooks;
+    uint64_t start, begin = now;
+
+    (void)signal;
+    if (in_host || (hooks != last_hooks)) {
+        last_hooks = hooks;
+        return;
+    }
+
+    in_host++;
+    flush();
+    start = edges_at(&domain[D_MCLK], now);
+    if (next_event() == HOST_NEVER)
+        host_stop("program spinning with nothing left to happen");
+    advance_to(HOST_NEVER, 1);
+    cpu_cycles += edges_at(&domain[D_MCLK], now) - start;
+    account(now - begin);
+    dispatch();
+    in_host--;
+    last_hooks = ++hooks;
+    check_end();
+}
+
+void HOST_watchdog(uint8_t enable)
+{
+    struct itimerval tick = { { 0, 500 }, { 0, 500 } };
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = enable ? watchdog_tick : SIG_IGN;
+    sigaction(SIGALRM, &action, 0);
+    if (!enable)
+        memset(&tick, 0, sizeof(tick));
+    setitimer(ITIMER_REAL, &tick, 0);
+}
+
+/******************************************************************************
+* Handlers of the program, found at link time                                 *
+******************************************************************************/
+
+#define WEAK(name)  extern void name(void) __attribute__((weak));
+WEAK(SysTick_Handler)
+WEAK(PSS_IRQHandler)    WEAK(CS_IRQHandler)     WEAK(PCM_IRQHandler)
+WEAK(WDT_A_IRQHandler)  WEAK(FPU_IRQHandler)    WEAK(FLCTL_IRQHandler)
+WEAK(COMP_E0_IRQHandler) WEAK(COMP_E1_IRQHandler)
+WEAK(TA0_0_IRQHandler)  WEAK(TA0_N_IRQHandler)  WEAK(TA1_0_IRQHandler)
+WEAK(TA1_N_IRQHandler)  WEAK(TA2_0_IRQHandler)  WEAK(TA2_N_IRQHandler)
+WEAK(TA3_0_IRQHandler)  WEAK(TA3_N_IRQHandler)
+WEAK(EUSCIA0_IRQHandler) WEAK(EUSCIA1_IRQHandler) WEAK(EUSCIA2_IRQHandler)
+WEAK(EUSCIA3_IRQHandler) WEAK(EUSCIB0_IRQHandler) WEAK(EUSCIB1_IRQHandler)
+WEAK(EUSCIB2_IRQHandler) WEAK(EUSCIB3_IRQHandler)
+WEAK(ADC14_IRQHandler)  WEAK(T32_INT1_IRQHandler) WEAK(T32_INT2_IRQHandler)
+WEAK(T32_INTC_IRQHandler) WEAK(AES256_IRQHandler) WEAK(RTC_C_IRQHandler)
+WEAK(DMA_ERR_IRQHandler) WEAK(DMA_INT3_IRQHandler) WEAK(DMA_INT2_IRQHandler)
+WEAK(DMA_INT1_IRQHandler) WEAK(DMA_INT0_IRQHandler)
+WEAK(PORT1_IRQHandler)  WEAK(PORT2_IRQHandler)  WEAK(PORT3_IRQHandler)
+WEAK(PORT4_IRQHandler)  WEAK(PORT5_IRQHandler)  WEAK(PORT6_IRQHandler)
+#undef WEAK
+
+static void (*const handlers[])(void) = {
+    SysTick_Handler,
+    PSS_IRQHandler, CS_IRQHandler, PCM_IRQHandler, WDT_A_IRQHandler,
+    FPU_IRQHandler, FLCTL_IRQHandler, COMP_E0_IRQHandler, COMP_E1_IRQHandler,
+    TA0_0_IRQHandler, TA0_N_IRQHandler, TA1_0_IRQHandler, TA1_N_IRQHandler,
+    TA2_0_IRQHandler, TA2_N_IRQHandler, TA3_0_IRQHandler, TA3_N_IRQHandler,
+    EUSCIA0_IRQHandler, EUSCIA1_IRQHandler, EUSCIA2_IRQHandler, EUSCIA3_IRQHandler,
+    EUSCIB0_IRQHandler, EUSCIB1_IRQHandler, EUSCIB2_IRQHandler, EUSCIB3_IRQHandler,
+    ADC14_IRQHandler, T32_INT1_IRQHandler, T32_INT2_IRQHandler, T32_INTC_IRQHandler,
+    AES256_IRQHandler, RTC_C_IRQHandler, DMA_ERR_IRQHandler, DMA_INT3_IRQHandler,
+    DMA_INT2_IRQHandler, DMA_INT1_IRQHandler, DMA_INT0_IRQHandler,
+    PORT1_IRQHandler, PORT2_IRQHandler, PORT3_IRQHandler, PORT4_IRQHandler,
+    PORT5_IRQHandler, PORT6_IRQHandler
+};
+
+/******************************************************************************
+* Reset                                                                       *
+******************************************************************************/
+
+__attribute__((constructor))
+static void host_reset(void)
+{
+    uint8_t n;
+
+    for (n = 0; n < sizeof(handlers) / sizeof(handlers[0]); n++)
+        vectors[n].isr = handlers[n];
+
+    for (n = 0; n < 4; n++) {
+        block_add((uint8_t*)TA(n), sizeof(Timer_A_Type), 2, n, K_OTHER, ta_write);
+        block_add((uint8_t*)UCA(n), sizeof(EUSCI_A_Type), 2, n, K_UCA, uca_write);
+        block_add((uint8_t*)UCB(n), sizeof(EUSCI_B_Type), 2, n, K_UCB, ucb_write);
+    }
+    block_add((uint8_t*)COMP(0), sizeof(COMP_E_Type), 2, 0, K_OTHER, comp_write);
+    block_add((uint8_t*)COMP(1), sizeof(COMP_E_Type), 2, 1, K_OTHER, comp_write);
+    block_add(DIO, 0x140, 1, 0, K_OTHER, dio_write);
+    block_add((uint8_t*)T32(0), 0x40, 4, 0, K_OTHER, t32_write);
+    block_add((uint8_t*)DMACH, sizeof(DMA_Channel_Type), 4, 0, K_OTHER, dmach_write);
+    block_add((uint8_t*)DMACTL, sizeof(DMA_Control_Type), 4, 0, K_OTHER, dmactl_write);
+    block_add((uint8_t*)PCMR, sizeof(PCM_Type), 4, 0, K_OTHER, pcm_write);
+    block_add((uint8_t*)CSR, sizeof(CS_Type), 4, 0, K_OTHER, cs_write);
+    block_add((uint8_t*)FLCTLR, sizeof(FLCTL_Type), 4, 0, K_OTHER, flctl_write);
+    block_add((uint8_t*)ADC, sizeof(ADC14_Type), 4, 0, K_OTHER, adc_write);
+    block_add((uint8_t*)STK, sizeof(SysTick_Type), 4, 0, K_CTRL, systick_write);
+    block_add((uint8_t*)NVICR, 0x220, 4, 0, K_OTHER, nvic_write);
+    block_add((uint8_t*)&NVICR->STIR, 4, 4, 0, K_OTHER, stir_write);
+    block_add((uint8_t*)SCBR, 8, 4, 0, K_OTHER, scb_write);     // CPUID, ICSR
+    block_add(HOST_dwt, 8, 4, 0, K_CTRL, dwt_write);
+
+    // reset values that are not 0
+    for (n = 0; n < 4; n++) {
+        uart_reset(n);
+        put16(&UCA(n)->CTLW0, EUSCI_A_CTLW0_SWRST);
+        ucb_reset(n);
+        put16(&UCB(n)->CTLW0, EUSCI_B_CTLW0_SWRST | EUSCI_B_CTLW0_SSEL__UCLKI);
+        usci[n].ste = 0;
+    }
+    put32(&T32(0)->INTCLR, T32_INTCLR_IDLE);
+    put32(&T32(1)->INTCLR, T32_INTCLR_IDLE);
+    put32((volatile uint32_t*)&T32(0)->VALUE, 0xFFFFFFFF);
+    put32((volatile uint32_t*)&T32(1)->VALUE, 0xFFFFFFFF);
+    put32(&T32(0)->CONTROL, TIMER32_CONTROL_IE);
+    put32(&T32(1)->CONTROL, TIMER32_CONTROL_IE);
+    put32((volatile uint32_t*)&DMACH->DEVICE_CFG, DMA_CHANNELS);
+    put32((volatile uint32_t*)&DMACTL->STAT, (DMA_CHANNELS - 1) << 16);
+
+    put32(&CSR->KEY, 0xA596);
+    put32(&CSR->CTL0, CS_CTL0_DCORSEL_1);
+    put32(&CSR->CTL1, CS_CTL1_SELM__DCOCLK | CS_CTL1_SELS__DCOCLK);
+    put32(&CSR->CTL2, 0x00010003);
+    put32(&CSR->CLKEN, 0x0000000F);
+    put32((volatile uint32_t*)&CSR->STAT, 0x1FFF0003);
+    put32((volatile uint32_t*)&CSR->IFG, CS_IFG_LFXTIFG | CS_IFG_HFXTIFG);
+    put32(&FLCTLR->BANK0_RDCTL, FLCTL_BANK0_RDCTL_BUFI | FLCTL_BANK0_RDCTL_BUFD);
+    put32(&FLCTLR->BANK1_RDCTL, FLCTL_BANK1_RDCTL_BUFI | FLCTL_BANK1_RDCTL_BUFD);
+    put32(&PCMR->CTL0, 0);
+
+    put32((volatile uint32_t*)&SCBR->CPUID, 0x410FC241);
+    put32((volatile uint32_t*)&STK->CALIB, 0);
+
+    memcpy(periph_shadow, HOST_periph, sizeof(HOST_periph));
+    memcpy(scs_shadow, HOST_scs, sizeof(HOST_scs));
+    memcpy(dwt_shadow, HOST_dwt, sizeof(HOST_dwt));
+
+    cs_update();
+    adc_done = HOST_NEVER;
+}
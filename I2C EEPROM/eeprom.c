@@ -0,0 +1,428 @@
+// 24LC256 EEPROM driver with page writes, sequential reads and ACK polling
+
+#include "msp.h"
+#include "eeprom.h"
+
+#define POLL_TRIES  1000    // ACK poll attempts, ~25 us each at 400 kHz
+#define WAIT_US     4500    // async: page stop to first ACK poll, most of tWC
+#define RETRY_US    50      // async: ACK poll period after the first
+
+// async write states
+#define ASYNC_IDLE       0
+#define ASYNC_ADDR_HI    1  // send high byte of memory address
+#define ASYNC_ADDR_LO    2  // send low byte of memory address
+#define ASYNC_DATA       3  // send page data
+#define ASYNC_STOP       4  // waiting for stop after the page
+#define ASYNC_WAIT       5  // bus idle until the next TIMER32_2 tick
+#define ASYNC_POLL       6  // ACK poll start sent
+#define ASYNC_POLL_STOP  7  // waiting for stop after ACK poll
+#define ASYNC_ERROR      8  // waiting for stop after a NACK
+
+static volatile uint8_t async_state = ASYNC_IDLE;
+static volatile uint8_t async_status;
+static volatile uint8_t async_nack;
+static uint16_t async_address;
+static const uint8_t* async_data;
+static uint16_t async_length;       // bytes left including this page
+static uint8_t async_page_left;     // bytes left in this page
+static uint16_t async_tries;
+static EEPROM_callback async_done;
+
+// Number of bytes from MemAddress to the end of its page, at most length
+static uint16_t page_bytes(uint16_t MemAddress, uint16_t length)
+{
+    uint16_t space = EEPROM_PAGE_SIZE - (MemAddress % EEPROM_PAGE_SIZE);
+
+    return (length < space) ? length : space;
+}
+
+// Function to wait for TXBUF to be empty. Returns EEPROM_NACK and sends a
+// stop condition if the EEPROM does not acknowledge.
+static uint8_t wait_tx(void)
+{
+    while(!(EUSCI_B0->IFG & EUSCI_B_IFG_TXIFG0)) {
+        if (EUSCI_B0->IFG & EUSCI_B_IFG_NACKIFG) {
+            EUSCI_B0->IFG &= ~EUSCI_B_IFG_NACKIFG;
+            EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;    // I2C stop condition
+            while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTP);
+            return EEPROM_NACK;
+        }
+    }
+    return EEPROM_OK;
+}
+
+/*
+/  Initialize I2C bus for communicating with EEPROM.
+*/
+void EEPROM_init(uint8_t DeviceAddress)
+{
+  // Configure USCI_B0 for I2C mode
+  EUSCI_B0->CTLW0 |= EUSCI_A_CTLW0_SWRST;   // Software reset enabled
+  EUSCI_B0->CTLW0 = EUSCI_A_CTLW0_SWRST |   // Remain eUSCI in reset mode
+          EUSCI_B_CTLW0_MODE_3 |            // I2C mode
+          EUSCI_B_CTLW0_MST |               // Main (master) mode
+          EUSCI_B_CTLW0_SYNC |              // Sync mode
+          EUSCI_B_CTLW0_SSEL__SMCLK;        // SMCLK
+
+  EUSCI_B0->BRW = 7;                        // 3 MHz / 8 = 400 kHz (375)
+  EUSCI_B0->I2CSA = DeviceAddress;          // Subsystem address
+
+  P1->SEL0 |= BIT6 | BIT7;                  // Set I2C pins of eUSCI_B0
+
+  EUSCI_B0->CTLW0 &= ~EUSCI_A_CTLW0_SWRST;  // Release eUSCI from reset
+
+  NVIC->ISER[0] = (1 << ((EUSCIB0_IRQn) & 31)) |  // used by async writes
+                  (1 << ((T32_INT2_IRQn) & 31));
+}
+
+/*
+/  Function that waits for the EEPROM write cycle to finish by ACK polling.
+/  The EEPROM does not acknowledge its address until the write is done.
+/
+/  Procedure (repeated until ACK) :
+/      start
+/      transmit address+W (control+0)     -> ACK / NACK (from EEPROM)
+/      stop
+*/
+uint8_t EEPROM_wait_ready(void)
+{
+  uint16_t tries;
+  uint8_t nack;
+
+  for (tries = 0; tries < POLL_TRIES; tries++)
+  {
+    EUSCI_B0->IFG &= ~(EUSCI_B_IFG_NACKIFG | EUSCI_B_IFG_TXIFG0);
+
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TR;          // Set transmit mode (write)
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTT;       // I2C start condition
+
+    while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTT);    // wait for address
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;           // I2C stop condition
+    while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTP);
+
+    nack = EUSCI_B0->IFG & EUSCI_B_IFG_NACKIFG;
+    EUSCI_B0->IFG &= ~EUSCI_B_IFG_NACKIFG;
+
+    if (!nack)
+      return EEPROM_OK;                       // write cycle is finished
+  }
+
+  return EEPROM_TIMEOUT;
+}
+
+/*
+/  Function that writes length bytes to the EEPROM starting at MemAddress.
+/  The data is split at the 64 byte page boundaries so the EEPROM address
+/  counter does not wrap around inside a page.
+/
+/  Procedure for each page :
+/      start
+/      transmit address+W (control+0)     -> ACK (from EEPROM)
+/      transmit data      (high address)  -> ACK (from EEPROM)
+/      transmit data      (low address)   -> ACK (from EEPROM)
+/      transmit data      (data) x 1-64   -> ACK (from EEPROM)
+/      stop
+/      ACK poll until the write cycle is done
+*/
+uint8_t EEPROM_write(uint16_t MemAddress, const uint8_t* data, uint16_t length)
+{
+  uint16_t count;
+  uint8_t status;
+
+  if (async_state != ASYNC_IDLE)
+    return EEPROM_BUSY;
+
+  while (length)
+  {
+    count = page_bytes(MemAddress, length);
+
+    // verify the TXBUF is cleared
+    EUSCI_B0->IFG &= ~(EUSCI_B_IFG_TXIFG0 | EUSCI_B_IFG_NACKIFG);
+
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TR;          // Set transmit mode (write)
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTT;       // I2C start condition
+
+    // TXIFG should be set when START is sent
+    if ((status = wait_tx()) != EEPROM_OK) return status;
+    EUSCI_B0->TXBUF = MemAddress >> 8;      // Send the high byte of the memory address
+
+    if ((status = wait_tx()) != EEPROM_OK) return status;
+    EUSCI_B0->TXBUF = MemAddress & 0xFF;    // Send the low byte of the memory address
+
+    MemAddress += count;
+    length -= count;
+
+    while (count--)
+    {
+      if ((status = wait_tx()) != EEPROM_OK) return status;
+      EUSCI_B0->TXBUF = *data++;            // Send the data byte to store in EEPROM
+    }
+
+    if ((status = wait_tx()) != EEPROM_OK) return status;   // last byte started
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;     // I2C stop condition
+    while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTP);
+
+    if ((status = EEPROM_wait_ready()) != EEPROM_OK) return status;
+  }
+
+  return EEPROM_OK;
+}
+
+// Function to end a read the EEPROM did not acknowledge with a stop condition
+static uint8_t read_nack(void)
+{
+  EUSCI_B0->IFG &= ~EUSCI_B_IFG_NACKIFG;
+  EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;       // I2C stop condition
+  while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTP);
+  return EEPROM_NACK;
+}
+
+/*
+/  Function that reads length bytes from the EEPROM starting at MemAddress.
+/  The EEPROM increments its address after each byte, so the whole block is
+/  read in one transaction.
+/
+/  Procedure :
+/      start
+/      transmit address+W (control+0)    -> ACK (from EEPROM)
+/      transmit data      (high address) -> ACK (from EEPROM)
+/      transmit data      (low address)  -> ACK (from EEPROM)
+/      start
+/      transmit address+R (control+1)    -> ACK (from EEPROM)
+/      receive data       (data) x length -> ACK (from MSP432), NACK on last
+/      stop
+*/
+uint8_t EEPROM_read(uint16_t MemAddress, uint8_t* data, uint16_t length)
+{
+  uint16_t index;
+  uint8_t status;
+
+  if (async_state != ASYNC_IDLE)
+    return EEPROM_BUSY;
+  if (length == 0)
+    return EEPROM_OK;
+
+  // verify the TXBUF is cleared (necessary after initial transmission)
+  EUSCI_B0->IFG &= ~(EUSCI_B_IFG_TXIFG0 | EUSCI_B_IFG_NACKIFG);
+
+  EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TR;          // Set transmit mode (write)
+  EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTT;       // I2C start condition
+
+  if ((status = wait_tx()) != EEPROM_OK) return status;
+  EUSCI_B0->TXBUF = MemAddress >> 8;        // Send the high byte of the memory address
+
+  if ((status = wait_tx()) != EEPROM_OK) return status;
+  EUSCI_B0->TXBUF = MemAddress & 0xFF;      // Send the low byte of the memory address
+
+  if ((status = wait_tx()) != EEPROM_OK) return status;  // low address started
+  EUSCI_B0->CTLW0 &= ~EUSCI_B_CTLW0_TR;    // Set receive mode (read)
+  EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTT;  // I2C start condition (restart)
+
+  // Wait for start to be transmitted, an EEPROM still in a write cycle
+  // does not acknowledge the read address
+  while ((EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTT))
+    if (EUSCI_B0->IFG & EUSCI_B_IFG_NACKIFG)
+      return read_nack();
+
+  for (index = 0; index < length; index++)
+  {
+    // set stop before the last byte is received so it is NACKed
+    if (index == length - 1)
+      EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;
+
+    while(!(EUSCI_B0->IFG & EUSCI_B_IFG_RXIFG0)) // wait for the RXBUF to receive a byte
+      if (EUSCI_B0->IFG & EUSCI_B_IFG_NACKIFG)
+        return read_nack();
+    data[index] = EUSCI_B0->RXBUF;    // Read byte from the buffer
+  }
+
+  while (EUSCI_B0->CTLW0 & EUSCI_B_CTLW0_TXSTP);
+
+  return EEPROM_OK;
+}
+
+// Function to start the next page of an async write
+static void async_start_page(void)
+{
+  async_page_left = page_bytes(async_address, async_length);
+  async_state = ASYNC_ADDR_HI;
+
+  EUSCI_B0->IFG &= ~(EUSCI_B_IFG_TXIFG0 | EUSCI_B_IFG_NACKIFG | EUSCI_B_IFG_STPIFG);
+  EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TR | EUSCI_B_CTLW0_TXSTT;
+}
+
+// MCLK cycles in us, TIMER32_2 counts MCLK
+static uint32_t mclk_cycles(uint32_t us)
+{
+  return ((uint64_t)SystemCoreClock * us) / 1000000;
+}
+
+// Function to leave the bus idle after a page. TIMER32_2 runs periodic, its
+// first tick after most of the write cycle and the next ones RETRY_US
+// apart. T32_INT2_IRQHandler sends an ACK poll on each tick the bus is idle.
+static void async_wait(void)
+{
+  async_state = ASYNC_WAIT;
+
+  TIMER32_2->CONTROL = TIMER32_CONTROL_IE |       // interrupt at 0
+                       TIMER32_CONTROL_SIZE |     // 32-bit, before LOAD
+                       TIMER32_CONTROL_MODE;      // periodic
+  TIMER32_2->LOAD = mclk_cycles(WAIT_US);         // first period
+  TIMER32_2->BGLOAD = mclk_cycles(RETRY_US);      // reloads after it
+  TIMER32_2->CONTROL |= TIMER32_CONTROL_ENABLE;   // start
+}
+
+// Function to end an async write and report the result
+static void async_finish(uint8_t status)
+{
+  EUSCI_B0->IE &= ~(EUSCI_B_IE_TXIE0 | EUSCI_B_IE_NACKIE | EUSCI_B_IE_STPIE);
+  TIMER32_2->CONTROL = 0;
+  async_state = ASYNC_IDLE;
+
+  if (async_done)
+    async_done(status);
+}
+
+/*
+/  Function that starts writing length bytes to the EEPROM from the eUSCI_B0
+/  interrupt. Returns EEPROM_BUSY if a write is already running, otherwise
+/  returns immediately and done is called from the ISR with the result. The
+/  data must not change until done is called.
+/
+/  After each page the bus is left idle for most of the write cycle, then
+/  ACK polls are spaced by TIMER32_2, so the CPU only runs a few interrupts
+/  per page.
+*/
+uint8_t EEPROM_write_async(uint16_t MemAddress, const uint8_t* data,
+                           uint16_t length, EEPROM_callback done)
+{
+  if (async_state != ASYNC_IDLE)
+    return EEPROM_BUSY;
+
+  async_address = MemAddress;
+  async_data = data;
+  async_length = length;
+  async_done = done;
+
+  if (length == 0) {
+    if (done)
+      done(EEPROM_OK);
+    return EEPROM_OK;
+  }
+
+  async_start_page();
+  EUSCI_B0->IE |= EUSCI_B_IE_TXIE0 | EUSCI_B_IE_NACKIE | EUSCI_B_IE_STPIE;
+
+  return EEPROM_OK;
+}
+
+// Returns 1 while an async write is running
+uint8_t EEPROM_busy(void)
+{
+  return async_state != ASYNC_IDLE;
+}
+
+// eUSCI_B0 ISR runs the async page write and ACK polling
+void EUSCIB0_IRQHandler(void)
+{
+  if (EUSCI_B0->IFG & EUSCI_B_IFG_NACKIFG)
+  {
+    EUSCI_B0->IFG &= ~EUSCI_B_IFG_NACKIFG;
+
+    if ((async_state == ASYNC_POLL) || (async_state == ASYNC_POLL_STOP)) {
+      async_nack = 1;                           // still busy writing
+      async_state = ASYNC_POLL_STOP;
+    }
+    else {
+      async_status = EEPROM_NACK;               // page write failed
+      async_state = ASYNC_ERROR;
+    }
+    EUSCI_B0->IFG &= ~EUSCI_B_IFG_TXIFG0;
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;
+  }
+
+  if (EUSCI_B0->IFG & EUSCI_B_IFG_STPIFG)
+  {
+    EUSCI_B0->IFG &= ~EUSCI_B_IFG_STPIFG;
+
+    switch (async_state) {
+      case ASYNC_STOP:                          // page sent, wait out the write cycle
+        async_tries = 0;
+        async_wait();
+        break;
+
+      case ASYNC_POLL_STOP:
+        if (async_nack) {                       // not ready, poll again
+          if (++async_tries >= POLL_TRIES) {
+            async_finish(EEPROM_TIMEOUT);
+            break;
+          }
+          async_state = ASYNC_WAIT;             // poll again at the next tick
+        }
+        else if (async_length) {                // ready for the next page
+          TIMER32_2->CONTROL = 0;
+          async_start_page();
+        }
+        else {
+          async_finish(EEPROM_OK);
+        }
+        break;
+
+      case ASYNC_ERROR:
+        async_finish(async_status);
+        break;
+    }
+  }
+
+  if (EUSCI_B0->IFG & EUSCI_B_IFG_TXIFG0)
+  {
+    switch (async_state) {
+      case ASYNC_ADDR_HI:
+        EUSCI_B0->TXBUF = async_address >> 8;
+        async_state = ASYNC_ADDR_LO;
+        break;
+
+      case ASYNC_ADDR_LO:
+        EUSCI_B0->TXBUF = async_address & 0xFF;
+        async_address += async_page_left;
+        async_length -= async_page_left;
+        async_state = ASYNC_DATA;
+        break;
+
+      case ASYNC_DATA:
+        if (async_page_left) {
+          EUSCI_B0->TXBUF = *async_data++;
+          async_page_left--;
+        }
+        else {                                  // last byte started
+          EUSCI_B0->IFG &= ~EUSCI_B_IFG_TXIFG0;
+          EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;
+          async_state = ASYNC_STOP;
+        }
+        break;
+
+      case ASYNC_POLL:                          // address sent, stop after it
+        EUSCI_B0->IFG &= ~EUSCI_B_IFG_TXIFG0;
+        EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TXSTP;
+        async_state = ASYNC_POLL_STOP;
+        break;
+
+      default:                                  // no data to send
+        EUSCI_B0->IFG &= ~EUSCI_B_IFG_TXIFG0;
+        break;
+    }
+  }
+}
+
+// TIMER32_2 ISR sends an ACK poll if the last one has finished
+void T32_INT2_IRQHandler(void)
+{
+  TIMER32_2->INTCLR = 0;
+
+  if (async_state == ASYNC_WAIT) {
+    async_nack = 0;
+    async_state = ASYNC_POLL;
+    EUSCI_B0->IFG &= ~(EUSCI_B_IFG_TXIFG0 | EUSCI_B_IFG_NACKIFG | EUSCI_B_IFG_STPIFG);
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_TR | EUSCI_B_CTLW0_TXSTT;
+  }
+}
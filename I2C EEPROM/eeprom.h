@@ -0,0 +1,46 @@
+/*
+ * eeprom.h
+ *
+ *  Driver for a Microchip 24LC256 EEPROM on eUSCI_B0 (P1.6 SDA / P1.7 SCL)
+ *
+ *  Writes are split into 64 byte page writes and reads are sequential, so
+ *  the 2 address bytes are only sent once per page / read. After each page
+ *  the EEPROM is ACK polled until the internal write cycle is finished
+ *  instead of waiting a fixed 5 ms.
+ *
+ *  EEPROM_write_async() does the same page writes from the eUSCI_B0
+ *  interrupt so the CPU is free while the bus is busy. After each page it
+ *  leaves the bus idle for most of the write cycle and then ACK polls on
+ *  the ticks of TIMER32_2, so eeprom.c owns TIMER32_2 and
+ *  T32_INT2_IRQHandler.
+ *
+ *  The bus belongs to the async write until done is called, EEPROM_write()
+ *  and EEPROM_read() return EEPROM_BUSY in the meantime. An EEPROM that
+ *  does not acknowledge its address, also the read address after the
+ *  repeated start, gives EEPROM_NACK.
+ */
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include <stdint.h>
+
+#define EEPROM_PAGE_SIZE  64
+#define EEPROM_SIZE       32768     // 256 kbit
+
+#define EEPROM_OK         0
+#define EEPROM_NACK       1         // EEPROM did not acknowledge
+#define EEPROM_TIMEOUT    2         // write cycle did not finish
+#define EEPROM_BUSY       3         // async write running
+
+typedef void (*EEPROM_callback)(uint8_t status);
+
+void EEPROM_init(uint8_t DeviceAddress);
+uint8_t EEPROM_write(uint16_t MemAddress, const uint8_t* data, uint16_t length);
+uint8_t EEPROM_read(uint16_t MemAddress, uint8_t* data, uint16_t length);
+uint8_t EEPROM_wait_ready(void);
+uint8_t EEPROM_write_async(uint16_t MemAddress, const uint8_t* data,
+                           uint16_t length, EEPROM_callback done);
+uint8_t EEPROM_busy(void);
+
+#endif /* EEPROM_H_ */
@@ -0,0 +1,255 @@
+// PC test of eeprom.c against a model of the 24LC256 on the I2C model in
+// Host/
+//
+//     gcc -O2 -I. -I../Host eeprom_host.c eeprom.c ../BSP/system_msp432p401r.c
+//         ../Host/msp_host.c -lm -o eeprom
+//
+// The model is the part as the datasheet has it: 2 address bytes, a 64
+// byte page latch whose address wraps inside the page, the page written
+// at the stop in a 5 ms write cycle and no ACK of its address until the
+// cycle is done, sequential reads over the whole array. EEPROM_write and
+// EEPROM_write_async of a block that starts inside a page must read back
+// with no page wrap, one write cycle per page and the ACK polling must
+// stop within one poll of the cycle ending. The async write waits out
+// most of each write cycle on a timer, so its CPU time must stay under
+// CPU_LIMIT, and blocking calls while it runs must give EEPROM_BUSY. Also
+// checks that a missing EEPROM and a NACK of the read address after the
+// repeated start give EEPROM_NACK and leave the bus usable.
+// Prints the time per block, the polls and the CPU time of the async
+// write. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include "msp.h"
+#include "eeprom.h"
+
+#define EEPROM_ADDRESS  0x50
+#define BLOCK_ADDRESS   0x1122      // not page aligned, as in main.c
+#define BLOCK_SIZE      256
+
+#define US              (HOST_PS / 1000000)
+#define WRITE_CYCLE     (5000 * US) // tWC
+#define POLL_LIMIT      (100 * US)  // a poll is about 30 us at 375 kHz
+#define CPU_LIMIT       (7000 * US) // async write of BLOCK_SIZE: ~4.3 ms of byte
+                                    // interrupts, ~10 polls a page
+
+// 24LC256
+typedef struct {
+    uint8_t memory[EEPROM_SIZE];
+    uint8_t latch[EEPROM_PAGE_SIZE];
+    uint8_t latched[EEPROM_PAGE_SIZE];
+    uint16_t address;
+    uint8_t address_bytes;          // address bytes received since start
+    uint8_t data_bytes;             // data bytes in this page write
+    uint64_t busy_until;
+    uint8_t was_busy;
+    uint32_t page_writes;
+    uint32_t wraps;                 // page writes that wrapped in the page
+    uint32_t nacks;                 // addresses not ACKed in a write cycle
+    uint64_t latency;               // worst write cycle end to next ACK
+    uint8_t nack_read;              // test: do not ACK the read address
+} Eeprom;
+
+static Eeprom rom;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static uint8_t rom_start(void* ctx, uint8_t read)
+{
+    Eeprom* e = ctx;
+    uint64_t now = HOST_time();
+
+    if (read && e->nack_read)
+        return 0;
+    if (now < e->busy_until) {
+        e->nacks++;
+        e->was_busy = 1;
+        return 0;
+    }
+    if (e->was_busy && (now - e->busy_until > e->latency))
+        e->latency = now - e->busy_until;
+    e->was_busy = 0;
+    e->address_bytes = 0;
+    e->data_bytes = 0;
+    memset(e->latched, 0, sizeof(e->latched));
+    return 1;
+}
+
+static uint8_t rom_write(void* ctx, uint8_t byte)
+{
+    Eeprom* e = ctx;
+    uint8_t offset;
+
+    if (e->address_bytes == 0) {
+        e->address = (uint16_t)(byte & 0x7F) << 8;
+        e->address_bytes = 1;
+    }
+    else if (e->address_bytes == 1) {
+        e->address |= byte;
+        e->address_bytes = 2;
+    }
+    else {                          // the low 6 address bits wrap in the page
+        offset = (e->address + e->data_bytes) % EEPROM_PAGE_SIZE;
+        e->latch[offset] = byte;
+        e->latched[offset] = 1;
+        e->data_bytes++;
+    }
+    return 1;
+}
+
+static uint8_t rom_read(void* ctx)
+{
+    Eeprom* e = ctx;
+    uint8_t byte = e->memory[e->address];
+
+    e->address = (e->address + 1) % EEPROM_SIZE;
+    return byte;
+}
+
+static void rom_stop(void* ctx)
+{
+    Eeprom* e = ctx;
+    uint16_t page = e->address & ~(EEPROM_PAGE_SIZE - 1);
+    uint8_t offset;
+
+    if (!e->data_bytes)
+        return;                     // address only or ACK poll
+    for (offset = 0; offset < EEPROM_PAGE_SIZE; offset++)
+        if (e->latched[offset])
+            e->memory[page + offset] = e->latch[offset];
+    if ((e->address % EEPROM_PAGE_SIZE) + e->data_bytes > EEPROM_PAGE_SIZE)
+        e->wraps++;
+    e->page_writes++;
+    e->data_bytes = 0;
+    e->busy_until = HOST_time() + WRITE_CYCLE;
+}
+
+static const HOST_i2c_target rom_target = { rom_start, rom_write, rom_read, rom_stop, &rom };
+
+static volatile uint8_t async_status = 0xFF;
+
+static void async_done(uint8_t status)
+{
+    async_status = status;
+}
+
+// pages a block of length bytes at address takes
+static uint32_t pages(uint16_t address, uint16_t length)
+{
+    return (address + length - 1) / EEPROM_PAGE_SIZE - address / EEPROM_PAGE_SIZE + 1;
+}
+
+static void fill(uint8_t* block, uint8_t seed)
+{
+    uint16_t index;
+
+    for (index = 0; index < BLOCK_SIZE; index++)
+        block[index] = (index ^ 0x5A) + seed;
+}
+
+int main(void)
+{
+    static uint8_t write_block[BLOCK_SIZE], read_block[BLOCK_SIZE];
+    uint64_t start, cpu;
+    uint32_t writes, nacks;
+    uint8_t status;
+
+    memset(rom.memory, 0xFF, sizeof(rom.memory));
+    HOST_i2c_attach(0, EEPROM_ADDRESS, &rom_target);
+    EEPROM_init(EEPROM_ADDRESS);
+    __enable_irq();
+
+    // blocking write and read back
+    fill(write_block, 0);
+    start = HOST_time();
+    status = EEPROM_write(BLOCK_ADDRESS, write_block, BLOCK_SIZE);
+    check(status == EEPROM_OK, "EEPROM_write returns EEPROM_OK");
+    printf("EEPROM_write %u bytes: %.2f ms, %u pages, %u NACKed polls\n", BLOCK_SIZE,
+           (double)(HOST_time() - start) / (1000 * US), rom.page_writes, rom.nacks);
+    check(rom.page_writes == pages(BLOCK_ADDRESS, BLOCK_SIZE), "one write cycle per page");
+    check(rom.nacks > 0, "EEPROM NACKs while it writes");
+
+    start = HOST_time();
+    status = EEPROM_read(BLOCK_ADDRESS, read_block, BLOCK_SIZE);
+    check(status == EEPROM_OK, "EEPROM_read returns EEPROM_OK");
+    check(!memcmp(read_block, write_block, BLOCK_SIZE), "blocking write reads back");
+    check(!memcmp(&rom.memory[BLOCK_ADDRESS], write_block, BLOCK_SIZE), "blocking write in memory");
+    check(rom.memory[BLOCK_ADDRESS - 1] == 0xFF && rom.memory[BLOCK_ADDRESS + BLOCK_SIZE] == 0xFF,
+          "bytes around the block untouched");
+    printf("EEPROM_read %u bytes: %.2f ms\n", BLOCK_SIZE, (double)(HOST_time() - start) / (1000 * US));
+
+    // async write of new data over the same block
+    fill(write_block, 0x33);
+    writes = rom.page_writes;
+    nacks = rom.nacks;
+    cpu = HOST_stats.busy + HOST_stats.isr;
+    start = HOST_time();
+    status = EEPROM_write_async(BLOCK_ADDRESS, write_block, BLOCK_SIZE, async_done);
+    check(status == EEPROM_OK, "EEPROM_write_async starts");
+    check(EEPROM_write_async(0, write_block, 1, async_done) == EEPROM_BUSY,
+          "second async write is EEPROM_BUSY");
+    while (EEPROM_busy())
+        __sleep();
+    cpu = HOST_stats.busy + HOST_stats.isr - cpu;
+    check(async_status == EEPROM_OK, "async write calls done with EEPROM_OK");
+    check(rom.page_writes - writes == pages(BLOCK_ADDRESS, BLOCK_SIZE), "async: one write cycle per page");
+    check(cpu < CPU_LIMIT, "async write leaves the CPU free in the write cycles");
+    printf("EEPROM_write_async %u bytes: %.2f ms, %u NACKed polls, %.2f ms of CPU\n", BLOCK_SIZE,
+           (double)(HOST_time() - start) / (1000 * US), rom.nacks - nacks, (double)cpu / (1000 * US));
+
+    EEPROM_read(BLOCK_ADDRESS, read_block, BLOCK_SIZE);
+    check(!memcmp(read_block, write_block, BLOCK_SIZE), "async write reads back");
+
+    check(rom.wraps == 0, "no page write wraps inside its page");
+    check(rom.latency < POLL_LIMIT, "ACK polling ends within one poll of the write cycle");
+    printf("write cycle end to ACK: %.1f us worst\n", (double)rom.latency / US);
+
+    // the bus belongs to an async write until done
+    async_status = 0xFF;
+    EEPROM_write_async(BLOCK_ADDRESS, write_block, 1, async_done);
+    check(EEPROM_read(BLOCK_ADDRESS, read_block, 1) == EEPROM_BUSY, "EEPROM_read during an async write is EEPROM_BUSY");
+    check(EEPROM_write(BLOCK_ADDRESS, write_block, 1) == EEPROM_BUSY, "EEPROM_write during an async write is EEPROM_BUSY");
+    while (EEPROM_busy())
+        __sleep();
+    check(async_status == EEPROM_OK, "async write not disturbed by EEPROM_BUSY calls");
+
+    // read address NACKed after the repeated start, as by a write cycle
+    rom.nack_read = 1;
+    check(EEPROM_read(BLOCK_ADDRESS, read_block, 4) == EEPROM_NACK, "EEPROM_read with the read address NACKed is EEPROM_NACK");
+    rom.nack_read = 0;
+    check((EEPROM_read(BLOCK_ADDRESS, read_block, 4) == EEPROM_OK) && (read_block[0] == write_block[0]),
+          "bus usable after a NACKed read");
+
+    // the model itself: 4 bytes from the last 2 of a page wrap to its start
+    rom_start(&rom, 0);
+    HOST_run(WRITE_CYCLE);
+    rom_start(&rom, 0);
+    rom_write(&rom, 0x00);
+    rom_write(&rom, 0x3E);
+    rom_write(&rom, 1);
+    rom_write(&rom, 2);
+    rom_write(&rom, 3);
+    rom_write(&rom, 4);
+    rom_stop(&rom);
+    check(rom.memory[0x3E] == 1 && rom.memory[0x3F] == 2 && rom.memory[0x00] == 3 &&
+          rom.memory[0x01] == 4 && rom.memory[0x40] == 0xFF, "model wraps a page write in its page");
+    HOST_run(WRITE_CYCLE);
+
+    // no EEPROM on the bus
+    HOST_i2c_attach(0, EEPROM_ADDRESS, 0);
+    check(EEPROM_write(0, write_block, 1) == EEPROM_NACK, "EEPROM_write without EEPROM is EEPROM_NACK");
+    check(EEPROM_read(0, read_block, 1) == EEPROM_NACK, "EEPROM_read without EEPROM is EEPROM_NACK");
+
+    return failed;
+}
+
+#endif
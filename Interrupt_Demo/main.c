@@ -1,26 +1,47 @@
 // Program to introduce interrupts using the MSP432 Launcpad dev board
 // Left button on the Launchpad will cause the red LED to toggle on and off
+// The button ISR only posts work to the scheduler (sched.c), the LED is
+// toggled from main context and a one shot timer re-enables the button
+// after it stops bouncing. The CPU sleeps the rest of the time.
 // P1.1 -> Button (active low)
 // P1.0 -> Red LED
 //
 // Paul Hummel
 
 #include "msp.h"
+#include "sched.h"
+#include "pinmap.h"
+
+#define DEBOUNCE_MS 20
+
+#define BUTTON_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      /* red LED, off */ \
+    PIN(1, 1, PIN_IN_PULLUP)    /* button, active low */
+
+PIN_TABLE(button_pins, BUTTON_PINS);
+
+static SCHED_timer debounce_timer;
+
+// task to turn the button interrupt back on once it has settled
+static void button_ready(uint32_t data)
+{
+    P1->IFG &= ~BIT1;           // drop edges from the bounce
+    P1->IE |= BIT1;
+}
+
+// task posted by the button ISR
+static void button_pressed(uint32_t data)
+{
+    P1->OUT ^= BIT0;            // toggle red LED
+    SCHED_start(&debounce_timer, button_ready, 0, DEBOUNCE_MS, 0);
+}
 
 void main(void)
 {
     // Hold the watchdog
     WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;
 
-    P1->SEL0 &= ~(BIT0 | BIT1);   // set button and red LED to GPIO
-    P1->SEL1 &= ~(BIT0 | BIT1);
-
-    P1->DIR &= ~(BIT1);           // set button as input
-    P1->REN |= (BIT1);            // enable resistor on button input
-    P1->OUT |= (BIT1);            // set resistor to pull up
-
-    P1->DIR |= (BIT0);            // set red LED as output
-    P1->OUT &= ~(BIT0);           // initialize red LED off
+    PIN_apply(button_pins, PIN_COUNT(button_pins));  // button and red LED
 
     P1->IE |= BIT1;               // enable interrupts on button
     P1->IES |= BIT1;              // set interrupt on falling edge
@@ -28,19 +49,20 @@ void main(void)
 
     NVIC->ISER[1] = (1 << 3);     // enable P1 interrupts in NVIC
 
-    __enable_irq();               // enable interrupts globally
-
-    while(1);
+    SCHED_init();
+    SCHED_run();                  // enables interrupts, sleeps between tasks
 }
 
 // GPIO Port 1 ISR
-// Configured to trigger on the falling edge of P1.1 and toggle Red LED (P1.0)
+// Configured to trigger on the falling edge of P1.1 and post the work to
+// toggle Red LED (P1.0)
 void PORT1_IRQHandler(void){    // P1 interrupt handler
 
     if (P1->IFG & BIT1)     // check if interrupt from button
     {
-        P1->OUT ^= BIT0;    // toggle red LED
+        P1->IE &= ~BIT1;    // ignore bounces until button_ready
         P1->IFG &= ~BIT1;   // clear interrupt flag
+        SCHED_post(button_pressed, 0);
     }
 }
 
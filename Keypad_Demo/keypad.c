@@ -0,0 +1,236 @@
+// Interrupt driven matrix keypad scanner with per-key debounce
+//
+// PORT4 row rising edge -> start TIMER_A2, disable row interrupt
+// TIMER_A2 CCR0 (ACLK)  -> scan columns, debounce, queue events
+// all keys released     -> stop TIMER_A2, drive columns, enable row interrupt
+
+#include "msp.h"
+#include "keypad.h"
+
+#define COL1  BIT4
+#define COL2  BIT5
+#define COL3  BIT6
+#define ROW1  BIT0
+#define ROW2  BIT1
+#define ROW3  BIT2
+#define ROW4  BIT3
+
+#define COL_MASK (COL1 | COL2 | COL3)
+#define ROW_MASK (ROW1 | ROW2 | ROW3 | ROW4)
+
+#define COLS    3
+#define ROWS    4
+#define KEYS    (COLS * ROWS)
+
+#define ACLK_FREQ   32768           // REFO / LFXT
+#define SCAN_PERIOD ((ACLK_FREQ * KEYPAD_SCAN_MS) / 1000)
+
+#define QUEUE_MASK (KEYPAD_QUEUE_SIZE - 1)
+
+// key value for the key at each matrix position, row major
+static const uint8_t key_value[KEYS] = {
+    1, 2, 3,
+    4, 5, 6,
+    7, 8, 9,
+    10, 0, 12
+};
+
+static uint16_t key_state = 0;          // debounced state, bit per position
+static uint8_t key_count[KEYS];         // scans the raw state has differed
+
+// head is only written by the ISR, tail only by KEYPAD_get_event
+static uint8_t queue[KEYPAD_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;
+static volatile uint16_t queue_tail = 0;
+static volatile uint16_t dropped = 0;
+
+// Function to put the keypad in idle, all columns high and wait for any row
+// to go high
+static void KEYPAD_idle(void)
+{
+    TIMER_A2->CTL &= ~TIMER_A_CTL_MC_MASK;  // stop scanning
+
+    P4->OUT |= COL_MASK;
+    P4->DIR |= COL_MASK;                    // drive all columns high
+    _delay_cycles(25);                      // wait for signals to settle
+
+    P4->IFG &= ~ROW_MASK;
+    P4->IE |= ROW_MASK;
+}
+
+// Function to read the whole matrix. Only the column being read is driven,
+// the others are inputs so 2 keys in one row can not short 2 columns.
+// Returns a bit per key position, row major.
+static uint16_t KEYPAD_scan(void)
+{
+    uint16_t raw = 0;
+    uint8_t col, row, rows;
+
+    P4->OUT &= ~COL_MASK;
+    P4->DIR &= ~COL_MASK;                   // all columns high impedance
+
+    for (col = 0; col < COLS; col++) {
+        P4->OUT |= (COL1 << col);
+        P4->DIR |= (COL1 << col);           // drive only this column
+        _delay_cycles(25);                  // wait for signals to settle
+
+        rows = P4->IN & ROW_MASK;
+
+        P4->DIR &= ~(COL1 << col);
+        P4->OUT &= ~(COL1 << col);
+
+        for (row = 0; row < ROWS; row++)
+            if (rows & (ROW1 << row))
+                raw |= 1 << (row * COLS + col);
+    }
+
+    return raw;
+}
+
+// Returns 1 if any 2 columns share 2 or more pressed rows. Those 4 keys form
+// a rectangle and any one of them could be a ghost.
+static uint8_t KEYPAD_ghosted(uint16_t raw)
+{
+    uint8_t col_a, col_b, row, common;
+
+    for (col_a = 0; col_a < COLS - 1; col_a++) {
+        for (col_b = col_a + 1; col_b < COLS; col_b++) {
+            common = 0;
+            for (row = 0; row < ROWS; row++)
+                if ((raw & (1 << (row * COLS + col_a))) &&
+                    (raw & (1 << (row * COLS + col_b))))
+                    common++;
+            if (common >= 2)
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Function to add an event to the queue, counts events lost if it is full
+static void KEYPAD_queue(uint8_t event)
+{
+    uint16_t head = queue_head;
+
+    if (((head + 1) & QUEUE_MASK) == queue_tail) {  // queue full
+        dropped++;
+        return;
+    }
+
+    queue[head] = event;
+    queue_head = (head + 1) & QUEUE_MASK;
+}
+
+/* this function initializes Port 4 that is connected to the keypad and
+ * TIMER_A2 used to pace the scans. The row pins are inputs with pull-down
+ * resistors and interrupt on a rising edge.
+ */
+void KEYPAD_init(void)
+{
+    uint8_t index;
+
+    P4->SEL0 &= ~(ROW_MASK | COL_MASK);
+    P4->SEL1 &= ~(ROW_MASK | COL_MASK);
+    P4->DIR &= ~ROW_MASK;       // make row pins inputs
+    P4->REN |= ROW_MASK;        // enable resistor for row pins
+    P4->OUT &= ~(ROW_MASK);     // make row pins pull-down
+    P4->IES &= ~ROW_MASK;       // interrupt on low to high
+
+    key_state = 0;
+    for (index = 0; index < KEYS; index++)
+        key_count[index] = 0;
+    queue_head = queue_tail = 0;
+    dropped = 0;
+
+    // TIMER_A2 up mode from ACLK, started by the first row edge
+    TIMER_A2->CTL = TIMER_A_CTL_SSEL__ACLK | TIMER_A_CTL_CLR;
+    TIMER_A2->CCR[0] = SCAN_PERIOD - 1;
+    TIMER_A2->CCTL[0] = TIMER_A_CCTLN_CCIE;
+
+    KEYPAD_idle();
+
+    NVIC->ISER[1] = 1 << ((PORT4_IRQn) & 31);
+    NVIC->ISER[0] = 1 << ((TA2_0_IRQn) & 31);
+}
+
+// Function to get the next key event. Returns the key value, with
+// KEYPAD_RELEASE set for a release, or KEYPAD_NO_EVENT if the queue is empty
+uint8_t KEYPAD_get_event(void)
+{
+    uint16_t tail = queue_tail;
+    uint8_t event;
+
+    if (tail == queue_head)
+        return KEYPAD_NO_EVENT;
+
+    event = queue[tail];
+    queue_tail = (tail + 1) & QUEUE_MASK;   // release the space to the ISR
+
+    return event;
+}
+
+// Debounced state of every key, bit n is set while key value n is held
+uint16_t KEYPAD_pressed(void)
+{
+    uint16_t state = key_state;
+    uint16_t pressed = 0;
+    uint8_t index;
+
+    for (index = 0; index < KEYS; index++)
+        if (state & (1 << index))
+            pressed |= 1 << key_value[index];
+
+    return pressed;
+}
+
+// Number of events lost because the queue was full
+uint16_t KEYPAD_dropped(void)
+{
+    return dropped;
+}
+
+// Port 4 ISR, a row went high so a key is pressed. Scanning takes over
+// until all keys are released.
+void PORT4_IRQHandler(void)
+{
+    P4->IE &= ~ROW_MASK;
+    P4->IFG &= ~ROW_MASK;
+
+    TIMER_A2->CTL |= TIMER_A_CTL_CLR;
+    TIMER_A2->CTL |= TIMER_A_CTL_MC__UP;
+}
+
+// TIMER_A2 CCR0 ISR, scan the matrix and debounce every key. A key changes
+// state only after the raw state has differed for KEYPAD_DEBOUNCE scans
+// in a row.
+void TA2_0_IRQHandler(void)
+{
+    uint16_t raw, changed;
+    uint8_t index;
+
+    TIMER_A2->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+    raw = KEYPAD_scan();
+
+    if (!KEYPAD_ghosted(raw)) {
+        changed = raw ^ key_state;
+
+        for (index = 0; index < KEYS; index++) {
+            if (!(changed & (1 << index))) {
+                key_count[index] = 0;
+            }
+            else if (++key_count[index] >= KEYPAD_DEBOUNCE) {
+                key_count[index] = 0;
+                key_state ^= 1 << index;
+                if (key_state & (1 << index))
+                    KEYPAD_queue(key_value[index]);
+                else
+                    KEYPAD_queue(key_value[index] | KEYPAD_RELEASE);
+            }
+        }
+    }
+
+    if ((raw == 0) && (key_state == 0))
+        KEYPAD_idle();
+}
@@ -0,0 +1,41 @@
+/*
+ * keypad.h
+ *
+ *  Interrupt driven 4x3 matrix keypad on Port 4
+ *  Columns are connected to 4.4 - 4.6, Rows 4.0 - 4.3
+ *
+ *  While no key is pressed all columns are driven high and the CPU can
+ *  sleep until a row pin rising edge interrupt. The edge starts TIMER_A2
+ *  which scans the whole matrix every KEYPAD_SCAN_MS and debounces each
+ *  key on its own, so any number of keys can be held at once. Press and
+ *  release events are put in a queue read with KEYPAD_get_event(). Once
+ *  every key is released the timer is stopped and the row interrupt is
+ *  enabled again.
+ *
+ *  Without diodes in the keypad, 3 keys on the corners of a rectangle
+ *  make the 4th corner look pressed (ghosting). A scan with a rectangle
+ *  can not be trusted and is ignored, so the keys keep their last state
+ *  until the pattern is broken.
+ *
+ *  Key values: 1-9, * is 10, 0 is 0, # is 12
+ */
+
+#ifndef KEYPAD_H_
+#define KEYPAD_H_
+
+#include <stdint.h>
+
+#define KEYPAD_SCAN_MS      5       // time between scans
+#define KEYPAD_DEBOUNCE     4       // matching scans to change a key state
+#define KEYPAD_QUEUE_SIZE   16      // must be a power of 2
+
+#define KEYPAD_NO_EVENT     0xFF
+#define KEYPAD_RELEASE      0x80    // set in an event when the key is released
+#define KEYPAD_KEY_MASK     0x0F
+
+void KEYPAD_init(void);
+uint8_t KEYPAD_get_event(void);
+uint16_t KEYPAD_pressed(void);
+uint16_t KEYPAD_dropped(void);
+
+#endif /* KEYPAD_H_ */
@@ -0,0 +1,279 @@
+// PC test of keypad.c against a model of a 4x3 matrix keypad on the GPIO
+// model in Host/
+//
+//     gcc -O2 -I. -I../Host keypad_host.c keypad.c ../Host/msp_host.c -lm -o keypad
+//
+// Each key is a switch from its row to its column with no diode, so the
+// level on a row is worked out from every closed key: a row joined to a
+// driven column through any path of keys and undriven pins reads that
+// column, otherwise its pull-down. Two driven columns at different levels
+// joined by keys are counted as a short. Contacts bounce for a few ms on
+// press and release. The driver must give one press and one release per
+// key however it bounces, ignore a glitch shorter than the debounce, keep
+// keys held together apart, never report the ghost of 3 keys on the
+// corners of a rectangle, count events lost when the queue is full and
+// stop the timer when idle. Prints the press and release latency and the
+// interrupts while a key is held and while idle. Exits with 1 if a check
+// fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "msp.h"
+#include "keypad.h"
+
+#define ROWS        4
+#define COLS        3
+#define KEYS        (ROWS * COLS)
+#define ROW_PIN     0               // rows P4.0 - P4.3
+#define COL_PIN     4               // columns P4.4 - P4.6
+
+#define US          (HOST_PS / 1000000)
+#define STEP        (50 * US)       // contacts change at most this often
+#define BOUNCE_US   3000            // longest bounce
+#define LOG_SIZE    64
+
+static const uint8_t key_value[KEYS] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 12 };
+
+// the keypad
+static uint8_t contact[KEYS];       // 1 while the switch is closed
+static uint8_t target[KEYS];        // level once the bounce is over
+static uint64_t bounce_end[KEYS], next_toggle[KEYS];
+static uint8_t p4_out, p4_dir;
+static uint32_t shorts;
+
+// events read by the test, with the time they were read
+static uint8_t log_event[LOG_SIZE];
+static uint64_t log_time[LOG_SIZE];
+static uint8_t log_count, reading = 1;
+
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static uint8_t find(uint8_t* parent, uint8_t node)
+{
+    while (parent[node] != node)
+        node = parent[node];
+    return node;
+}
+
+// nodes 0 - 3 are the rows, 4 - 6 the columns
+static void matrix_update(void)
+{
+    uint8_t parent[ROWS + COLS], high[ROWS + COLS] = { 0 }, low[ROWS + COLS] = { 0 };
+    uint8_t node, key, root, col;
+
+    for (node = 0; node < ROWS + COLS; node++)
+        parent[node] = node;
+    for (key = 0; key < KEYS; key++)
+        if (contact[key])
+            parent[find(parent, key / COLS)] = find(parent, ROWS + key % COLS);
+
+    for (col = 0; col < COLS; col++)
+        if (p4_dir & (1 << (COL_PIN + col))) {
+            root = find(parent, ROWS + col);
+            if (p4_out & (1 << (COL_PIN + col)))
+                high[root] = 1;
+            else
+                low[root] = 1;
+        }
+
+    for (node = 0; node < ROWS; node++) {
+        root = find(parent, node);
+        if (high[root] && low[root])
+            shorts++;
+        HOST_pin(4, ROW_PIN + node, high[root] ? 1 : low[root] ? 0 : -1);
+    }
+}
+
+static void port_out(uint8_t port, uint8_t out, uint8_t dir)
+{
+    if (port != 4)
+        return;
+    p4_out = out;
+    p4_dir = dir;
+    matrix_update();
+}
+
+// Function to press (down 1) or release a key, the contact bounces for
+// up to bounce_us
+static void key(uint8_t index, uint8_t down, uint32_t bounce_us)
+{
+    target[index] = down;
+    bounce_end[index] = HOST_time() + (uint64_t)bounce_us * US;
+    next_toggle[index] = HOST_time();
+}
+
+static void contacts_update(void)
+{
+    uint64_t now = HOST_time();
+    uint8_t index, changed = 0, level;
+
+    for (index = 0; index < KEYS; index++) {
+        if (now >= bounce_end[index])
+            level = target[index];
+        else if (now >= next_toggle[index]) {
+            level = !contact[index];
+            next_toggle[index] = now + (20 + rand() % 400) * US;
+        }
+        else
+            continue;
+        changed |= level != contact[index];
+        contact[index] = level;
+    }
+    if (changed)
+        matrix_update();
+}
+
+static void run_ms(uint32_t ms)
+{
+    uint64_t end = HOST_time() + (uint64_t)ms * 1000 * US;
+    uint8_t event;
+
+    while (HOST_time() < end) {
+        contacts_update();
+        HOST_run(STEP);
+        while (reading && ((event = KEYPAD_get_event()) != KEYPAD_NO_EVENT))
+            if (log_count < LOG_SIZE) {
+                log_event[log_count] = event;
+                log_time[log_count++] = HOST_time();
+            }
+    }
+}
+
+// index of the first logged event equal to event, -1 if none
+static int logged(uint8_t event)
+{
+    int index;
+
+    for (index = 0; index < log_count; index++)
+        if (log_event[index] == event)
+            return index;
+    return -1;
+}
+
+static uint8_t count_of(uint8_t event)
+{
+    uint8_t index, count = 0;
+
+    for (index = 0; index < log_count; index++)
+        count += log_event[index] == event;
+    return count;
+}
+
+int main(void)
+{
+    uint64_t press_time, release_time, press_worst = 0, release_worst = 0, held, idle;
+    uint32_t interrupts;
+    uint8_t index, ok;
+
+    HOST_port_out = port_out;
+    srand(1);
+    KEYPAD_init();
+    __enable_irq();
+    run_ms(10);
+
+    // every key, bouncing on press and release
+    ok = 1;
+    for (index = 0; index < KEYS; index++) {
+        log_count = 0;
+        press_time = HOST_time();
+        key(index, 1, BOUNCE_US);
+        run_ms(100);
+        release_time = HOST_time();
+        key(index, 0, BOUNCE_US);
+        run_ms(100);
+
+        ok &= (log_count == 2) && (log_event[0] == key_value[index]) &&
+              (log_event[1] == (key_value[index] | KEYPAD_RELEASE));
+        if (log_count == 2) {
+            if (log_time[0] - press_time > press_worst)
+                press_worst = log_time[0] - press_time;
+            if (log_time[1] - release_time > release_worst)
+                release_worst = log_time[1] - release_time;
+        }
+    }
+    check(ok, "one press and one release for every key through the bounce");
+    printf("latency with %u ms of bounce: press %.1f ms, release %.1f ms worst (%u scans of %u ms)\n",
+           BOUNCE_US / 1000, (double)press_worst / (1000 * US), (double)release_worst / (1000 * US),
+           KEYPAD_DEBOUNCE, KEYPAD_SCAN_MS);
+    check(press_worst <= (uint64_t)(BOUNCE_US / 1000 + (KEYPAD_DEBOUNCE + 1) * KEYPAD_SCAN_MS + 1) * 1000 * US,
+          "press within the bounce and debounce scans");
+
+    // a glitch shorter than the debounce
+    log_count = 0;
+    key(4, 1, 0);
+    run_ms(KEYPAD_SCAN_MS * (KEYPAD_DEBOUNCE - 2));
+    key(4, 0, 0);
+    run_ms(100);
+    check(log_count == 0, "glitch shorter than the debounce ignored");
+
+    // 2 keys held together, CPU load while held and idle
+    log_count = 0;
+    key(0, 1, BOUNCE_US);
+    run_ms(50);
+    key(4, 1, BOUNCE_US);
+    run_ms(50);
+    check(KEYPAD_pressed() == ((1 << key_value[0]) | (1 << key_value[4])), "2 keys held");
+    interrupts = HOST_stats.interrupts;
+    run_ms(1000);
+    held = HOST_stats.interrupts - interrupts;
+    key(0, 0, BOUNCE_US);
+    key(4, 0, BOUNCE_US);
+    run_ms(100);
+    check((log_count == 4) && (count_of(key_value[0]) == 1) && (count_of(key_value[4]) == 1) &&
+          (count_of(key_value[0] | KEYPAD_RELEASE) == 1) && (count_of(key_value[4] | KEYPAD_RELEASE) == 1),
+          "2 keys: a press and a release each");
+
+    check(!(TIMER_A2->CTL & TIMER_A_CTL_MC_MASK), "timer stopped once all keys are up");
+    interrupts = HOST_stats.interrupts;
+    run_ms(1000);
+    idle = HOST_stats.interrupts - interrupts;
+    printf("interrupts in 1 s: %u with keys held, %u idle\n", (uint32_t)held, (uint32_t)idle);
+    check(idle == 0, "no interrupts while idle");
+
+    // 3 corners of a rectangle: 1, 2 and 4 make 5 look pressed
+    log_count = 0;
+    key(0, 1, BOUNCE_US);
+    key(1, 1, BOUNCE_US);
+    run_ms(50);
+    key(3, 1, BOUNCE_US);
+    run_ms(200);
+    check((logged(1) >= 0) && (logged(2) >= 0), "first 2 corners pressed");
+    check(logged(4) < 0, "third corner held back while the rectangle is there");
+    check(!(KEYPAD_pressed() & (1 << 5)), "ghost 5 not pressed");
+    key(1, 0, BOUNCE_US);                   // 2 up, the rectangle is broken
+    run_ms(100);
+    check((logged(4) >= 0) && (logged(2 | KEYPAD_RELEASE) >= 0), "third corner once the rectangle is gone");
+    key(0, 0, BOUNCE_US);
+    key(3, 0, BOUNCE_US);
+    run_ms(100);
+    check(logged(5) < 0, "ghost never reported");
+
+    // events not read: the queue holds KEYPAD_QUEUE_SIZE - 1
+    log_count = 0;
+    reading = 0;
+    for (index = 0; index < 10; index++) {
+        key(index, 1, 0);
+        run_ms(50);
+        key(index, 0, 0);
+        run_ms(50);
+    }
+    reading = 1;
+    run_ms(10);
+    check(log_count == KEYPAD_QUEUE_SIZE - 1, "full queue keeps the oldest events");
+    check(KEYPAD_dropped() == 20 - (KEYPAD_QUEUE_SIZE - 1), "lost events counted");
+
+    check(shorts == 0, "no 2 driven columns joined by keys");
+    return failed;
+}
+
+#endif
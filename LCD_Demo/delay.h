@@ -1,17 +0,0 @@
-/*
- * delay.h
- *
- *  Created on: Apr 5, 2018
- *      Author: Paul Hummel
- */
-
-#ifndef DELAY_H_
-#define DELAY_H_
-
-#include <stdint.h>
-
-void delay_ms(uint32_t time);
-void delay_us(uint32_t time);
-
-
-#endif /* DELAY_H_ */
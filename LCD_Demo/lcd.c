@@ -0,0 +1,182 @@
+// Interrupt driven 8-bit HD44780 LCD library
+// Entries are queued by the LCD functions and sent by the TIMER_A1 CCR0 ISR
+
+#include "msp.h"
+#include "lcd.h"
+#include "pinmap.h"
+
+#define RS BIT5     // P3.5
+#define RW BIT6     // P3.6
+#define EN BIT7     // P3.7
+
+// control on P3.5 - P3.7 (all low, EN low), data bus on P4.0 - P4.7
+#define LCD_PINS(PIN) \
+    PIN(3, 5, PIN_OUT_LOW)  /* RS */ \
+    PIN(3, 6, PIN_OUT_LOW)  /* RW */ \
+    PIN(3, 7, PIN_OUT_LOW)  /* EN */ \
+    PIN(4, 0, PIN_OUT_LOW)  /* D0 */ \
+    PIN(4, 1, PIN_OUT_LOW)  \
+    PIN(4, 2, PIN_OUT_LOW)  \
+    PIN(4, 3, PIN_OUT_LOW)  \
+    PIN(4, 4, PIN_OUT_LOW)  \
+    PIN(4, 5, PIN_OUT_LOW)  \
+    PIN(4, 6, PIN_OUT_LOW)  \
+    PIN(4, 7, PIN_OUT_LOW)  /* D7 */
+
+PIN_TABLE(lcd_pins, LCD_PINS);
+
+// queue entry is the byte to send in the low 8 bits plus these flags
+#define ENTRY_DATA    0x0100    // RS = 1, character instead of command
+#define ENTRY_WAIT    0x0400    // nothing sent, wait low byte ms
+
+#define SETTLE_US     40        // all others 37 us
+#define SETTLE_CLR_US 1700      // command 1 and 2 need up to 1.52ms
+#define POWER_UP_MS   40        // wait >40 ms for LCD to power up
+#define WAKE_MS       5         // wait >4.1 ms after the first wake up
+
+#define E_PULSE_NS    500       // E high for > 460 ns
+#define DELAY_LOOP    3         // MCLK cycles per E_delay loop
+
+#define QUEUE_MASK (LCD_QUEUE_SIZE - 1)
+
+static uint16_t queue[LCD_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;    // written by LCD functions
+static volatile uint16_t queue_tail = 0;    // written by ISR
+static volatile uint8_t timer_running = 0;  // ISR is working on the queue
+static uint16_t e_loops = 1;                // E_delay loops, set by LCD_init
+
+// Function to add an entry to the queue and start the timer if it is idle.
+// Returns 0 if the queue is full.
+static uint8_t LCD_queue(uint16_t entry)
+{
+    uint16_t head = queue_head;
+
+    if (((head + 1) & QUEUE_MASK) == queue_tail)    // queue full
+        return 0;
+
+    queue[head] = entry;
+    queue_head = (head + 1) & QUEUE_MASK;
+
+    if (!timer_running) {           // ISR stopped when queue emptied, restart
+        timer_running = 1;
+        TIMER_A1->CCR[0] = TIMER_A1->R + 10;
+        TIMER_A1->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    }
+
+    return 1;
+}
+
+// Function to hold E high for E_PULSE_NS at the MCLK LCD_init saw
+static void E_delay(void)
+{
+    uint16_t loops;
+
+    for (loops = e_loops; loops; loops--)
+        __delay_cycles(DELAY_LOOP);
+}
+
+// Function to initialize the LCD display
+// 8-bit mode, 2 line, cursor on
+// The init sequence is queued so this returns before the LCD is ready,
+// anything written after it is sent once the init is done. The E pulse
+// is timed from the MCLK at the time of the call.
+void LCD_init(void)
+{
+    SystemCoreClockUpdate();
+    e_loops = (SystemCoreClock / 1000) * E_PULSE_NS / 1000000 / DELAY_LOOP + 1;
+
+    // Setup GPIO for P3 and P4 to use LCD, all outputs with Enable low
+    PIN_apply(lcd_pins, PIN_COUNT(lcd_pins));
+
+    // TIMER_A1 continuous at SMCLK / 3 = 1 MHz, CCR0 schedules each entry
+    TIMER_A1->CCTL[0] = 0;
+    TIMER_A1->EX0 = TIMER_A_EX0_IDEX__3;
+    TIMER_A1->CTL = TIMER_A_CTL_SSEL__SMCLK
+                  | TIMER_A_CTL_ID__1
+                  | TIMER_A_CTL_MC__CONTINUOUS
+                  | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA1_0_IRQn) & 31);
+
+    queue_head = queue_tail = 0;
+    timer_running = 0;
+
+    // wake up 3 times before the function set, from any state the LCD is in
+    LCD_queue(ENTRY_WAIT | POWER_UP_MS);            // LCD power up
+    LCD_command(WAKE);
+    LCD_queue(ENTRY_WAIT | WAKE_MS);
+    LCD_command(WAKE);
+    LCD_queue(ENTRY_WAIT | 1);                      // > 100 us
+    LCD_command(WAKE);
+    LCD_command(MODE_8_BIT | MODE_2_LINE);          // set 8-bit data, 2-line
+    LCD_command(DISPLAY_ON | CURSOR_ON);            // display and cursor on
+    LCD_command(CLR_DISP);                          // clear screen
+    LCD_command(CURSOR_RIGHT);                      // move cursor right after each char
+}
+
+// Function to queue a single command. Returns 0 if the queue is full.
+uint8_t LCD_command(uint8_t command)
+{
+    return LCD_queue(command);
+}
+
+// Function to queue a single character at the cursor location.
+// Returns 0 if the queue is full.
+uint8_t LCD_write(uint8_t letter)
+{
+    return LCD_queue(ENTRY_DATA | letter);
+}
+
+// Number of entries that can be queued
+uint16_t LCD_queue_free(void)
+{
+    return (queue_tail - queue_head - 1) & QUEUE_MASK;
+}
+
+// Returns 1 while queued entries are still being sent to the LCD
+uint8_t LCD_busy(void)
+{
+    return timer_running;
+}
+
+// TIMER_A1 CCR0 ISR - send the next queued entry to the LCD and schedule
+// the following one after the LCD has had time to complete it
+void TA1_0_IRQHandler(void)
+{
+    uint16_t entry, tail;
+    uint16_t wait_us;
+
+    TIMER_A1->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+    tail = queue_tail;
+    if (tail == queue_head) {               // queue empty, stop until next entry
+        TIMER_A1->CCTL[0] = 0;
+        timer_running = 0;
+        return;
+    }
+
+    entry = queue[tail];
+    queue_tail = (tail + 1) & QUEUE_MASK;
+
+    if (entry & ENTRY_WAIT) {
+        wait_us = (entry & 0xFF) * 1000;
+    }
+    else {
+        if (entry & ENTRY_DATA)
+            P3->OUT = (P3->OUT & ~(EN | RW)) | RS;  // RS = 1, EN, R/W = 0
+        else
+            P3->OUT &= ~(EN | RS | RW);             // RS, R/W = 0
+        P4->OUT = entry;                    // put the byte on the data bus
+
+        P3->OUT |= EN;                      // Pulse E for > 460 ns
+        E_delay();
+        P3->OUT &= ~EN;
+
+        if (!(entry & ENTRY_DATA) && ((entry & 0xFF) < 4))
+            wait_us = SETTLE_CLR_US;
+        else
+            wait_us = SETTLE_US;
+    }
+
+    TIMER_A1->CCR[0] = TIMER_A1->R + wait_us;   // next entry, counted from
+                                                // the end of this one
+}
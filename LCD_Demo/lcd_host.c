@@ -0,0 +1,147 @@
+// PC test of lcd.c against the HD44780 model in Host/
+//
+//     gcc -O2 -I. -I../BSP -I../Host lcd_host.c lcd.c ../BSP/pinmap.c
+//         ../BSP/system_msp432p401r.c ../Host/hd44780.c ../Host/msp_host.c
+//         -lm -Wno-unknown-pragmas -o lcd
+//
+// LCD_init must bring the LCD to 8-bit, 2-line, display on, and the text
+// must land at the right DDRAM addresses with no timing or busy errors.
+// This is done at 3 MHz MCLK and again at 48 MHz, where LCD_init starts
+// from the state the first run left. Prints the CPU time (main and the
+// TIMER_A1 ISR) to send a line against the blocking writes with delay_us
+// the demo had, which must take more. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include "msp.h"
+#include "lcd.h"
+#include "hd44780.h"
+
+#define TEXT        "Microcontrollers"
+
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void wait_idle(void)
+{
+    while (LCD_busy())
+        HOST_run(100 * HOST_PS / 1000000);
+}
+
+// CPU busy and ISR time in us since the last call
+static double cpu_us(void)
+{
+    static uint64_t last;
+    uint64_t ps = HOST_stats.busy + HOST_stats.isr;
+    double us = (double)(ps - last) * 1e6 / HOST_PS;
+
+    last = ps;
+    return us;
+}
+
+static void row_is(uint8_t row, const char* want)
+{
+    char text[HD44780_COLS + 1], what[64];
+
+    HD44780_row(row, text);
+    snprintf(what, sizeof(what), "row %u \"%s\"", row, want);
+    check(!strncmp(text, want, strlen(want)), what);
+}
+
+static void write_text(const char* text)
+{
+    while (*text)
+        LCD_write(*text++);
+}
+
+// the blocking LCD_write LCD_Demo had: a 1 us E pulse and a 40 us wait
+// for the LCD, all of it CPU time
+static void blocking_char(uint8_t letter)
+{
+    uint32_t us = HOST_mclk() / 1000000;
+
+    P3->OUT |= BIT5;
+    P3->OUT &= ~BIT6;
+    P4->OUT = letter;
+    P3->OUT |= BIT7;
+    __delay_cycles(us);
+    P3->OUT &= ~BIT7;
+    __delay_cycles(40 * us);
+}
+
+static void set_48mhz(void)
+{
+    PCM->CTL0 = PCM_CTL0_KEY_VAL | PCM_CTL0_AMR_1;
+    while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) | FLCTL_BANK0_RDCTL_WAIT_1;
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) | FLCTL_BANK1_RDCTL_WAIT_1;
+    CS->KEY = CS_KEY_VAL;
+    CS->CTL1 = CS_CTL1_SELA__REFOCLK | CS_CTL1_SELS__DCOCLK | CS_CTL1_SELM__DCOCLK |
+               CS_CTL1_DIVS__16;        // SMCLK stays 3 MHz for TIMER_A1
+    CS->CTL0 = CS_CTL0_DCORSEL_5;
+    CS->KEY = 0;
+}
+
+static void show(const char* clock)
+{
+    uint16_t index;
+    double lcd, blocking;
+
+    LCD_init();
+    write_text("Hello");
+    LCD_command(SET_CURSOR | LINE_TWO);
+    write_text("World!");
+    wait_idle();
+
+    check(!HD44780.four_bit && HD44780.two_line && HD44780.display_on,
+          "LCD_init: 8-bit, 2-line, display on");
+    row_is(0, "Hello");
+    row_is(1, "World!");
+    check(HD44780.timing_errors == 0, "no timing errors");
+    check(HD44780.busy_errors == 0, "no bytes sent while busy");
+
+    // CPU time for a line, queued against blocking
+    LCD_command(SET_CURSOR | LINE_TWO);
+    wait_idle();
+    cpu_us();
+    write_text(TEXT);
+    wait_idle();
+    lcd = cpu_us();
+    row_is(1, TEXT);
+
+    LCD_command(SET_CURSOR | LINE_TWO);
+    wait_idle();
+    cpu_us();
+    for (index = 0; index < strlen(TEXT); index++)
+        blocking_char(TEXT[index]);
+    blocking = cpu_us();
+    printf("%s: \"%s\" queued %.1f us of CPU, blocking %.1f us (%.1f us per character saved)\n",
+           clock, TEXT, lcd, blocking, (blocking - lcd) / strlen(TEXT));
+    check(lcd < blocking, "queued writes take less CPU than blocking");
+}
+
+int main(void)
+{
+    HD44780_attach(4, 0);
+    __enable_irq();
+
+    show("3 MHz");
+    set_48mhz();
+    show("48 MHz");
+    printf("%u instructions, %u characters, %u E pulses\n",
+           HD44780.instructions, HD44780.characters, HD44780.transfers);
+
+    check(HOST_stats.flash_errors == 0, "no clock errors");
+    return failed;
+}
+
+#endif
@@ -0,0 +1,206 @@
+// Interrupt driven 4-bit HD44780 LCD library
+// Entries are queued by the LCD functions and sent by the TIMER_A1 CCR0 ISR
+
+#include "msp.h"
+#include "lcd.h"
+
+#define RS BIT5     // P3.5
+#define RW BIT6     // P3.6
+#define EN BIT7     // P3.7
+#define CONTROL_MASK  (RS | RW | EN)
+
+#define DB7 BIT7    // Data Nibble connected to
+#define DB6 BIT6    // P2.7 - 2.4
+#define DB5 BIT5
+#define DB4 BIT4
+#define DATA_MASK     (DB7 | DB6 | DB5 | DB4)
+
+// queue entry is the byte to send in the low 8 bits plus these flags
+#define ENTRY_DATA    0x0100    // RS = 1, character instead of command
+#define ENTRY_NIBBLE  0x0200    // send only the upper nibble (wake up)
+#define ENTRY_WAIT    0x0400    // nothing sent, wait low byte ms
+
+#define SETTLE_US     40        // all others 37 us
+#define SETTLE_CLR_US 1700      // command 1 and 2 need up to 1.52ms
+#define POWER_UP_MS   40        // wait >40 ms for LCD to power up
+#define WAKE_MS       5         // wait >4.1 ms after the first wake up
+
+#define E_PULSE_NS    500       // E high and E low, 1000 ns E cycle
+#define DELAY_LOOP    3         // MCLK cycles per E_delay loop
+
+#define QUEUE_MASK (LCD_QUEUE_SIZE - 1)
+
+static uint16_t queue[LCD_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;    // written by LCD functions
+static volatile uint16_t queue_tail = 0;    // written by ISR
+static volatile uint8_t timer_running = 0;  // ISR is working on the queue
+static uint16_t e_loops = 1;                // E_delay loops, set by LCD_init
+
+// Function to add an entry to the queue and start the timer if it is idle.
+// Returns 0 if the queue is full.
+static uint8_t LCD_queue(uint16_t entry)
+{
+    uint16_t head = queue_head;
+
+    if (((head + 1) & QUEUE_MASK) == queue_tail)    // queue full
+        return 0;
+
+    queue[head] = entry;
+    queue_head = (head + 1) & QUEUE_MASK;
+
+    if (!timer_running) {           // ISR stopped when queue emptied, restart
+        timer_running = 1;
+        TIMER_A1->CCR[0] = TIMER_A1->R + 10;
+        TIMER_A1->CCTL[0] = TIMER_A_CCTLN_CCIE;
+    }
+
+    return 1;
+}
+
+// Function to hold E high or low for E_PULSE_NS at the MCLK LCD_init saw
+static void E_delay(void)
+{
+    uint16_t loops;
+
+    for (loops = e_loops; loops; loops--)
+        __delay_cycles(DELAY_LOOP);
+}
+
+// Function to put a nibble (upper 4 bits of value) on the bus and pulse EN
+static void LCD_nibble(uint8_t value)
+{
+    P2->OUT = (P2->OUT & ~DATA_MASK) | (value & DATA_MASK);
+
+    P3->OUT |= EN;                  // Pulse E for > 460 ns
+    E_delay();
+    P3->OUT &= ~EN;
+}
+
+// Function to initialize the LCD display
+// 4-bit mode, 2 line, cursor on
+// The init sequence is queued so this returns before the LCD is ready,
+// anything written after it is sent once the init is done. The E pulse
+// is timed from the MCLK at the time of the call.
+void LCD_init(void)
+{
+    SystemCoreClockUpdate();
+    e_loops = (SystemCoreClock / 1000) * E_PULSE_NS / 1000000 / DELAY_LOOP + 1;
+
+    // Setup GPIO for P2 and P3 to use LCD
+    P3->SEL0 &= ~(CONTROL_MASK);    // Control signals RS, RW, EN
+    P3->SEL1 &= ~(CONTROL_MASK);    // Setup as GPIO outputs
+    P3->DIR |= (CONTROL_MASK);
+    P3->OUT &= ~(CONTROL_MASK);     // Set Enable low
+
+    P2->SEL0 &= ~(DATA_MASK);       // Data bits DB7-DB4
+    P2->SEL1 &= ~(DATA_MASK);       // Setup as GPIO outputs
+    P2->DIR |= (DATA_MASK);
+
+    // TIMER_A1 continuous at SMCLK / 3 = 1 MHz, CCR0 schedules each entry
+    TIMER_A1->CCTL[0] = 0;
+    TIMER_A1->EX0 = TIMER_A_EX0_IDEX__3;
+    TIMER_A1->CTL = TIMER_A_CTL_SSEL__SMCLK
+                  | TIMER_A_CTL_ID__1
+                  | TIMER_A_CTL_MC__CONTINUOUS
+                  | TIMER_A_CTL_CLR;
+    NVIC->ISER[0] = 1 << ((TA1_0_IRQn) & 31);
+
+    queue_head = queue_tail = 0;
+    timer_running = 0;
+
+    // wake up 3 times in 8-bit mode then switch to 4-bit, from any state
+    // the LCD is in (8-bit after power up, or either nibble of 4-bit)
+    LCD_queue(ENTRY_WAIT | POWER_UP_MS);            // LCD power up
+    LCD_queue(ENTRY_NIBBLE | WAKE);                 // single nibble wake up
+    LCD_queue(ENTRY_WAIT | WAKE_MS);
+    LCD_queue(ENTRY_NIBBLE | WAKE);
+    LCD_queue(ENTRY_WAIT | 1);                      // > 100 us
+    LCD_queue(ENTRY_NIBBLE | WAKE);
+    LCD_queue(ENTRY_NIBBLE | MODE_4_BIT);           // 4-bit from the next byte
+    LCD_nib_cmd(MODE_4_BIT | MODE_2_LINE);          // set 4-bit data, 2-line
+    LCD_nib_cmd(DISPLAY_ON | CURSOR_ON | CURSOR_BLINK);    // display and cursor on
+    LCD_nib_cmd(CLR_DISP);                          // clear screen
+    LCD_nib_cmd(CURSOR_RIGHT);                      // move cursor right after each char
+}
+
+// Function to queue a single command. Returns 0 if the queue is full.
+uint8_t LCD_nib_cmd(uint8_t command)
+{
+    return LCD_queue(command);
+}
+
+// Function to queue a single character at the cursor location.
+// Returns 0 if the queue is full.
+uint8_t LCD_char_write(uint8_t letter)
+{
+    return LCD_queue(ENTRY_DATA | letter);
+}
+
+// Function to queue a full string of characters. Returns the number of
+// characters queued, less than the string length if the queue filled up.
+uint16_t LCD_write(const char* message)
+{
+    uint16_t letter;
+
+    for (letter = 0; message[letter] != '\0'; letter++)
+        if (!LCD_char_write(message[letter]))
+            break;
+
+    return letter;
+}
+
+// Number of entries that can be queued
+uint16_t LCD_queue_free(void)
+{
+    return (queue_tail - queue_head - 1) & QUEUE_MASK;
+}
+
+// Returns 1 while queued entries are still being sent to the LCD
+uint8_t LCD_busy(void)
+{
+    return timer_running;
+}
+
+// TIMER_A1 CCR0 ISR - send the next queued entry to the LCD and schedule
+// the following one after the LCD has had time to complete it
+void TA1_0_IRQHandler(void)
+{
+    uint16_t entry, tail;
+    uint16_t wait_us;
+
+    TIMER_A1->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;
+
+    tail = queue_tail;
+    if (tail == queue_head) {               // queue empty, stop until next entry
+        TIMER_A1->CCTL[0] = 0;
+        timer_running = 0;
+        return;
+    }
+
+    entry = queue[tail];
+    queue_tail = (tail + 1) & QUEUE_MASK;
+
+    if (entry & ENTRY_WAIT) {
+        wait_us = (entry & 0xFF) * 1000;
+    }
+    else {
+        if (entry & ENTRY_DATA)
+            P3->OUT = (P3->OUT & ~(EN | RW)) | RS;  // RS = 1, EN, R/W = 0
+        else
+            P3->OUT &= ~(EN | RS | RW);             // RS, R/W = 0
+
+        LCD_nibble(entry);                  // upper 4 bits
+        if (!(entry & ENTRY_NIBBLE)) {
+            E_delay();
+            LCD_nibble(entry << 4);         // lower 4 bits
+        }
+
+        if (!(entry & ENTRY_DATA) && ((entry & 0xFF) < 4))
+            wait_us = SETTLE_CLR_US;
+        else
+            wait_us = SETTLE_US;
+    }
+
+    TIMER_A1->CCR[0] = TIMER_A1->R + wait_us;   // next entry, counted from
+                                                // the end of this one
+}
@@ -0,0 +1,51 @@
+/*
+ * lcd.h
+ *
+ *  Interrupt driven library for a 4-bit parallel HD44780 LCD
+ *
+ *  Data is connected to the upper 4 bits of port 2
+ *  EN / RS / RW are connected to the upper 3 bits of port 3
+ *
+ *  Commands and characters are put in a queue and the function returns
+ *  immediately. TIMER_A1 CCR0 interrupts send one queued entry at a time
+ *  and schedule the next one after the settle time of the LCD, 1.52 ms
+ *  for clear / home and 37 us for everything else, counted from the end
+ *  of the byte. The CPU is only used for the few us it takes to write
+ *  each byte to the bus. The E pulse is timed from the MCLK LCD_init()
+ *  reads, call it again after a clock change.
+ *
+ *  TIMER_A1 counts SMCLK (3 MHz) / 3 = 1 MHz, 1 us per count
+ */
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include <stdint.h>
+
+// Define common LCD command functions
+#define CLR_DISP      0x01    // Clear display
+#define HOME          0x02    // Send cursor to home position
+#define WAKE          0x30    // initial wake command
+#define MODE_8_BIT    0x30    // LCD Mode options
+#define MODE_4_BIT    0x20
+#define MODE_2_LINE   0x28
+#define CURSOR_ON     0x0A
+#define CURSOR_BLINK  0x09
+#define DISPLAY_ON    0x0C
+#define CURSOR_RIGHT  0x06    // Cursor moves to right
+#define CURSOR_LEFT   0x04    // Cursor moves to left
+#define SET_CURSOR    0x80    // Set cursor position to SET_CURSOR | ADDRESS
+#define LINE_TWO      0x40    // Address of 2nd line
+#define LINE_THREE    0x14
+#define LINE_FOUR     0x54
+
+#define LCD_QUEUE_SIZE 128    // must be a power of 2
+
+void LCD_init(void);
+uint8_t LCD_nib_cmd(uint8_t command);
+uint8_t LCD_char_write(uint8_t letter);
+uint16_t LCD_write(const char* message);
+uint16_t LCD_queue_free(void);
+uint8_t LCD_busy(void);
+
+#endif /* LCD_H_ */
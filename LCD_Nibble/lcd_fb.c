@@ -0,0 +1,92 @@
+// Shadow framebuffer with changed-only flush for the 4x20 character LCD
+
+#include "lcd.h"
+#include "lcd_fb.h"
+
+// DDRAM address of the first character of each row
+static const uint8_t row_address[LCD_ROWS] = {0x00, LINE_TWO, LINE_THREE, LINE_FOUR};
+
+static char frame[LCD_ROWS][LCD_COLS];      // what should be displayed
+static char shown[LCD_ROWS][LCD_COLS];      // what the LCD is displaying
+static uint8_t cursor;                      // LCD DDRAM address of cursor
+
+// Function to start the framebuffer. Must be called right after LCD_init()
+// when the display is clear and the cursor is home.
+void LCD_fb_init(void)
+{
+    uint8_t row, col;
+
+    for (row = 0; row < LCD_ROWS; row++)
+        for (col = 0; col < LCD_COLS; col++) {
+            frame[row][col] = ' ';
+            shown[row][col] = ' ';
+        }
+
+    cursor = 0;
+}
+
+// Function to copy text into the framebuffer at row, col (0 based).
+// Text past the end of the row is cut off.
+void LCD_print_at(uint8_t row, uint8_t col, const char* text)
+{
+    if (row >= LCD_ROWS)
+        return;
+
+    while ((col < LCD_COLS) && (*text != '\0'))
+        frame[row][col++] = *text++;
+}
+
+// Function to set every character of the framebuffer to letter
+void LCD_fill(char letter)
+{
+    uint8_t row, col;
+
+    for (row = 0; row < LCD_ROWS; row++)
+        for (col = 0; col < LCD_COLS; col++)
+            frame[row][col] = letter;
+}
+
+// Function to queue the changes between the framebuffer and the display.
+// A single unchanged character between two changes is rewritten, it costs
+// the same as a SET_CURSOR command. Returns the number of bytes queued.
+// If the LCD queue fills up, the rest is sent on the next flush.
+uint16_t LCD_flush(void)
+{
+    uint8_t row, col;
+    uint8_t address;
+    uint16_t sent = 0;
+
+    for (row = 0; row < LCD_ROWS; row++) {
+        for (col = 0; col < LCD_COLS; col++) {
+
+            if (frame[row][col] == shown[row][col])
+                continue;
+
+            address = row_address[row] + col;
+
+            // bridge a gap of one unchanged character instead of moving
+            if ((cursor + 1 == address) && (col > 0)) {
+                if (!LCD_char_write(shown[row][col - 1]))
+                    return sent;
+                cursor++;
+                sent++;
+            }
+
+            if (cursor != address) {
+                if (LCD_queue_free() < 2)           // cursor move and character
+                    return sent;
+                LCD_nib_cmd(SET_CURSOR | address);
+                cursor = address;
+                sent++;
+            }
+
+            if (!LCD_char_write(frame[row][col]))
+                return sent;
+            shown[row][col] = frame[row][col];
+            cursor++;
+            sent++;
+        }
+    }
+
+    return sent;
+}
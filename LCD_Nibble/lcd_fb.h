@@ -0,0 +1,28 @@
+/*
+ * lcd_fb.h
+ *
+ *  Shadow framebuffer for a 4x20 character LCD
+ *
+ *  LCD_print_at() and LCD_fill() only change the framebuffer in memory.
+ *  LCD_flush() compares it to a copy of what is on the display and queues
+ *  only the characters that changed, with a SET_CURSOR command only where
+ *  the cursor is not already at the next changed character.
+ *
+ *  The framebuffer keeps track of the LCD cursor, so once LCD_fb_init() is
+ *  called, all output to the display should go through the framebuffer.
+ */
+
+#ifndef LCD_FB_H_
+#define LCD_FB_H_
+
+#include <stdint.h>
+
+#define LCD_ROWS 4
+#define LCD_COLS 20
+
+void LCD_fb_init(void);
+void LCD_print_at(uint8_t row, uint8_t col, const char* text);
+void LCD_fill(char letter);
+uint16_t LCD_flush(void);
+
+#endif /* LCD_FB_H_ */
@@ -0,0 +1,138 @@
+// PC test of lcd_fb.c with lcd.c against the HD44780 model in Host/
+//
+//     gcc -O2 -I. -I../Host lcd_fb_host.c lcd_fb.c lcd.c ../BSP/system_msp432p401r.c
+//         ../Host/hd44780.c ../Host/msp_host.c -lm -Wno-unknown-pragmas -o lcd_fb
+//
+// After every flush the DDRAM of the model must show the framebuffer on
+// all 4 rows: the demo counter, random edits over the whole screen (the
+// cursor runs off the end of rows and over the 2-line DDRAM wrap) and
+// full screen changes bigger than the LCD queue, which take more than one
+// flush. Prints the bytes sent to the LCD per counter update against a
+// redraw of the line and of the whole screen. Exits with 1 if a check
+// fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "msp.h"
+#include "lcd.h"
+#include "lcd_fb.h"
+#include "hd44780.h"
+
+#define UPDATES     1000
+
+static char expect[LCD_ROWS][LCD_COLS + 1];
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void print_at(uint8_t row, uint8_t col, const char* text)
+{
+    LCD_print_at(row, col, text);
+    while ((col < LCD_COLS) && *text)
+        expect[row][col++] = *text++;
+}
+
+// flush until everything is queued and sent, returns the bytes the LCD got
+static uint32_t flush(void)
+{
+    uint32_t bytes = HD44780.instructions + HD44780.characters;
+
+    while (LCD_flush() || LCD_busy())
+        HOST_run(HOST_PS / 1000);
+    return HD44780.instructions + HD44780.characters - bytes;
+}
+
+static uint8_t screen_ok(void)
+{
+    char text[HD44780_COLS + 1];
+    uint8_t row;
+
+    for (row = 0; row < LCD_ROWS; row++) {
+        HD44780_row(row, text);
+        if (memcmp(text, expect[row], LCD_COLS))
+            return 0;
+    }
+    return 1;
+}
+
+int main(void)
+{
+    char digits[5], text[LCD_COLS + 1];
+    uint32_t bytes, total = 0, max = 0;
+    uint16_t count, index;
+    uint8_t row;
+
+    HD44780_attach(2, 1);
+    __enable_irq();
+    srand(1);
+
+    LCD_init();
+    LCD_fb_init();
+    for (row = 0; row < LCD_ROWS; row++)
+        memset(expect[row], ' ', LCD_COLS);
+
+    print_at(0, 0, "Hello");
+    print_at(1, 0, "World!");
+    print_at(2, 0, "Microcontrollers");
+    print_at(3, 0, "Rock!");
+    flush();
+    check(screen_ok(), "first frame");
+
+    // the demo counter, only the digits that changed are sent
+    for (count = 0; count < UPDATES; count++) {
+        sprintf(digits, "%04u", count);
+        print_at(3, 16, digits);
+        bytes = flush();
+        total += bytes;
+        if (bytes > max)
+            max = bytes;
+        if (!screen_ok()) {
+            check(0, "counter update");
+            break;
+        }
+    }
+    printf("counter: %.2f bytes per update (max %u), line redraw %u, screen redraw %u\n",
+           (double)total / UPDATES, max, 1 + LCD_COLS, LCD_ROWS * (1 + LCD_COLS));
+    check(total < UPDATES * 4, "counter under 4 bytes per update");
+
+    // random edits anywhere, up to the end of a row
+    for (count = 0; count < 500; count++) {
+        row = rand() % LCD_ROWS;
+        index = rand() % LCD_COLS;
+        memset(text, 'a' + rand() % 26, sizeof(text) - 1);
+        text[1 + rand() % (LCD_COLS - index)] = 0;
+        print_at(row, index, text);
+        if (rand() & 1)                 // sometimes two edits per flush
+            print_at(rand() % LCD_ROWS, rand() % LCD_COLS, "#");
+        flush();
+        if (!screen_ok()) {
+            check(0, "random edits");
+            break;
+        }
+    }
+
+    // whole screen twice without waiting: more than the queue holds
+    LCD_fill('x');
+    LCD_flush();
+    LCD_fill('y');
+    for (row = 0; row < LCD_ROWS; row++)
+        memset(expect[row], 'y', LCD_COLS);
+    bytes = flush();
+    check(screen_ok(), "full screen changes over several flushes");
+    printf("two full screen changes back to back: %u bytes\n", bytes);
+
+    check(HD44780.timing_errors == 0, "no timing errors");
+    check(HD44780.busy_errors == 0, "no bytes sent while busy");
+    return failed;
+}
+
+#endif
@@ -1,11 +1,12 @@
 //*******************************************************************************
-//  MSP432P401 Demo - Timer1_A3, PWM TA1.1-2, Up Mode, DCO SMCLK
+//  MSP432P401 Demo - Timer2_A, PWM TA2.3-4, Up Mode, DCO SMCLK
 //
-//  This program generates two PWM outputs on P6.6, P6.7 using Timer1_A
-//  configured for up mode. The value in CCR0, 32764, defines the PWM period
-//  and the values in CCR3 and CCR4 the PWM duty cycles. Using 32 kHz ACLK as
-//  TACLK, the timer period is ~1s with a 25% duty cycle on P6.6 and 75% on
-//  P7.6.
+//  This program generates two PWM outputs on P6.6, P6.7 using the PWM module
+//  on Timer2_A in up mode. The period is 1 s (SMCLK / 64), P6.6 starts at
+//  75% duty and P6.7 at 25%. P6.6 then fades back and forth between 75%
+//  and 25%, a step each period over FADE_MS. Duty changes are latched by
+//  the CCR0 interrupt at the end of a period so no period is cut short or
+//  stretched.
 //
 //
 //           MSP432P401
@@ -14,32 +15,46 @@
 //      | |               |
 //      --|RST            |
 //        |               |
-//        |     P6.6/TA2.3|--> CCR3 - 75% PWM
+//        |     P6.6/TA2.3|--> CCR3 - 75% <-> 25% PWM
 //        |     P6.7/TA2.4|--> CCR4 - 25% PWM
 //
 //  Paul Hummel
 //******************************************************************************
 #include "msp.h"
+#include "pwm.h"
+#include "pinmap.h"
+
+#define PWM_TIMER   2           // TIMER_A2
+#define DUTY_25     0x4000
+#define DUTY_75     0xC000
+#define FADE_MS     8000
+
+#define PWM_PINS(PIN) \
+    PIN(6, 6, PIN_FUNC1_OUT)    /* P6.6 TA2.3 */ \
+    PIN(6, 7, PIN_FUNC1_OUT)    /* P6.7 TA2.4 */
+
+PIN_TABLE(pwm_pins, PWM_PINS);
 
 int main(void)
 {
+    uint16_t duty = DUTY_25;
+
     WDT_A->CTL = WDT_A_CTL_PW |   // Stop WDT
             WDT_A_CTL_HOLD;
 
-    P6->SEL0 |= BIT6 | BIT7;      // Configure P6.6~7 for TimerA2
-    P6->SEL1 &= ~(BIT6 | BIT7);
-    P6->DIR |= BIT6 | BIT7;       // P6.6~7 output for TA2.3~4
-
-    TIMER_A2->CCR[0] = 32765 - 1;               // PWM Period
-    TIMER_A2->CCTL[3] = TIMER_A_CCTLN_OUTMOD_7; // CCR1 reset/set
-    TIMER_A2->CCR[3] = 24574;                   // CCR1 PWM duty cycle
-    TIMER_A2->CCTL[4] = TIMER_A_CCTLN_OUTMOD_7; // CCR2 reset/set
-    TIMER_A2->CCR[4] = 8191;                    // CCR2 PWM duty cycle
-    TIMER_A2->CTL = TIMER_A_CTL_SSEL__ACLK |    // ACLK
-            TIMER_A_CTL_MC__UP |                // Up mode
-            TIMER_A_CTL_CLR;                    // Clear TAR
-
-    // Enter LPM0
-    __sleep();
-    __no_operation();                           // For debugger
+    PIN_apply(pwm_pins, PIN_COUNT(pwm_pins));   // P6.6~7 output for TA2.3~4
+
+    PWM_set_duty(PWM_TIMER, 3, DUTY_75);        // CCR3 PWM duty cycle
+    PWM_set_duty(PWM_TIMER, 4, DUTY_25);        // CCR4 PWM duty cycle
+    PWM_init(PWM_TIMER, 1);                     // 1 Hz PWM period
+    PWM_fade(PWM_TIMER, 3, duty, FADE_MS);
+    __enable_irq();                             // PWM_init leaves interrupts to main
+
+    while (1) {
+        __sleep();                              // woken by the CCR0 interrupt
+        if (!PWM_fading(PWM_TIMER)) {           // fade done, turn around
+            duty = (duty == DUTY_75) ? DUTY_25 : DUTY_75;
+            PWM_fade(PWM_TIMER, 3, duty, FADE_MS);
+        }
+    }
 }
@@ -1,28 +1,67 @@
-// Demo program that cycles through all of the possible colors
-// of the RGB LED (P2.0 - P2.2)
+// Demo program that fades the RGB LED (P2.0 - P2.2) through a list of
+// 24-bit colors. P2.0 - P2.2 are port mapped to TA0.1 - TA0.3 and the PWM
+// module fades all 3 duties in the TIMER_A0 CCR0 interrupt, so the CPU
+// sleeps between colors. P1.0 toggles at each new color.
 
 #include "msp.h"
 #include <stdint.h>
+#include "pwm.h"
+#include "pinmap.h"
+
+#define RGB_TIMER   0           // TIMER_A0
+#define RGB_FREQ    1000        // PWM frequency (Hz)
+#define FADE_MS     1000        // time to fade to the next color
+
+// port mapping registers of P2, the PM_ mnemonics come from msp.h
+#define P2MAP_REG   ((volatile uint8_t*)(PMAP_BASE + 0x10))
+
+#define RGB_PINS(PIN) \
+    PIN(1, 0, PIN_OUT_LOW)      /* P1.0 LED, toggles at each color */ \
+    PIN(2, 0, PIN_FUNC1_OUT)    /* P2.0 - P2.2 mapped TA0.1 - TA0.3 */ \
+    PIN(2, 1, PIN_FUNC1_OUT) \
+    PIN(2, 2, PIN_FUNC1_OUT)
+
+PIN_TABLE(rgb_pins, RGB_PINS);
+
+static const uint32_t colors[] = {
+    0xFF0000, 0xFF8000, 0xFFFF00, 0x00FF00,
+    0x00FFFF, 0x0000FF, 0x8000FF, 0xFF00FF,
+    0xFFFFFF, 0x000000
+};
+
+#define COLORS (sizeof(colors) / sizeof(colors[0]))
+
+// Function to start fading each LED to its 8-bit part of a 24-bit color
+void RGB_fade(uint32_t color, uint16_t time_ms)
+{
+    PWM_fade(RGB_TIMER, 1, ((color >> 16) & 0xFF) * 257, time_ms);  // red
+    PWM_fade(RGB_TIMER, 2, ((color >> 8) & 0xFF) * 257, time_ms);   // green
+    PWM_fade(RGB_TIMER, 3, (color & 0xFF) * 257, time_ms);          // blue
+}
 
 void main(void) {
-    uint16_t i, color = 0;
+    uint16_t color = 0;
 
     WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;            // Stop WDT
 
-    P1->SEL0 &= ~BIT0;                    // P1.0 set as GPIO
-    P1->SEL1 &= ~BIT0;
-    P1->DIR |= BIT0;                      // P1.0 set as output
+    PMAP->KEYID = PMAP_KEYID_VAL;         // unlock port mapping
+    P2MAP_REG[0] = PM_TA0CCR1A;           // P2.0 red   = TA0.1
+    P2MAP_REG[1] = PM_TA0CCR2A;           // P2.1 green = TA0.2
+    P2MAP_REG[2] = PM_TA0CCR3A;           // P2.2 blue  = TA0.3
+    PMAP->KEYID = 0;                      // lock port mapping
+
+    PIN_apply(rgb_pins, PIN_COUNT(rgb_pins));   // P1.0 out, P2.0 - 2.2 mapped TA0
 
-    P2->SEL0 &= ~(BIT0 | BIT1 | BIT2);    // P2.0, 2.1, 2.2 set as GPIO
-    P2->SEL1 &= ~(BIT0 | BIT1 | BIT2);
-    P2->DIR |= (BIT0 | BIT1 | BIT2);      // P2.0, 2.1, 2.2 set as output
+    PWM_init(RGB_TIMER, RGB_FREQ);        // all LEDs start off
+    RGB_fade(colors[color], FADE_MS);
 
     while (1)                             // continuous loop
     {
-        P1->OUT ^= BIT0;                  // Blink P1.0 LED
-        P2->OUT &= ~(BIT0 | BIT1 | BIT2); // clear P2.0-2.2
-        P2->OUT |= (color & 0x07);        // Set with lower 3 bits of color
-        for (i = 65535; i > 0; i--);      // Delay
-        color++;                          // change color
+        __sleep();                        // woken by each PWM period
+        if (!PWM_fading(RGB_TIMER)) {
+            P1->OUT ^= BIT0;              // Blink P1.0 LED
+            color = (color + 1) % COLORS; // change color
+            RGB_fade(colors[color], FADE_MS);
+        }
     }
 }
@@ -0,0 +1,172 @@
+// DMA driven full-duplex SPI master with a transaction queue
+//
+// DMA channel 0 (source 2 = EUSCIB0TX0) -> EUSCI_B0->TXBUF
+// DMA channel 1 (source 2 = EUSCIB0RX0) <- EUSCI_B0->RXBUF
+// DMA channel 1 done -> DMA_INT1 ISR ends the transaction, starts the next
+
+#include "msp.h"
+#include "spi.h"
+#include "dma.h"
+
+#define SPI_TX_CH       0               // DMA channel for TX
+#define SPI_RX_CH       1               // DMA channel for RX
+#define SPI_DMA_SRC     2               // eUSCI_B0 TX0 / RX0 (datasheet DMA sources)
+
+#define QUEUE_MASK (SPI_QUEUE_SIZE - 1)
+
+typedef struct {
+    const uint8_t* tx;
+    uint8_t* rx;
+    uint16_t length;
+    uint8_t cs;                         // CS pin mask on SPI_CS_PORT
+    SPI_callback done;
+} SPI_transaction;
+
+// head is only written by SPI_transfer, tail only by the ISR
+static SPI_transaction queue[SPI_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;
+static volatile uint16_t queue_tail = 0;
+static volatile uint8_t spi_running = 0;    // ISR is working on the queue
+
+static const uint8_t tx_dummy = 0xFF;       // sent when tx is 0
+static uint8_t rx_dummy;                    // received into when rx is 0
+
+static void SPI_done(void);
+
+// Function to lower CS and set both DMA channels up for the transaction at
+// the tail of the queue
+static void SPI_start(void)
+{
+    SPI_transaction* transaction = &queue[queue_tail];
+    uint16_t length = transaction->length;
+    DMA_descriptor* tx = DMA_primary(SPI_TX_CH);
+    DMA_descriptor* rx = DMA_primary(SPI_RX_CH);
+
+    SPI_CS_PORT->OUT &= ~transaction->cs;
+
+    if (transaction->rx)
+        DMA_set(rx, &EUSCI_B0->RXBUF, &transaction->rx[length - 1],
+                DMA_DST_INC_8 | DMA_DST_SIZE_8 | DMA_SRC_INC_0 |
+                DMA_SRC_SIZE_8 | DMA_N_MINUS_1(length) | DMA_BASIC);
+    else
+        DMA_set(rx, &EUSCI_B0->RXBUF, &rx_dummy,
+                DMA_DST_INC_0 | DMA_DST_SIZE_8 | DMA_SRC_INC_0 |
+                DMA_SRC_SIZE_8 | DMA_N_MINUS_1(length) | DMA_BASIC);
+
+    if (transaction->tx)
+        DMA_set(tx, &transaction->tx[length - 1], &EUSCI_B0->TXBUF,
+                DMA_DST_INC_0 | DMA_DST_SIZE_8 | DMA_SRC_INC_8 |
+                DMA_SRC_SIZE_8 | DMA_N_MINUS_1(length) | DMA_BASIC);
+    else
+        DMA_set(tx, &tx_dummy, &EUSCI_B0->TXBUF,
+                DMA_DST_INC_0 | DMA_DST_SIZE_8 | DMA_SRC_INC_0 |
+                DMA_SRC_SIZE_8 | DMA_N_MINUS_1(length) | DMA_BASIC);
+
+    (void)EUSCI_B0->RXBUF;                  // discard any stale byte
+    DMA_Control->ENASET = (1 << SPI_RX_CH) | (1 << SPI_TX_CH);
+
+    // TXIFG is already set while idle, clear and set it again so the DMA
+    // sees a new trigger for the first byte
+    EUSCI_B0->IFG &= ~EUSCI_B_IFG_TXIFG;
+    EUSCI_B0->IFG |= EUSCI_B_IFG_TXIFG;
+}
+
+// Function to set up eUSCI_B0 as 3-pin SPI master at SMCLK / 2 and the DMA
+// channels. cs_pins are the pins on SPI_CS_PORT used as chip selects.
+void SPI_init(uint8_t cs_pins)
+{
+    P1->SEL0 |= BIT5 | BIT6 | BIT7;     // Set P1.5, P1.6, and P1.7 as
+                                        // SPI pins functionality
+
+    SPI_CS_PORT->SEL0 &= ~cs_pins;
+    SPI_CS_PORT->SEL1 &= ~cs_pins;
+    SPI_CS_PORT->OUT |= cs_pins;        // CS idle high
+    SPI_CS_PORT->DIR |= cs_pins;
+
+    EUSCI_B0->CTLW0 |= EUSCI_B_CTLW0_SWRST; // Put eUSCI state machine in reset
+
+    EUSCI_B0->CTLW0 = EUSCI_B_CTLW0_SWRST  | // keep eUSCI in reset
+                      EUSCI_B_CTLW0_MST    | // Set as SPI master
+                      EUSCI_B_CTLW0_SYNC   | // Set as synchronous mode
+                      EUSCI_B_CTLW0_CKPL   | // Set clock polarity high
+                      EUSCI_B_CTLW0_UCSSEL_2 | // SMCLK
+                      EUSCI_B_CTLW0_MSB;     // MSB first
+
+    EUSCI_B0->BRW = 0x02;               // div by 2 fBitClock = fBRCLK/(UCBRx)
+                                        // leaves the DMA time for both channels
+
+    EUSCI_B0->CTLW0 &= ~EUSCI_B_CTLW0_SWRST;  // Initialize USCI state machine
+    EUSCI_B0->IE = 0;                         // data is moved by DMA
+
+    DMA_init();
+    DMA_channel(SPI_TX_CH, SPI_DMA_SRC);
+    DMA_channel(SPI_RX_CH, SPI_DMA_SRC);
+    DMA_Control->ALTCLR = (1 << SPI_RX_CH) | (1 << SPI_TX_CH);
+    DMA_Control->PRIOSET = 1 << SPI_RX_CH;  // never let RXBUF overrun
+
+    queue_head = queue_tail = 0;
+    spi_running = 0;
+
+    // DMA_INT1 is dedicated to RX channel completion, the last RX byte means
+    // the last TX byte is also done
+    DMA_int1(SPI_RX_CH, SPI_done);
+}
+
+// Function to queue a transaction of length bytes on the chip select cs.
+// done is called from the ISR with rx when the transaction is finished.
+// Returns 0 if the queue is full or length is out of range.
+uint8_t SPI_transfer(uint8_t cs, const uint8_t* tx, uint8_t* rx,
+                     uint16_t length, SPI_callback done)
+{
+    uint16_t head = queue_head;
+
+    if ((length == 0) || (length > SPI_MAX_LENGTH))
+        return 0;
+
+    if (((head + 1) & QUEUE_MASK) == queue_tail)    // queue full
+        return 0;
+
+    queue[head].tx = tx;
+    queue[head].rx = rx;
+    queue[head].length = length;
+    queue[head].cs = cs;
+    queue[head].done = done;
+    queue_head = (head + 1) & QUEUE_MASK;   // publish after it is written
+
+    if (!spi_running) {             // ISR stopped when queue emptied, restart
+        spi_running = 1;
+        SPI_start();
+    }
+
+    return 1;
+}
+
+// Returns 1 while any queued transaction has not finished
+uint8_t SPI_busy(void)
+{
+    return spi_running;
+}
+
+// DMA channel 1 done, from the DMA_INT1 ISR in dma.c. Every byte of the
+// transaction has been received. Raise CS, start the next transaction and
+// then call the callback so the bus is not idle while the callback runs.
+static void SPI_done(void)
+{
+    SPI_transaction* transaction = &queue[queue_tail];
+    SPI_callback done = transaction->done;
+    uint8_t* rx = transaction->rx;
+    uint16_t length = transaction->length;
+
+    DMA_Channel->INT0_CLRFLG = 1 << SPI_RX_CH;      // clear channel flag
+
+    SPI_CS_PORT->OUT |= transaction->cs;
+    queue_tail = (queue_tail + 1) & QUEUE_MASK;     // release the entry
+
+    if (queue_tail != queue_head)
+        SPI_start();
+    else
+        spi_running = 0;
+
+    if (done)
+        done(rx, length);
+}
@@ -0,0 +1,37 @@
+/*
+ *  spi.h
+ *
+ *  DMA driven full-duplex SPI master on eUSCI_B0
+ *  P1.5  UCB0CLK   SCLK
+ *  P1.6  UCB0SIMO  MOSI
+ *  P1.7  UCB0SOMI  MISO
+ *  P4.x  GPIO      CS, one pin per transaction
+ *
+ *  SPI_transfer() queues a transaction and returns. DMA channel 0 feeds
+ *  TXBUF and DMA channel 1 empties RXBUF so a whole block moves without
+ *  the CPU. When the last byte is received the DMA ISR raises CS, calls
+ *  the callback and starts the next queued transaction straight away so
+ *  back to back frames have no gap waiting on main code.
+ *
+ *  tx may be 0 to clock out 0xFF (read only), rx may be 0 to discard the
+ *  received bytes (write only). The buffers must stay valid until the
+ *  callback is called.
+ */
+
+#ifndef SPI_H_
+#define SPI_H_
+
+#include <stdint.h>
+
+#define SPI_QUEUE_SIZE  8           // must be a power of 2
+#define SPI_MAX_LENGTH  1024        // bytes in one DMA cycle
+#define SPI_CS_PORT     P4          // port for the chip select pins
+
+typedef void (*SPI_callback)(const uint8_t* rx, uint16_t length);
+
+void SPI_init(uint8_t cs_pins);
+uint8_t SPI_transfer(uint8_t cs, const uint8_t* tx, uint8_t* rx,
+                     uint16_t length, SPI_callback done);
+uint8_t SPI_busy(void);
+
+#endif /* SPI_H_ */
@@ -0,0 +1,233 @@
+// PC test of spi.c against the SPI model in Host/
+//
+//     gcc -O2 -I. -I../BSP -I../Host spi_host.c spi.c ../BSP/dma.c ../Host/msp_host.c -lm
+//         -Wno-unknown-pragmas -o spi
+//
+// The device on the bus answers each byte with the byte XOR 0xA5, so rx
+// shows what was sent. Every byte must be clocked with the CS of its own
+// transaction low and no other, queued transactions must run back to back
+// in order with a CS pulse each, tx 0 must send 0xFF and the queue must
+// refuse a transaction when full or out of range. Then 64 transactions of
+// 64 bytes are run through the DMA and through a per-byte eUSCI_B0
+// interrupt driver written the usual way, and the bytes/s, interrupts and
+// CPU time of each are printed. Exits with 1 if a check fails.
+
+#if !defined(__arm__) && !defined(__TI_ARM__)
+
+#include <stdio.h>
+#include <string.h>
+#include "msp.h"
+#include "spi.h"
+
+#define CS_A        BIT4
+#define CS_B        BIT5
+#define ANSWER      0xA5            // device answer is MOSI ^ ANSWER
+#define RUNS        64              // transactions in the throughput runs
+#define RUN_LENGTH  64
+#define LOG_SIZE    (RUNS * RUN_LENGTH)
+
+static uint8_t cs_out = 0xFF;       // P4 OUT as the device sees it
+static uint8_t log_mosi[LOG_SIZE], log_cs[LOG_SIZE];
+static uint32_t log_count, cs_pulses;
+static uint8_t failed;
+
+static void check(int ok, const char* what)
+{
+    if (!ok) {
+        printf("FAIL %s\n", what);
+        failed = 1;
+    }
+}
+
+static void port_out(uint8_t port, uint8_t out, uint8_t dir)
+{
+    (void)dir;
+    if (port != 4)
+        return;
+    if (~cs_out & out & (CS_A | CS_B))
+        cs_pulses++;                // a CS went high
+    cs_out = out;
+}
+
+static uint8_t device(uint8_t spi, uint8_t mosi)
+{
+    if ((spi == 0) && (log_count < LOG_SIZE)) {
+        log_mosi[log_count] = mosi;
+        log_cs[log_count++] = ~cs_out & (CS_A | CS_B);  // the CS pins low
+    }
+    return mosi ^ ANSWER;
+}
+
+static void wait_idle(uint8_t (*busy)(void))
+{
+    while (busy())
+        HOST_run(HOST_PS / 1000000);
+}
+
+static volatile uint32_t callbacks;
+
+static void done(const uint8_t* rx, uint16_t length)
+{
+    (void)rx;
+    (void)length;
+    callbacks++;
+}
+
+// the throughput run: the callback queues the next transaction
+static uint8_t run_tx[RUN_LENGTH], run_rx[RUN_LENGTH];
+static volatile uint32_t run_left;
+
+static void run_done(const uint8_t* rx, uint16_t length)
+{
+    (void)rx;
+    (void)length;
+    if (run_left && --run_left)
+        SPI_transfer(CS_A, run_tx, run_rx, RUN_LENGTH, run_done);
+}
+
+// the per-byte interrupt driver to compare against: the eUSCI_B0 ISR
+// reads each byte and writes the next one
+static const uint8_t* byte_tx;
+static uint8_t* byte_rx;
+static volatile uint16_t byte_index;
+static uint16_t byte_length;
+static volatile uint32_t byte_left;
+
+static void byte_start(void)
+{
+    byte_index = 0;
+    SPI_CS_PORT->OUT &= ~CS_A;
+    EUSCI_B0->TXBUF = byte_tx[0];
+}
+
+void EUSCIB0_IRQHandler(void)
+{
+    byte_rx[byte_index] = EUSCI_B0->RXBUF;
+    if (++byte_index < byte_length) {
+        EUSCI_B0->TXBUF = byte_tx[byte_index];
+        return;
+    }
+    SPI_CS_PORT->OUT |= CS_A;
+    if (--byte_left)
+        byte_start();
+}
+
+static uint8_t byte_busy(void)
+{
+    return byte_left != 0;
+}
+
+typedef struct {
+    double bytes_per_s;
+    uint32_t interrupts;
+    double cpu_us;
+} Result;
+
+static Result measure(void (*start)(void), uint8_t (*busy)(void))
+{
+    uint64_t time = HOST_time(), cpu = HOST_stats.busy + HOST_stats.isr;
+    uint32_t interrupts = HOST_stats.interrupts;
+    Result result;
+
+    start();
+    wait_idle(busy);
+    result.bytes_per_s = (double)RUNS * RUN_LENGTH * HOST_PS / (HOST_time() - time);
+    result.interrupts = HOST_stats.interrupts - interrupts;
+    result.cpu_us = (double)(HOST_stats.busy + HOST_stats.isr - cpu) * 1e6 / HOST_PS;
+    return result;
+}
+
+static void dma_start(void)
+{
+    run_left = RUNS;
+    SPI_transfer(CS_A, run_tx, run_rx, RUN_LENGTH, run_done);
+}
+
+static void per_byte_start(void)
+{
+    byte_tx = run_tx;
+    byte_rx = run_rx;
+    byte_length = RUN_LENGTH;
+    byte_left = RUNS;
+    byte_start();
+}
+
+int main(void)
+{
+    static const uint8_t count_up[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    static const uint8_t count_down[8] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+    static uint8_t rx_a[SPI_MAX_LENGTH], rx_b[8];
+    Result dma, per_byte;
+    uint16_t index;
+    uint8_t ok, accepted;
+
+    HOST_port_out = port_out;
+    HOST_spi_byte = device;
+    SPI_init(CS_A | CS_B);
+    __enable_irq();
+
+    // two transactions queued back to back on different chip selects
+    check(SPI_transfer(CS_A, count_up, rx_a, 8, done), "first transfer queued");
+    check(SPI_transfer(CS_B, count_down, rx_b, 8, done), "second transfer queued");
+    wait_idle(SPI_busy);
+    check(callbacks == 2, "done called for both");
+    check(cs_pulses == 2, "one CS pulse per transaction");
+    ok = log_count == 16;
+    for (index = 0; ok && (index < 8); index++)
+        ok = (log_mosi[index] == count_up[index]) && (log_cs[index] == CS_A) &&
+             (log_mosi[8 + index] == count_down[index]) && (log_cs[8 + index] == CS_B) &&
+             (rx_a[index] == (count_up[index] ^ ANSWER)) && (rx_b[index] == (count_down[index] ^ ANSWER));
+    check(ok, "bytes in order, each with its own CS low, rx is the answer");
+
+    // read only and write only
+    log_count = 0;
+    memset(rx_a, 0, sizeof(rx_a));
+    SPI_transfer(CS_A, 0, rx_a, SPI_MAX_LENGTH, done);
+    SPI_transfer(CS_B, count_up, 0, 8, done);
+    wait_idle(SPI_busy);
+    ok = log_count == SPI_MAX_LENGTH + 8;
+    for (index = 0; ok && (index < SPI_MAX_LENGTH); index++)
+        ok = (log_mosi[index] == 0xFF) && (rx_a[index] == (0xFF ^ ANSWER));
+    check(ok, "tx 0 sends 0xFF for a whole DMA cycle");
+    check(!memcmp(&log_mosi[SPI_MAX_LENGTH], count_up, 8), "rx 0 still sends tx");
+
+    // queue limits
+    check(!SPI_transfer(CS_A, count_up, rx_a, 0, done), "length 0 refused");
+    check(!SPI_transfer(CS_A, count_up, rx_a, SPI_MAX_LENGTH + 1, done), "length over SPI_MAX_LENGTH refused");
+    for (accepted = 0; accepted < SPI_QUEUE_SIZE; accepted++)
+        if (!SPI_transfer(CS_A, count_up, rx_a, 8, done))
+            break;
+    check(accepted == SPI_QUEUE_SIZE - 1, "queue holds SPI_QUEUE_SIZE - 1");
+    wait_idle(SPI_busy);
+
+    // throughput against a per-byte interrupt driver
+    for (index = 0; index < RUN_LENGTH; index++)
+        run_tx[index] = index;
+    log_count = 0;
+    dma = measure(dma_start, SPI_busy);
+    check(log_count == RUNS * RUN_LENGTH, "DMA run sends every byte");
+    check(run_rx[RUN_LENGTH - 1] == ((RUN_LENGTH - 1) ^ ANSWER), "DMA run receives");
+
+    DMA_Control->ENACLR = BIT0 | BIT1;          // the eUSCI is left to the ISR
+    EUSCI_B0->IE = EUSCI_B_IE_RXIE;
+    NVIC->ISER[0] = 1 << ((EUSCIB0_IRQn) & 31);
+    log_count = 0;
+    memset(run_rx, 0, sizeof(run_rx));
+    per_byte = measure(per_byte_start, byte_busy);
+    check(log_count == RUNS * RUN_LENGTH, "per-byte run sends every byte");
+    check(run_rx[RUN_LENGTH - 1] == ((RUN_LENGTH - 1) ^ ANSWER), "per-byte run receives");
+
+    printf("%u x %u bytes at %u bit/s SCK:\n", RUNS, RUN_LENGTH, 3000000 / EUSCI_B0->BRW);
+    printf("  DMA       %8.0f bytes/s, %4u interrupts, %7.1f us of CPU\n",
+           dma.bytes_per_s, dma.interrupts, dma.cpu_us);
+    printf("  per byte  %8.0f bytes/s, %4u interrupts, %7.1f us of CPU\n",
+           per_byte.bytes_per_s, per_byte.interrupts, per_byte.cpu_us);
+    check(dma.interrupts == RUNS, "DMA: one interrupt per transaction");
+    check(dma.bytes_per_s > per_byte.bytes_per_s, "DMA moves more bytes/s");
+    check(dma.cpu_us < per_byte.cpu_us, "DMA takes less CPU");
+    check(HOST_stats.overruns == 0, "no byte written over a full TXBUF");
+    check(!(EUSCI_B0->STATW & EUSCI_B_STATW_OE), "no RXBUF overrun");
+    return failed;
+}
+
+#endif
@@ -1,8 +1,9 @@
 //***************************************************************************************
 //  MSP432P401 Demo - TimerA0->CCI2A Capture
 //
-//  Capture the time between pulses on TA0.2 (P2.5). After every 2 captures,
-//  the period is calculated and saved in inputPeriod.
+//  Capture the time between pulses on TA0.2 (P2.5). Captures are extended
+//  to 32 bits so periods longer than 65536 counts are measured, and the
+//  period is averaged over every edge in a GATE_MS window.
 //  MCLK = SMCLK = default DCODIV = 3MHz.
 //
 //                MSP432P401
@@ -19,68 +20,45 @@
 //***************************************************************************************
 #include "msp.h"
 #include <stdint.h>
+#include "freq.h"
+#include "pinmap.h"
 
-volatile uint16_t captureValues[2] = {0};
-volatile uint16_t captureFlag = 0;
+#define GATE_MS     100     // minimum time per result
+#define MIN_EDGES   1       // minimum periods per result
+
+#define CAPTURE_PINS(PIN) \
+	PIN(2, 5, PIN_FUNC1)        /* P2.5 TA0.CCI2A capture input */
+
+PIN_TABLE(capture_pins, CAPTURE_PINS);
+
+// results, volatile so they are kept to watch in the debugger
+volatile uint32_t inputFreq = 0;        // 0.01 Hz
+volatile uint32_t inputPeriod = 0;      // timer counts per input period
 
 int main(void)
 {
-	uint16_t capturePeriod;
+	FREQ_Window window;
 
 	WDT_A->CTL = WDT_A_CTL_PW |             // Stop watchdog timer
 	WDT_A_CTL_HOLD;
 
-	P2->SEL0 |= BIT5;     // TA0.CCI2A input capture pin, second function
-	P2->DIR &= ~BIT5;
-
-	// TimerA0_A2 Setup
-	TIMER_A0->CCTL[2] = (TIMER_A_CCTLN_CM_1   | // Capture rising edge,
-	                     TIMER_A_CCTLN_CCIS_0 | // Use CCI2A (P2.5),
-	                     TIMER_A_CCTLN_CCIE   | // Enable capture interrupt
-	                     TIMER_A_CCTLN_CAP    | // Enable capture mode,
-	                     TIMER_A_CCTLN_SCS);    // Synchronous capture
+	PIN_apply(capture_pins, PIN_COUNT(capture_pins));   // TA0.CCI2A input on P2.5
 
-	TIMER_A0->CTL |= (TIMER_A_CTL_TASSEL_2       | // SMCLK as clock source,
-	                  TIMER_A_CTL_MC__CONTINUOUS | // Continuous mode
-	                  TIMER_A_CTL_CLR);            // clear TA0R
-
-	NVIC->ISER[0] = 1 << ((TA0_N_IRQn) & 31);      // enable TimerA ISR
-
-    // Enable global interrupt
-	__enable_irq();
+	// TimerA0_A2 capture with 32-bit timestamps, see freq.h
+	FREQ_init(FREQ_RECIPROCAL, GATE_MS, MIN_EDGES);
+	__enable_irq();         // FREQ_init leaves interrupts to main
 
 	while (1)
 	{
-        if (captureFlag)
+		if (FREQ_read_window(&window))
 		{
-			__disable_irq();    // protect capture times
-			// time difference
-			capturePeriod = captureValue[1] - captureValue[0];
-			captureFlag = 0;    // clear capture flag
-			__enable_irq();     // start capturing again
+			// average period over the whole window, rounded
+			inputPeriod = (window.counts + window.events / 2) / window.events;
+			inputFreq = (((uint64_t)window.events * FREQ_TIMER_CLK * FREQ_SCALE)
+			            + (window.counts / 2)) / window.counts;
 			// Do any time or freq calculations here
 		}
+		__sleep();          // wake on the next capture or roll over
 	}
 
 }
-
-// TimerA0_N interrupt service routine
-void TA0_N_IRQHandler(void)
-{
-	volatile static uint32_t captureCount = 0;
-
-	if (TIMER_A0->CCTL[2] & TIMER_A_CCTLN_CCIFG)
-	{
-		captureValue[captureCount] = TIMER_A0->CCR[2];
-		captureCount++;
-
-		if (captureCount == 2)
-		{
-			captureCount = 0;
-			captureFlag = 1;
-		}
-
-		// Clear the interrupt flag
-		TIMER_A0->CCTL[2] &= ~(TIMER_A_CCTLN_CCIFG);
-	}
-}
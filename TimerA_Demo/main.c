@@ -3,58 +3,49 @@
  *
  *  ACLK = TACLK = 32kHz, MCLK = SMCLK = default DCO ~3MHz
  *
- *  TIMER_A0 utilize ACLK - TA0CLK = 32768Hz
- *  TIMER_A0 CCR0 and CCR1 to create 2 timing events
- *  TIMER_A0 -> CCR[0] = 32768 = 0.5 Hz
- *  TIMER_A0 -> CCR[1] = 16384 = 0.5 Hz with 0.5s offset from CCR0
+ *  The scheduler (sched.c) runs TIMER_A3 from ACLK and wakes the CPU only
+ *  when a task is due, the rest of the time it sleeps in LPM0.
+ *  P1.0 task toggles every 1 s
+ *  P2.0 task toggles every 1 s with 0.5s offset from P1.0
  *
  *  Paul Hummel
  */
 
 #include "msp.h"
+#include "sched.h"
+#include "pinmap.h"
 
-void main(void)
-{
-	WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;		// stop watchdog timer
-
-	P1->DIR |= BIT0;    // setup P1.0 and P2.0 LEDs
-	P2->DIR |= BIT0;
-
-	P1->OUT &= ~BIT0;   // turn LEDs off
-	P2->OUT &= ~BIT0;
+#define LED_PINS(PIN) \
+	PIN(1, 0, PIN_OUT_LOW)      /* P1.0 red LED */ \
+	PIN(2, 0, PIN_OUT_LOW)      /* P2.0 RGB red */
 
-	// setup TIMER_A0
-	TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG; // clear interrupt
-	TIMER_A0->CCTL[1] &= ~TIMER_A_CCTLN_CCIFG; // clear interrupt
+PIN_TABLE(led_pins, LED_PINS);
 
-	TIMER_A0->CCTL[0] = TIMER_A_CCTLN_CCIE; // TACCR0 interrupt enabled
-	TIMER_A0->CCTL[1] = TIMER_A_CCTLN_CCIE; // TACCR1 interrupt enabled
+static SCHED_timer red_timer;
+static SCHED_timer rgb_timer;
 
-	TIMER_A0->CCR[0] = 32768;   // set CCR0 count
-	TIMER_A0->CCR[1] = 16384;   // set CCR1 count
+// task to toggle the P1.0 LED
+static void toggle_red(uint32_t data)
+{
+	P1->OUT ^= BIT0;
+}
 
-	TIMER_A0->CTL = TIMER_A_CTL_TASSEL_1 | TIMER_A_CTL_MC_1; // SMCLK, UP mode
+// task to toggle the P2.0 LED
+static void toggle_rgb(uint32_t data)
+{
+	P2->OUT ^= BIT0;
+}
 
-	NVIC->ISER[0] = 1 << ((TA0_0_IRQn) & 31);   // set NVIC interrupt
-	NVIC->ISER[0] = 1 << ((TA0_N_IRQn) & 31);   // TA0_0 and TA0_N
+void main(void)
+{
+	WDT_A->CTL = WDT_A_CTL_PW | WDT_A_CTL_HOLD;		// stop watchdog timer
 
-	__enable_irq();     // Enable global interrupt
+	PIN_apply(led_pins, PIN_COUNT(led_pins));   // P1.0 and P2.0 LEDs off
 
-	while(1);
+	SCHED_init();
 
-}
-// Timer A0_0 interrupt service routine
-void TA0_0_IRQHandler(void) {
-	TIMER_A0->CCTL[0] &= ~TIMER_A_CCTLN_CCIFG;  // Clear the CCR0 interrupt
-	P1->OUT ^= BIT0;
-}
+	SCHED_start(&red_timer, toggle_red, 0, 1000, 1000);  // 1 s period
+	SCHED_start(&rgb_timer, toggle_rgb, 0, 500, 1000);   // 0.5 s offset
 
-// Timer A0_N interrupt service routine for CCR1 - CCR4
-void TA0_N_IRQHandler(void)
-{
-	if(TIMER_A0->CCTL[1]&TIMER_A_CCTLN_CCIFG)   // check for CCR1 interrupt
-	{
-		TIMER_A0->CCTL[1] &= ~TIMER_A_CCTLN_CCIFG; // clear CCR1 interrupt
-		P2->OUT ^= BIT0;
-	}
+	SCHED_run();        // sleeps between tasks, never returns
 }